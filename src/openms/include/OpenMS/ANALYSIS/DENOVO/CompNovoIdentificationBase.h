@@ -44,7 +44,10 @@
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/MassDecompositionAlgorithm.h>
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIonScoringBase.h>
 
+#include <boost/shared_ptr.hpp>
+
 // stl includes
+#include <map>
 #include <vector>
 
 namespace OpenMS
@@ -85,6 +88,16 @@ public:
 
     typedef CompNovoIonScoringBase::IonScore IonScore;
 
+    /**
+      @brief Cache of filtered mass decompositions
+
+      The key is the mass binned to an integer multiple of
+      "decomp_weights_precision" and the fragment mass tolerance. The cache
+      is shared between the per-thread copies used in getIdentifications();
+      access is serialized by a named OpenMP critical section.
+    */
+    typedef std::map<std::pair<Int64, double>, std::vector<MassDecomposition> > DecompositionCache;
+
 protected:
 
     /// update members method from DefaultParamHandler to update the members
@@ -99,7 +112,7 @@ protected:
     /// filters the decomps by the amino acid frequencies
     void filterDecomps_(std::vector<MassDecomposition> & decomps);
 
-    /// produces mass decompositions using the given mass
+    /// produces mass decompositions using the given mass (binned to "decomp_weights_precision" unless @p no_caching is set)
     void getDecompositions_(std::vector<MassDecomposition> & decomps, double mass, bool no_caching = false);
 
     /// permuts the String s adds the prefix and stores the results in permutations
@@ -171,7 +184,8 @@ protected:
 
     Size max_isotope_;
 
-    Map<double, std::vector<MassDecomposition> > decomp_cache_;
+    /// decompositions computed so far, reset whenever the parameters change
+    boost::shared_ptr<DecompositionCache> decomp_cache_;
 
     Map<String, std::set<String> > permute_cache_;
 
@@ -39,6 +39,10 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <fstream>
+#include <limits>
 
 #ifdef NDEBUG
 #define DEBUG_ONLY if (false)
@@ -554,6 +558,130 @@ namespace seqan
   {
     setHost(me, reinterpret_cast<TNeedle2 const &>(needle));
   }
+
+  /**
+    @brief Write the (fully constructed) trie of @p me to a binary stream.
+
+    Per vertex, its depth, its successors for every AAcid (including all nextMove edges) and its output needles are written.
+    The needles themselves are not stored.
+  */
+  template <typename TNeedle>
+  inline void _storeAcTrie(const Pattern<TNeedle, FuzzyAC>& me, std::ostream& os)
+  {
+    typedef typename Pattern<TNeedle, FuzzyAC>::TVert TVert;
+    typedef typename Pattern<TNeedle, FuzzyAC>::TSize TSize;
+    typedef typename ValueSize<AAcid>::Type TAlphabetSize;
+    const TVert nilVal = getNil<TVert>();
+    const uint32_t nil_out = std::numeric_limits<uint32_t>::max();
+
+    // createTrie() never removes vertices, i.e. vertex IDs are consecutive
+    const uint64_t n_vertices = length(me.data_node_depth);
+    const uint32_t root = (uint32_t)getRoot(me.data_graph);
+    os.write(reinterpret_cast<const char*>(&n_vertices), sizeof(n_vertices));
+    os.write(reinterpret_cast<const char*>(&root), sizeof(root));
+
+    uint32_t targets[ValueSize<AAcid>::VALUE];
+    for (uint64_t v = 0; v < n_vertices; ++v)
+    {
+      const uint8_t depth = getProperty(me.data_node_depth, TVert(v));
+      os.write(reinterpret_cast<const char*>(&depth), sizeof(depth));
+      for (TAlphabetSize c = 0; c < ValueSize<AAcid>::VALUE; ++c)
+      {
+        const TVert target = getSuccessor(me.data_graph, TVert(v), AAcid(c));
+        targets[c] = (target == nilVal ? nil_out : (uint32_t)target);
+      }
+      os.write(reinterpret_cast<const char*>(targets), sizeof(targets));
+      const String<TSize>& out = getProperty(me.data_map_outputNodes, TVert(v));
+      const uint32_t n_out = (uint32_t)length(out);
+      os.write(reinterpret_cast<const char*>(&n_out), sizeof(n_out));
+      for (uint32_t i = 0; i < n_out; ++i)
+      {
+        const uint32_t needle = (uint32_t)out[i];
+        os.write(reinterpret_cast<const char*>(&needle), sizeof(needle));
+      }
+    }
+  }
+
+  /**
+    @brief Read a trie written by _storeAcTrie() into @p me, replacing its current trie.
+
+    The host (i.e. needles) of @p me must be set separately and must be identical to the needles used when the trie was built.
+    @return false if the stream ended prematurely (the trie of @p me is then invalid)
+  */
+  template <typename TNeedle>
+  inline bool _loadAcTrie(Pattern<TNeedle, FuzzyAC>& me, std::istream& is)
+  {
+    typedef typename Pattern<TNeedle, FuzzyAC>::TVert TVert;
+    typedef typename Pattern<TNeedle, FuzzyAC>::TSize TSize;
+    typedef typename ValueSize<AAcid>::Type TAlphabetSize;
+    const uint32_t nil_out = std::numeric_limits<uint32_t>::max();
+
+    uint64_t n_vertices(0);
+    uint32_t root(0);
+    is.read(reinterpret_cast<char*>(&n_vertices), sizeof(n_vertices));
+    is.read(reinterpret_cast<char*>(&root), sizeof(root));
+    if (!is || n_vertices == 0 || root >= n_vertices) return false;
+
+    clear(me.data_graph);
+    clear(me.data_map_outputNodes);
+    for (uint64_t v = 0; v < n_vertices; ++v)
+    {
+      addVertex(me.data_graph);
+    }
+    assignRoot(me.data_graph, TVert(root));
+    resizeVertexMap(me.data_graph, me.data_node_depth);
+    resizeVertexMap(me.data_graph, me.data_map_outputNodes);
+
+    uint32_t targets[ValueSize<AAcid>::VALUE];
+    for (uint64_t v = 0; v < n_vertices; ++v)
+    {
+      uint8_t depth(0);
+      is.read(reinterpret_cast<char*>(&depth), sizeof(depth));
+      is.read(reinterpret_cast<char*>(targets), sizeof(targets));
+      uint32_t n_out(0);
+      is.read(reinterpret_cast<char*>(&n_out), sizeof(n_out));
+      if (!is) return false;
+
+      assignProperty(me.data_node_depth, TVert(v), depth);
+      for (TAlphabetSize c = 0; c < ValueSize<AAcid>::VALUE; ++c)
+      {
+        if (targets[c] == nil_out) continue;
+        if (targets[c] >= n_vertices) return false;
+        addEdge(me.data_graph, TVert(v), TVert(targets[c]), AAcid(c));
+      }
+      String<TSize> out;
+      for (uint32_t i = 0; i < n_out; ++i)
+      {
+        uint32_t needle(0);
+        is.read(reinterpret_cast<char*>(&needle), sizeof(needle));
+        appendValue(out, TSize(needle));
+      }
+      if (!is) return false;
+      assignProperty(me.data_map_outputNodes, TVert(v), out);
+    }
+
+#ifndef NDEBUG
+    // trie edges are the only ones leading exactly one level deeper (nextMove edges never do)
+    resizeVertexMap(me.data_graph, me.parentMap);
+    for (uint64_t v = 0; v < n_vertices; ++v)
+    {
+      assignProperty(me.parentMap, TVert(v), getNil<TVert>());
+    }
+    for (uint64_t v = 0; v < n_vertices; ++v)
+    {
+      for (TAlphabetSize c = 0; c < ValueSize<AAcid>::VALUE; ++c)
+      {
+        const TVert target = getSuccessor(me.data_graph, TVert(v), AAcid(c));
+        if (target != getNil<TVert>() &&
+            getProperty(me.data_node_depth, target) == getProperty(me.data_node_depth, TVert(v)) + 1)
+        {
+          assignProperty(me.parentMap, target, TVert(v));
+        }
+      }
+    }
+#endif
+    return true;
+  }
   //____________________________________________________________________________
 
   //____________________________________________________________________________
@@ -993,6 +1121,85 @@ namespace OpenMS
       pattern.init(pep_db, KeyWordLengthType(aaa_max), KeyWordLengthType(mm_max));
     }
 
+    /**
+      @brief Checksum (64 bit FNV-1a) over all peptides of @p pep_db, used to identify a stored pattern.
+    */
+    static UInt64 computeChecksum(const PeptideDB& pep_db)
+    {
+      const UInt64 prime = 1099511628211ULL;
+      UInt64 hash = 14695981039346656037ULL;
+      for (Size i = 0; i < ::seqan::length(pep_db); ++i)
+      {
+        const ::seqan::AAString& pep = pep_db[i];
+        for (Size j = 0; j < ::seqan::length(pep); ++j)
+        {
+          hash = (hash ^ UInt64(::seqan::ordValue(pep[j]))) * prime;
+        }
+        hash = (hash ^ UInt64(0xFF)) * prime; // separator; not a valid AAcid
+      }
+      return hash;
+    }
+
+    /**
+      @brief Store the trie of @p pattern (created with initPattern() from @p pep_db) in a binary file.
+
+      The file can be used by loadPattern() to skip the construction of the trie for the same peptides.
+      The peptides themselves are not stored, only their number and checksum.
+
+      @return false if the file could not be written
+    */
+    static bool storePattern(const FuzzyACPattern& pattern, const PeptideDB& pep_db, const String& filename)
+    {
+      std::ofstream os(filename.c_str(), std::ios::out | std::ios::binary);
+      if (!os) return false;
+      const UInt32 magic = PATTERN_FILE_MAGIC_;
+      const UInt32 version = PATTERN_FILE_VERSION_;
+      const UInt8 aaa_max = pattern.max_ambAA, mm_max = pattern.max_mmAA;
+      const UInt64 n_peptides = ::seqan::length(pep_db), checksum = computeChecksum(pep_db);
+      os.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+      os.write(reinterpret_cast<const char*>(&version), sizeof(version));
+      os.write(reinterpret_cast<const char*>(&aaa_max), sizeof(aaa_max));
+      os.write(reinterpret_cast<const char*>(&mm_max), sizeof(mm_max));
+      os.write(reinterpret_cast<const char*>(&n_peptides), sizeof(n_peptides));
+      os.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+      ::seqan::_storeAcTrie(pattern, os);
+      return bool(os);
+    }
+
+    /**
+      @brief Load a pattern written by storePattern(), as an alternative to initPattern().
+
+      Succeeds only if the file was created for the same peptides (in the same order) and the same @p aaa_max and @p mm_max.
+      The pattern keeps a reference to @p pep_db, just like after initPattern().
+
+      @return false if the file does not exist, is corrupt or was created for different input; @p pattern must then be
+              (re-)initialized with initPattern() before use
+    */
+    static bool loadPattern(const String& filename, const PeptideDB& pep_db, const int aaa_max, const int mm_max, FuzzyACPattern& pattern)
+    {
+      std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+      if (!is) return false;
+      UInt32 magic(0), version(0);
+      UInt8 file_aaa_max(0), file_mm_max(0);
+      UInt64 n_peptides(0), checksum(0);
+      is.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+      is.read(reinterpret_cast<char*>(&version), sizeof(version));
+      is.read(reinterpret_cast<char*>(&file_aaa_max), sizeof(file_aaa_max));
+      is.read(reinterpret_cast<char*>(&file_mm_max), sizeof(file_mm_max));
+      is.read(reinterpret_cast<char*>(&n_peptides), sizeof(n_peptides));
+      is.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+      if (!is || magic != PATTERN_FILE_MAGIC_ || version != PATTERN_FILE_VERSION_ ||
+          file_aaa_max != KeyWordLengthType(aaa_max) || file_mm_max != KeyWordLengthType(mm_max) ||
+          n_peptides != ::seqan::length(pep_db) || checksum != computeChecksum(pep_db))
+      {
+        return false;
+      }
+      pattern.max_ambAA = KeyWordLengthType(aaa_max);
+      pattern.max_mmAA = KeyWordLengthType(mm_max);
+      ::seqan::setValue(pattern.data_host, pep_db);
+      return ::seqan::_loadAcTrie(pattern, is);
+    }
+
     /**
       @brief Default Ctor; call setProtein() before using findNext().
 
@@ -1062,6 +1269,9 @@ namespace OpenMS
   private:
     typedef typename FuzzyACPattern::KeyWordLengthType KeyWordLengthType;
 
+    static const UInt32 PATTERN_FILE_MAGIC_ = 0x43414d4f; ///< "OMAC" (little endian)
+    static const UInt32 PATTERN_FILE_VERSION_ = 1;
+
     // member
     ::seqan::Finder<seqan::AAString> finder_; ///< locate the next peptide hit in protein
     ::seqan::AAString protein_;               ///< the protein sequence - we need to store it since the finder only keeps a pointer to protein when constructed
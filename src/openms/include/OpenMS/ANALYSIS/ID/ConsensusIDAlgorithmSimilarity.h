@@ -36,6 +36,8 @@
 
 #include <OpenMS/ANALYSIS/ID/ConsensusIDAlgorithm.h>
 
+#include <boost/unordered_map.hpp>
+
 namespace OpenMS
 {
   /**
@@ -46,6 +48,9 @@ namespace OpenMS
     Nahnsen <em>et al.</em>: <a href="https://doi.org/10.1021/pr2002879">Probabilistic consensus scoring improves tandem mass spectrometry peptide identification</a> (J. Proteome Res., 2011, PMID: 21644507).
 
     Derived classes should implement getSimilarity_(), which defines how similarity of two peptide sequences is quantified.
+    Similarities are cached by this class (keyed by the pair of sequences), since the same sequences recur heavily across spectra; identical sequences are short-circuited to a similarity of 1 without calling getSimilarity_().
+
+    Instances are not thread-safe (because of the cache). To process spectra in parallel, use one instance per thread.
 
     @htmlinclude OpenMS_ConsensusIDAlgorithmSimilarity.parameters
     
@@ -58,8 +63,8 @@ namespace OpenMS
     /// Default constructor
     ConsensusIDAlgorithmSimilarity();
 
-    /// Mapping: pair of peptide sequences -> sequence similarity
-    typedef std::map<std::pair<AASequence, AASequence>, double> SimilarityCache;
+    /// Mapping: pair of peptide sequences (as strings, lexicographically ordered) -> sequence similarity
+    typedef boost::unordered_map<std::pair<String, String>, double> SimilarityCache;
 
     /// Cache for already computed sequence similarities
     SimilarityCache similarities_;
@@ -67,12 +72,25 @@ namespace OpenMS
     /**
        @brief Sequence similarity calculation (to be implemented by subclasses).
 
-       Implementations should use/update the cache of previously computed similarities.
+       Caching is done by the caller (see getCachedSimilarity_()), so implementations only need to compute the similarity.
+       The result must not depend on the order of the two sequences.
 
        @return Similarity between two sequences in the range [0, 1]
     */
     virtual double getSimilarity_(AASequence seq1, AASequence seq2) = 0;
 
+    /**
+       @brief Sequence similarity with caching
+
+       @param seq1 First sequence
+       @param key1 String representation of @p seq1 (passed in to avoid repeated conversions)
+       @param seq2 Second sequence
+       @param key2 String representation of @p seq2
+
+       @return Similarity between two sequences in the range [0, 1]
+    */
+    double getCachedSimilarity_(const AASequence& seq1, const String& key1, const AASequence& seq2, const String& key2);
+
   private:
     /// Not implemented
     ConsensusIDAlgorithmSimilarity(const ConsensusIDAlgorithmSimilarity&);
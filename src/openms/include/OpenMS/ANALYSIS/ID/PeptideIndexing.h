@@ -39,6 +39,7 @@
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/DATASTRUCTURES/FASTAContainer.h>
@@ -50,12 +51,16 @@
 #include <OpenMS/METADATA/PeptideEvidence.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
 
 #include <atomic>
 #include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <future>
+#include <sstream>
 
 
 namespace OpenMS
@@ -339,9 +344,30 @@ public:
         StopWatch s;
         s.start();
         AhoCorasickAmbiguous::FuzzyACPattern pattern;
-        AhoCorasickAmbiguous::initPattern(pep_DB, aaa_max_, mm_max_, pattern);
+        String cache_file;
+        bool pattern_from_cache(false);
+        if (!automaton_cache_.empty())
+        { // re-use the trie of an earlier run with the same peptides (e.g. when indexing against several databases)
+          std::stringstream cache_name;
+          cache_name << "PeptideIndexer_" << std::hex << AhoCorasickAmbiguous::computeChecksum(pep_DB) << std::dec << "_" << length(pep_DB) << "_" << aaa_max_ << "_" << mm_max_ << ".trie";
+          cache_file = String(automaton_cache_).ensureLastChar('/') + cache_name.str();
+          pattern_from_cache = AhoCorasickAmbiguous::loadPattern(cache_file, pep_DB, aaa_max_, mm_max_, pattern);
+        }
+        if (!pattern_from_cache)
+        {
+          AhoCorasickAmbiguous::initPattern(pep_DB, aaa_max_, mm_max_, pattern);
+          if (!cache_file.empty())
+          { // write to a unique name first, so concurrent runs never see a partial file
+            String tmp_file = cache_file + "." + File::getUniqueName(false) + ".part";
+            if (!AhoCorasickAmbiguous::storePattern(pattern, pep_DB, tmp_file) || std::rename(tmp_file.c_str(), cache_file.c_str()) != 0)
+            {
+              File::remove(tmp_file);
+              LOG_WARN << "\nWarning: Could not store the trie in '" << cache_file << "'." << std::endl;
+            }
+          }
+        }
         s.stop();
-        LOG_INFO << " done (" << int(s.getClockTime()) << "s)" << std::endl;
+        LOG_INFO << (pattern_from_cache ? " loaded from cache" : " done") << " (" << int(s.getClockTime()) << "s)" << std::endl;
         s.reset();
 
         uint16_t count_j_proteins(0);
@@ -350,6 +376,10 @@ public:
         // use very large target value for progress if DB size is unknown (did not fit into first chunk)
         this->startProgress(0, proteins.size() == PROTEIN_CACHE_SIZE ? std::numeric_limits<SignedSize>::max() : proteins.size(), "Aho-Corasick");
         std::atomic<int> progress_prots(0);
+        // the next chunk of proteins is read on a background thread while the current one is searched;
+        // the first chunk was already read above
+        std::future<bool> next_chunk;
+        ParallelExceptionCollector exceptions;
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -365,25 +395,40 @@ public:
             #pragma omp single
             {
               DEBUG_ONLY std::cerr << " activating cache ...\n";
-              has_active_data = proteins.activateCache(); // swap in last cache
+              bool chunk_read = true;
+              if (next_chunk.valid())
+              { // background reading of this chunk must be finished; get() rethrows errors from reading the FASTA file
+                try
+                {
+                  chunk_read = next_chunk.get();
+                }
+                catch (...)
+                {
+                  exceptions.capture();
+                  chunk_read = false; // do not search a partially read chunk
+                }
+              }
+              has_active_data = chunk_read && proteins.activateCache(); // swap in last cache
               protein_accessions.resize(proteins.getChunkOffset() + proteins.chunkSize());
+              if (has_active_data)
+              {
+                DEBUG_ONLY std::cerr << "Filling Protein Cache in background ...\n";
+                // only touches the background buffer and the file, i.e. nothing the search below uses
+                next_chunk = std::async(std::launch::async, [&proteins, PROTEIN_CACHE_SIZE]() { return proteins.cacheChunk(PROTEIN_CACHE_SIZE); });
+
+                const SignedSize chunk_size = (SignedSize)proteins.chunkSize();
+                protein_is_decoy.resize(proteins.getChunkOffset() + chunk_size);
+                for (SignedSize i = 0; i < chunk_size; ++i)
+                { // do this in one thread only, to avoid false sharing
+                  const String& seq = proteins.chunkAt(i).identifier;
+                  protein_is_decoy[i + proteins.getChunkOffset()] = (prefix_ ? seq.hasPrefix(decoy_string_) : seq.hasSuffix(decoy_string_));
+                }
+              }
             } // implicit barrier here
             
             if (!has_active_data) break; // leave while-loop
             SignedSize prot_count = (SignedSize)proteins.chunkSize();
 
-            #pragma omp master
-            {
-              DEBUG_ONLY std::cerr << "Filling Protein Cache ...";
-              proteins.cacheChunk(PROTEIN_CACHE_SIZE);
-              protein_is_decoy.resize(proteins.getChunkOffset() + prot_count);
-              for (SignedSize i = 0; i < prot_count; ++i)
-              { // do this in master only, to avoid false sharing
-                const String& seq = proteins.chunkAt(i).identifier;
-                protein_is_decoy[i + proteins.getChunkOffset()] = (prefix_ ? seq.hasPrefix(decoy_string_) : seq.hasSuffix(decoy_string_));
-              }
-              DEBUG_ONLY std::cerr << " done" << std::endl;
-            }
             DEBUG_ONLY std::cerr << " starting for loop \n";
             // search all peptides in each protein
             #pragma omp for schedule(dynamic, 100) nowait
@@ -473,6 +518,7 @@ public:
             } // OMP end critical
           } // end readChunk
         } // OMP end parallel
+        exceptions.rethrow();
         this->endProgress();
         std::cout << "Merge took: " << s.toString() << "\n";
         mu.after();
@@ -1040,6 +1086,8 @@ public:
     Int aaa_max_;
     Int mm_max_;
 
+    String automaton_cache_;
+
  };
 }
 
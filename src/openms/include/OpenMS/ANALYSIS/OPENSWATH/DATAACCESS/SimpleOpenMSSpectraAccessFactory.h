@@ -53,6 +53,17 @@ namespace OpenMS
     /// Simple Factory method to get a SpectrumAccess Ptr from an MSExperiment
     static OpenSwath::SpectrumAccessPtr getSpectrumAccessOpenMSPtr(boost::shared_ptr<OpenMS::PeakMap> exp);
 
+    /**
+      @brief Factory method to get a SpectrumAccess Ptr that refers to an existing MSExperiment
+
+      In contrast to getSpectrumAccessOpenMSPtr(), the experiment is neither
+      copied nor owned by the returned object.
+
+      @note The experiment has to outlive the returned pointer (and all light
+      clones created from it).
+    */
+    static OpenSwath::SpectrumAccessPtr getSpectrumAccessOpenMSPtrNoCopy(OpenMS::PeakMap& exp);
+
   private:
 
     static bool isExperimentCached(boost::shared_ptr<OpenMS::PeakMap> exp);
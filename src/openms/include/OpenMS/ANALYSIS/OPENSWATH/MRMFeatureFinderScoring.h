@@ -135,6 +135,10 @@ public:
                         TransformationDescription trafo, PeakMap& swath_map);
 
     /** @brief Pick features in one experiment containing chromatogram
+     *
+     * Transition groups are picked and scored in parallel (if OpenMP is
+     * enabled), each thread using its own picker and scoring objects. The
+     * order of the output features is the same as in a serial run.
      *
      * @param input The input chromatograms
      * @param output The output features with corresponding scores
@@ -291,6 +295,8 @@ private:
     int stop_report_after_feature_;
     bool write_convex_hull_;
     bool strict_;
+    /// Whether scorePeakgroups() assigns unique ids (disabled for the worker threads of pickExperiment())
+    bool assign_unique_ids_;
     String scoring_model_;
 
     // scoring parameters
@@ -37,6 +37,8 @@
 #include <OpenMS/DATASTRUCTURES/Matrix.h>
 #include <Eigen/Core>
 
+#include <map>
+
 namespace OpenMS
 {
   class IsobaricQuantitationMethod;
@@ -65,13 +67,21 @@ public:
                                                                   const IsobaricQuantitationMethod* quant_method);
 
 private:
+    /// Maps the map index of a channel to its channel id (i.e. the row in the correction matrix).
+    typedef std::map<UInt64, Int> ChannelIndexMap;
+
+    /**
+     @brief Collects the channel id of every map (column header) in @p cm.
+     */
+    static ChannelIndexMap getChannelIds_(const ConsensusMap& cm);
+
     /**
      @brief Fills the input vector for the Eigen/NNLS step given the ConsensusFeature.
      */
     static void fillInputVector_(Eigen::VectorXd& b,
                                  Matrix<double>& m_b,
                                  const ConsensusFeature& cf,
-                                 const ConsensusMap& cm);
+                                 const ChannelIndexMap& channel_ids);
 
     /**
      @brief
@@ -94,7 +104,8 @@ private:
     static float updateOutpuMap_(const ConsensusMap& consensus_map_in,
                                  ConsensusMap& consensus_map_out,
                                  Size current_cf,
-                                 const Matrix<double>& m_x);
+                                 const Matrix<double>& m_x,
+                                 const ChannelIndexMap& channel_ids);
   };
 } // namespace
 
@@ -151,6 +151,19 @@ namespace OpenMS
     /// Cross-validation results
     SVMPerformance performance_;
 
+    /// Training and test data for one cross-validation partition
+    struct XvalFold_
+    {
+      /// Training data (LIBSVM format; pointers into @p nodes_)
+      std::vector<struct svm_node*> train_x;
+
+      /// Class labels of the training data
+      std::vector<double> train_y;
+
+      /// Indexes of the test observations in the training set (@p data_)
+      std::vector<Size> test;
+    };
+
     /// Dummy function to suppress LIBSVM output
     static void printNull_(const char*) {}
 
@@ -163,6 +176,12 @@ namespace OpenMS
     /// Choose best SVM parameters based on cross-validation results
     std::pair<double, double> chooseBestParameters_() const;
 
+    /// Partition the training data for cross-validation (stratified by class, reproducible)
+    void createXvalFolds_(std::vector<XvalFold_>& folds) const;
+
+    /// Train a model on the training part of @p fold and return the number of correct predictions on its test part
+    Size evaluateXvalFold_(const XvalFold_& fold, const struct svm_parameter& params) const;
+
     /// Run cross-validation to optimize SVM parameters
     void optimizeParameters_();
   };
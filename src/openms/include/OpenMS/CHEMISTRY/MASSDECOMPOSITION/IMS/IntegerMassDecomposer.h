@@ -35,9 +35,13 @@
 
 #pragma once
 
+#include <istream>
+#include <limits>
+#include <ostream>
 #include <vector>
 #include <utility>
 
+#include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/Weights.h>
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/MassDecomposer.h>
 
@@ -58,6 +62,11 @@ namespace OpenMS
       algorithm, store the residues of the smallest decomposable numbers
       for every modulo of the smallest alphabet mass.
 
+      The tables are computed once in the constructor (or read with
+      IntegerMassDecomposer(const Weights&, std::istream&) from a stream
+      written by store()) and never changed afterwards, all queries are
+      const and can be used concurrently.
+
       @param ValueType Type of values to be decomposed.
       @param DecompositionValueType Type of decomposition elements.
 
@@ -93,13 +102,28 @@ public:
       */
       explicit IntegerMassDecomposer(const Weights & alphabet);
 
+      /**
+        Constructor reading the precomputed tables from a stream written by store().
+
+        @param alphabet Weights over which masses to be decomposed.
+        @param is Binary input stream positioned at the tables.
+        @throw Exception::ParseError if the stream is truncated or corrupt, or the tables were computed for other weights
+      */
+      IntegerMassDecomposer(const Weights & alphabet, std::istream & is);
+
+      /**
+        Writes the precomputed tables (and the integer weights they belong to)
+        in a binary, platform dependent format to @p os.
+      */
+      void store(std::ostream & os) const;
+
       /**
         Returns true if decomposition over the @c mass exists, otherwise - false.
 
         @param mass Mass to be decomposed.
         @return true if decomposition over a given mass exists, otherwise - false.
       */
-      bool exist(value_type mass) override;
+      bool exist(value_type mass) const override;
 
       /**
         Gets one possible decomposition for @c mass.
@@ -107,7 +131,7 @@ public:
         @param mass Mass to be decomposed.
         @return One possible decomposition for a given mass.
       */
-      decomposition_type getDecomposition(value_type mass) override;
+      decomposition_type getDecomposition(value_type mass) const override;
 
       /**
         Gets all possible decompositions for @c mass.
@@ -115,7 +139,7 @@ public:
         @param mass Mass to be decomposed.
         @return All possible decompositions for a given mass.
       */
-      decompositions_type getAllDecompositions(value_type mass) override;
+      decompositions_type getAllDecompositions(value_type mass) const override;
 
       /**
         Gets number of all possible decompositions for a given @c mass.
@@ -125,7 +149,7 @@ public:
         @param mass Mass to be decomposed
         @return number of decompositions for a given mass.
       */
-      decomposition_value_type getNumberOfDecompositions(value_type mass) override;
+      decomposition_value_type getNumberOfDecompositions(value_type mass) const override;
 
 private:
 
@@ -196,7 +220,40 @@ private:
         @param decompositionsStore Container where decompositions are collected.
       */
       void collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                             decomposition_type decomposition, decompositions_type & decompositionsStore);
+                                             decomposition_type decomposition, decompositions_type & decompositionsStore) const;
+
+      /// writes the size and the elements of @p values to @p os
+      template <typename T>
+      static void writeVector_(std::ostream & os, const std::vector<T> & values)
+      {
+        size_type size = values.size();
+        os.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        if (size > 0)
+        {
+          os.write(reinterpret_cast<const char *>(&values[0]), size * sizeof(T));
+        }
+      }
+
+      /// reads a vector written by writeVector_() from @p is
+      template <typename T>
+      static void readVector_(std::istream & is, std::vector<T> & values)
+      {
+        size_type size = 0;
+        is.read(reinterpret_cast<char *>(&size), sizeof(size));
+        if (!is || size > (std::numeric_limits<size_type>::max)() / sizeof(T))
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Truncated or corrupt mass decomposition table.");
+        }
+        values.resize(size);
+        if (size > 0)
+        {
+          is.read(reinterpret_cast<char *>(&values[0]), size * sizeof(T));
+        }
+        if (!is)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Truncated or corrupt mass decomposition table.");
+        }
+      }
     };
 
 
@@ -215,6 +272,82 @@ private:
 
     }
 
+    template <typename ValueType, typename DecompositionValueType>
+    IntegerMassDecomposer<ValueType, DecompositionValueType>::IntegerMassDecomposer(
+      const Weights & alphabet, std::istream & is) :
+      alphabet_(alphabet)
+    {
+      // the tables only depend on the integer weights, which have to match exactly
+      residues_table_row_type weights;
+      readVector_(is, weights);
+      bool same_weights = (weights.size() == alphabet.size());
+      for (size_type i = 0; same_weights && i < weights.size(); ++i)
+      {
+        same_weights = (weights[i] == alphabet.getWeight(i));
+      }
+      if (!same_weights)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Mass decomposition table was computed for different weights.");
+      }
+
+      is.read(reinterpret_cast<char *>(&infty_), sizeof(infty_));
+      readVector_(is, lcms_);
+      readVector_(is, mass_in_lcms_);
+      readVector_(is, witness_vector_);
+
+      size_type rows = 0;
+      is.read(reinterpret_cast<char *>(&rows), sizeof(rows));
+      // the table must have exactly the shape fillExtendedResidueTable_() gives it, since queries index it without checks
+      const size_type expected_rows = (alphabet.size() < 2 ? 0 : alphabet.size());
+      const size_type columns = (expected_rows == 0 ? 0 : size_type(alphabet.getWeight(0)));
+      bool valid = is && rows == expected_rows && witness_vector_.size() == columns
+                   && lcms_.size() == alphabet.size() && mass_in_lcms_.size() == alphabet.size();
+      for (size_type i = 1; valid && i < expected_rows; ++i) // values for i == 0 are unused
+      {
+        valid = lcms_[i] > 0 && mass_in_lcms_[i] > 0;
+      }
+      for (size_type i = 0; valid && i < witness_vector_.size(); ++i)
+      {
+        valid = witness_vector_[i].first < alphabet.size();
+      }
+      if (!valid)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Truncated or corrupt mass decomposition table.");
+      }
+      ertable_.resize(rows);
+      for (size_type i = 0; i < rows; ++i)
+      {
+        readVector_(is, ertable_[i]);
+        if (ertable_[i].size() != columns)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Truncated or corrupt mass decomposition table.");
+        }
+      }
+    }
+
+    template <typename ValueType, typename DecompositionValueType>
+    void IntegerMassDecomposer<ValueType, DecompositionValueType>::store(std::ostream & os) const
+    {
+      residues_table_row_type weights(alphabet_.size());
+      for (size_type i = 0; i < alphabet_.size(); ++i)
+      {
+        weights[i] = alphabet_.getWeight(i);
+      }
+      writeVector_(os, weights);
+
+      os.write(reinterpret_cast<const char *>(&infty_), sizeof(infty_));
+      writeVector_(os, lcms_);
+      writeVector_(os, mass_in_lcms_);
+      writeVector_(os, witness_vector_);
+
+      size_type rows = ertable_.size();
+      os.write(reinterpret_cast<const char *>(&rows), sizeof(rows));
+      for (size_type i = 0; i < rows; ++i)
+      {
+        writeVector_(os, ertable_[i]);
+      }
+    }
+
     template <typename ValueType, typename DecompositionValueType>
     void IntegerMassDecomposer<ValueType, DecompositionValueType>::fillExtendedResidueTable_(
       const Weights & _alphabet, residues_table_row_type & _lcms, residues_table_row_type & _mass_in_lcms,
@@ -415,7 +548,7 @@ private:
 
     template <typename ValueType, typename DecompositionValueType>
     bool IntegerMassDecomposer<ValueType, DecompositionValueType>::
-    exist(value_type mass)
+    exist(value_type mass) const
     {
 
       value_type residue = ertable_.back().at(mass % alphabet_.getWeight(0));
@@ -424,7 +557,7 @@ private:
 
     template <typename ValueType, typename DecompositionValueType>
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_type
-    IntegerMassDecomposer<ValueType, DecompositionValueType>::getDecomposition(value_type mass)
+    IntegerMassDecomposer<ValueType, DecompositionValueType>::getDecomposition(value_type mass) const
     {
 
       decomposition_type decomposition;
@@ -460,7 +593,7 @@ private:
 
     template <typename ValueType, typename DecompositionValueType>
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decompositions_type
-    IntegerMassDecomposer<ValueType, DecompositionValueType>::getAllDecompositions(value_type mass)
+    IntegerMassDecomposer<ValueType, DecompositionValueType>::getAllDecompositions(value_type mass) const
     {
       decompositions_type decompositionsStore;
       decomposition_type decomposition(alphabet_.size());
@@ -471,7 +604,7 @@ private:
     template <typename ValueType, typename DecompositionValueType>
     void IntegerMassDecomposer<ValueType, DecompositionValueType>::
     collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                      decomposition_type decomposition, decompositions_type & decompositionsStore)
+                                      decomposition_type decomposition, decompositions_type & decompositionsStore) const
     {
       if (alphabetMassIndex == 0)
       {
@@ -548,7 +681,7 @@ private:
     */
     template <typename ValueType, typename DecompositionValueType>
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_value_type IntegerMassDecomposer<ValueType,
-                                                                                                                      DecompositionValueType>::getNumberOfDecompositions(value_type mass)
+                                                                                                                      DecompositionValueType>::getNumberOfDecompositions(value_type mass) const
     {
       return static_cast<typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_value_type>(getAllDecompositions(mass).size());
     }
@@ -57,6 +57,10 @@ namespace OpenMS
       Those problems are solved in integer arithmetic, i.e. only exact
       solutions are found with no error allowed.
 
+      All queries are const, implementations must not modify their state
+      when answering them, so one instance can be queried from several
+      threads at the same time.
+
       @param ValueType Type of values to be decomposed.
       @param DecompositionValueType Type of decomposition elements.
 
@@ -98,7 +102,7 @@ public:
         @param mass Mass to be checked on decomposing.
         @return true, if the decomposition for @c mass exist, otherwise - false.
       */
-      virtual bool exist(value_type mass) = 0;
+      virtual bool exist(value_type mass) const = 0;
 
       /**
         Returns one possible decomposition of the given @c mass.
@@ -106,7 +110,7 @@ public:
         @param mass Mass to be decomposed.
         @return The decomposition of the @c mass, if one exists, otherwise - an empty container.
       */
-      virtual decomposition_type getDecomposition(value_type mass) = 0;
+      virtual decomposition_type getDecomposition(value_type mass) const = 0;
 
       /**
         Returns all possible decompositions for the given @c mass.
@@ -115,7 +119,7 @@ public:
         @return All possible decompositions of the @c mass, if there are any exist,
         otherwise - an empty container.
       */
-      virtual decompositions_type getAllDecompositions(value_type mass) = 0;
+      virtual decompositions_type getAllDecompositions(value_type mass) const = 0;
 
       /**
         Returns the number of possible decompositions for the given @c mass.
@@ -123,7 +127,7 @@ public:
         @param mass Mass to be decomposed.
         @return The number of possible decompositions for the @c mass.
       */
-      virtual decomposition_value_type getNumberOfDecompositions(value_type mass) = 0;
+      virtual decomposition_value_type getNumberOfDecompositions(value_type mass) const = 0;
 
     };
 
@@ -38,6 +38,8 @@
 #include <utility>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/IntegerMassDecomposer.h>
 
@@ -62,6 +64,13 @@ namespace OpenMS
       them using @c IntegerMassDecomposer, does some checks (i.e. on false
       positives appeared due to rounding) and collects decompositions together.
 
+      The extended residue table of the integer decomposer is immutable after
+      construction and shared between copies, so copying a decomposer is
+      cheap and all queries can be used from several threads at the same time.
+      The table can be written to disk with storeTable() and read back for the
+      same weights, which avoids recomputing it for large alphabets or fine
+      precisions.
+
       @author Anton Pervukhin <Anton.Pervukhin@CeBiTec.Uni-Bielefeld.DE>
     */
     class OPENMS_DLLAPI RealMassDecomposer
@@ -89,6 +98,24 @@ public:
       */
       explicit RealMassDecomposer(const Weights & weights);
 
+      /**
+        Constructor with weights, reading the precomputed table from a file
+        written by storeTable().
+
+        @param weights Weights over which values/masses to be decomposed.
+        @param table_file File written by storeTable() for the same weights.
+        @throw Exception::FileNotFound if @p table_file cannot be opened
+        @throw Exception::ParseError if @p table_file is corrupt or belongs to different weights
+      */
+      RealMassDecomposer(const Weights & weights, const std::string & table_file);
+
+      /**
+        Writes the precomputed decomposition table to @p table_file.
+
+        @throw Exception::UnableToCreateFile if @p table_file cannot be written
+      */
+      void storeTable(const std::string & table_file) const;
+
       /**
         Gets all decompositions for a @c mass with an @c error allowed.
 
@@ -96,9 +123,19 @@ public:
         @param error Error allowed between given and result decomposition.
         @return All possible decompositions for a given mass and error.
       */
-      decompositions_type getDecompositions(double mass, double error);
+      decompositions_type getDecompositions(double mass, double error) const;
 
-      decompositions_type getDecompositions(double mass, double error, const constraints_type & constraints);
+      decompositions_type getDecompositions(double mass, double error, const constraints_type & constraints) const;
+
+      /**
+        Gets all decompositions for each of the @c masses with an @c error allowed.
+        The masses are decomposed in parallel (if OpenMP is enabled).
+
+        @param masses Masses to be decomposed.
+        @param error Error allowed between given and result decomposition.
+        @return Decompositions for every mass, in the order of @p masses.
+      */
+      std::vector<decompositions_type> getDecompositions(const std::vector<double> & masses, double error) const;
 
       /**
        Gets a number of all decompositions for a @c mass with an @c error
@@ -109,7 +146,7 @@ public:
        @param error Error allowed between given and result decomposition.
        @return Number of all decompositions for a given mass and error.
       */
-      number_of_decompositions_type getNumberOfDecompositions(double mass, double error);
+      number_of_decompositions_type getNumberOfDecompositions(double mass, double error) const;
 
 private:
       /// Weights over which values/masses to be decomposed.
@@ -125,7 +162,7 @@ private:
         Decomposer to be used for exact decomposing using
         integer arithmetic.
       */
-      std::shared_ptr<integer_decomposer_type> decomposer_;
+      std::shared_ptr<const integer_decomposer_type> decomposer_;
     };
 
   } // namespace ims
@@ -86,7 +86,7 @@ public:
     */
     //@{
     /// returns the possible decompositions given the weight
-    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight);
+    void getDecompositions(std::vector<MassDecomposition> & decomps, double weight) const;
     //@}
 
 protected:
@@ -93,6 +93,12 @@ public:
 
 protected:
     void updateMembers_() override;
+
+    /// batched scoring: shared bins are counted via a sparse matrix product of the stacked (binary) bin patterns
+    void compareRange_(const std::vector<BinnedSpectrum>& queries, Size q_begin, Size q_end,
+                       const std::vector<BinnedSpectrum>& targets, Size t_begin, Size t_end,
+                       SimilarityMatrix& scores) const override;
+
     double precursor_mass_tolerance_;
   };
 
@@ -94,6 +94,12 @@ public:
 
 protected:
     void updateMembers_() override;
+
+    /// batched scoring via a sparse matrix product of the stacked bins
+    void compareRange_(const std::vector<BinnedSpectrum>& queries, Size q_begin, Size q_end,
+                       const std::vector<BinnedSpectrum>& targets, Size t_begin, Size t_end,
+                       SimilarityMatrix& scores) const override;
+
     double precursor_mass_tolerance_;
   };
 
@@ -39,6 +39,8 @@
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
 
 #include <cmath>
+#include <utility>
+#include <vector>
 
 namespace OpenMS
 {
@@ -51,6 +53,11 @@ namespace OpenMS
     documentation of the concrete functors.
     Functors normalized in the range [0,1] are identifiable at the set "normalized" parameter of the ParameterHandler
 
+    For all-vs-all comparisons (e.g. spectral clustering or library search), compareBlock() and getTopNeighbors()
+    score many spectra at once. Functors whose score can be expressed via sparse matrix products (e.g.
+    BinnedSpectralContrastAngle, BinnedSharedPeakCount) stack the bins of a block of spectra into a sparse matrix
+    and compute the whole block of similarities with one product. All other functors fall back to pairwise calls.
+
     @ingroup SpectraComparison
   */
   class OPENMS_DLLAPI BinnedSpectrumCompareFunctor :
@@ -60,6 +67,15 @@ namespace OpenMS
 private:
 
 public:
+    /// dense block of similarities (rows: queries, columns: targets)
+    typedef Eigen::MatrixXd SimilarityMatrix;
+
+    /// sparse matrix of stacked bins (rows: bins, columns: spectra)
+    typedef Eigen::SparseMatrix<float> StackedBinsType;
+
+    /// a neighbour of a query spectrum (index of the target spectrum, similarity)
+    typedef std::pair<Size, double> Neighbor;
+
     /// default constructor
     BinnedSpectrumCompareFunctor();
 
@@ -78,6 +94,33 @@ public:
     /// function call operator, calculates self similarity
     virtual double operator()(const BinnedSpectrum& spec) const = 0;
 
+    /**
+      @brief calculates the similarities of all @p queries against all @p targets
+
+      Scores are identical (up to floating point rounding) to calling operator() for each pair.
+
+      @param queries Binned spectra (rows of @p scores)
+      @param targets Binned spectra (columns of @p scores), all compatible with @p queries
+      @param scores Resulting similarities (resized to queries.size() x targets.size())
+    */
+    void compareBlock(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& targets, SimilarityMatrix& scores) const;
+
+    /**
+      @brief finds the @p k most similar @p targets for each of the @p queries
+
+      Queries and targets are processed in blocks of @p block_size spectra, so memory is bounded by the block size
+      instead of queries.size() x targets.size(). Blocks of queries are processed in parallel (OpenMP).
+      If @p queries and @p targets are the same object, the trivial self-matches are skipped.
+      Pairs with a similarity of zero (or NaN) are never reported.
+
+      @param queries Binned spectra to find neighbours for
+      @param targets Binned spectra to search in
+      @param k Maximum number of neighbours per query
+      @param neighbors Resulting neighbours per query, sorted by decreasing similarity (ties by increasing index)
+      @param block_size Number of spectra stacked into one matrix
+    */
+    void getTopNeighbors(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& targets, Size k, std::vector<std::vector<Neighbor> >& neighbors, Size block_size = 1000) const;
+
     /// registers all derived products
     static void registerChildren();
 
@@ -87,6 +130,32 @@ public:
       return "BinnedSpectrumCompareFunctor";
     }
 
+protected:
+    /**
+      @brief calculates the similarities of queries[q_begin, q_end) against targets[t_begin, t_end)
+
+      The default implementation calls operator() for each pair. Derived classes may override it with a batched
+      implementation. Implementations must be thread-safe, as they are called concurrently by getTopNeighbors().
+    */
+    virtual void compareRange_(const std::vector<BinnedSpectrum>& queries, Size q_begin, Size q_end,
+                               const std::vector<BinnedSpectrum>& targets, Size t_begin, Size t_end,
+                               SimilarityMatrix& scores) const;
+
+    /**
+      @brief stacks the bins of spectra[begin, end) into the columns of a sparse matrix
+
+      @param spectra Binned spectra
+      @param begin First spectrum to stack
+      @param end One past the last spectrum to stack
+      @param rows Number of rows (must be larger than the highest bin index of all stacked spectra)
+      @param binary Store 1 for each filled bin instead of its intensity
+      @param stacked Resulting matrix (rows x (end - begin))
+    */
+    static void stackBins_(const std::vector<BinnedSpectrum>& spectra, Size begin, Size end, BinnedSpectrum::SparseVectorIndexType rows, bool binary, StackedBinsType& stacked);
+
+    /// returns one past the highest filled bin index of spectra[begin, end)
+    static BinnedSpectrum::SparseVectorIndexType getBinsEnd_(const std::vector<BinnedSpectrum>& spectra, Size begin, Size end);
+
   };
 
 }
@@ -0,0 +1,105 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <exception>
+
+namespace OpenMS
+{
+  /**
+    @brief Transports exceptions out of an OpenMP parallel region
+
+    An exception must not leave a parallel region (or the body of a worksharing loop).
+    Catch it inside, pass it to capture(), and call rethrow() after the region:
+
+    @code
+    ParallelExceptionCollector exceptions;
+#pragma omp parallel for
+    for (SignedSize i = 0; i < n; ++i)
+    {
+      try
+      {
+        process(i);
+      }
+      catch (...)
+      {
+        exceptions.capture();
+      }
+    }
+    exceptions.rethrow();
+    @endcode
+
+    Only the first captured exception is kept, the others are discarded.
+    The original exception type (e.g. Exception::ParseError) is preserved.
+
+    @ingroup Concept
+  */
+  class ParallelExceptionCollector
+  {
+public:
+    /// Default constructor (no exception captured)
+    ParallelExceptionCollector() :
+      exception_()
+    {
+    }
+
+    /// Stores the exception that is currently handled, unless another one was captured before. Must be called from a catch block.
+    void capture()
+    {
+#ifdef _OPENMP
+#pragma omp critical (ParallelExceptionCollector_capture)
+#endif
+      {
+        if (!exception_)
+        {
+          exception_ = std::current_exception();
+        }
+      }
+    }
+
+    /// Rethrows the captured exception (if any). Must be called outside of the parallel region.
+    void rethrow() const
+    {
+      if (exception_)
+      {
+        std::rethrow_exception(exception_);
+      }
+    }
+
+private:
+    /// The first captured exception
+    std::exception_ptr exception_;
+  };
+}
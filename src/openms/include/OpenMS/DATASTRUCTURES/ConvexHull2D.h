@@ -40,6 +40,7 @@
 #include <OpenMS/OpenMSConfig.h>
 #include <OpenMS/DATASTRUCTURES/Map.h>
 
+#include <utility>
 #include <vector>
 
 namespace OpenMS
@@ -64,6 +65,10 @@ namespace OpenMS
 
       The outer hullpoints can be queried by getHullPoints().
 
+      Internally, hulls built from peaks are stored compactly as one contiguous array of (RT, m/z range) entries
+      sorted by RT. The outer hull points are only expanded from this array when getHullPoints() is called,
+      so hulls that are only used for bounding box or encloses() queries never pay for the point list.
+
       @improvement For chromatograms we could postprocess the input and remove points in intermediate RT scans,
       which are currently reported but make the number of points rather large.
 
@@ -77,14 +82,26 @@ public:
     typedef PointArrayType::size_type SizeType;
     typedef PointArrayType::const_iterator PointArrayTypeConstIterator;
 
-    typedef Map<PointType::CoordinateType, DBoundingBox<1> > HullPointType;
+    /// m/z range of a single RT scan
+    typedef std::pair<PointType::CoordinateType, DBoundingBox<1> > HullScanType;
+    /// RT scans of the hull, sorted by ascending RT (unique RTs)
+    typedef std::vector<HullScanType> HullPointType;
 
     /// default constructor
     ConvexHull2D();
 
+    /// copy constructor
+    ConvexHull2D(const ConvexHull2D&) = default;
+
+    /// move constructor
+    ConvexHull2D(ConvexHull2D&&) = default;
+
     /// assignment operator
     ConvexHull2D& operator=(const ConvexHull2D& rhs);
 
+    /// move assignment operator
+    ConvexHull2D& operator=(ConvexHull2D&&) = default;
+
     /// equality operator
     bool operator==(const ConvexHull2D& rhs) const;
 
@@ -145,6 +162,9 @@ public:
     bool encloses(const PointType& point) const;
 
 protected:
+    /// returns the scan with RT @p rt or the position where it would have to be inserted
+    HullPointType::iterator findScan_(PointType::CoordinateType rt);
+
     /// internal structure maintaining the hull and enabling queries to encloses()
     HullPointType map_points_;
 
@@ -42,6 +42,12 @@
 #include <QtCore/QString>
 #include <boost/spirit/include/qi.hpp>
 
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -53,14 +59,154 @@ namespace OpenMS
   namespace StringConversions
   {
 
+    namespace Internal
+    {
+      /// Replaces the decimal separator of the current C locale (if it is not '.') in the first @p length characters of @p buffer by '.'
+      inline Size fixDecimalPoint_(char* buffer, Size length)
+      {
+        const char* dp = std::localeconv()->decimal_point;
+        if (dp[0] == '.' && dp[1] == '\0') return length;
+        char* pos = std::strstr(buffer, dp);
+        if (pos == nullptr) return length;
+        const Size dp_length = std::strlen(dp);
+        *pos = '.';
+        std::memmove(pos + 1, pos + dp_length, length - (pos - buffer) - dp_length + 1); // including the terminating zero
+        return length - dp_length + 1;
+      }
+
+      /**
+        @brief Writes @p f with @p precision significant digits to @p buffer (which must hold at least 32 characters).
+
+        The output is identical to writing @p f to a default-formatted std::ostream with the same precision,
+        but avoids constructing a stream. The decimal separator is always '.', independent of the C locale.
+
+        @return The number of characters written (excluding the terminating zero)
+      */
+      inline Size formatFloat(char* buffer, Size size, double f, int precision)
+      {
+        int length = std::snprintf(buffer, size, "%.*g", precision, f);
+        return fixDecimalPoint_(buffer, Size(length));
+      }
+
+      /// Overload of formatFloat() for long double
+      inline Size formatFloat(char* buffer, Size size, long double f, int precision)
+      {
+        int length = std::snprintf(buffer, size, "%.*Lg", precision, f);
+        return fixDecimalPoint_(buffer, Size(length));
+      }
+
+      inline float strToFloat_(const char* s, float)
+      {
+        return std::strtof(s, nullptr);
+      }
+
+      inline double strToFloat_(const char* s, double)
+      {
+        return std::strtod(s, nullptr);
+      }
+
+      inline long double strToFloat_(const char* s, long double)
+      {
+        return std::strtold(s, nullptr);
+      }
+
+      /**
+        @brief Parses the number in [@p begin, @p end) (with '.' as decimal separator) with correct rounding, independent of the C locale
+
+        Uses std::strtod() and friends, i.e. it is slower than the Spirit parsers. The range is not validated.
+      */
+      template <typename T>
+      inline T parseFloatExact(const char* begin, const char* end)
+      {
+        std::string s(begin, end);
+        const char* dp = std::localeconv()->decimal_point;
+        if (dp[0] != '.' || dp[1] != '\0')
+        {
+          std::string::size_type pos = s.find('.');
+          if (pos != std::string::npos) s.replace(pos, 1, dp);
+        }
+        return strToFloat_(s.c_str(), T());
+      }
+
+      /// Largest power of ten which is exactly representable as @p T
+      inline int maxExactPowerOf10_(float)
+      {
+        return 10;
+      }
+
+      inline int maxExactPowerOf10_(double)
+      {
+        return 22;
+      }
+
+      /**
+        @brief Is the number in [@p begin, @p end) parsed exactly (i.e. correctly rounded) by the Spirit real parser for type @p T?
+
+        Spirit accumulates the significant digits in @p T and scales them by a power of ten in one operation. This is exact
+        only if there are at most std::numeric_limits<T>::digits10 significant digits and the power of ten is exact as well.
+      */
+      template <typename T>
+      inline bool isParsedExactly(const char* begin, const char* end)
+      {
+        int digits(0), frac_digits(0), exponent(0);
+        bool in_fraction(false), in_exponent(false), exponent_negative(false), leading_zero(true);
+        for (; begin != end; ++begin)
+        {
+          const char c = *begin;
+          if (c >= '0' && c <= '9')
+          {
+            if (in_exponent)
+            {
+              if (exponent < 10000) exponent = exponent * 10 + (c - '0');
+            }
+            else
+            {
+              if (in_fraction) ++frac_digits;
+              if (c != '0' || !leading_zero)
+              {
+                leading_zero = false;
+                ++digits;
+              }
+            }
+          }
+          else if (c == '.') in_fraction = true;
+          else if (c == 'e' || c == 'E') in_exponent = true;
+          else if (c == '-' && in_exponent) exponent_negative = true;
+        }
+        if (exponent_negative) exponent = -exponent;
+        exponent -= frac_digits;
+        return digits <= std::numeric_limits<T>::digits10 && std::abs(exponent) <= maxExactPowerOf10_(T());
+      }
+    }
+
     /// toString functions (for floating point types)
     template <typename T>
     inline String floatToString(T f)
     {
-      std::stringstream s;
-      s.precision(writtenDigits(f));
-      s << f;
-      return s.str();
+      char buffer[32];
+      Size length = Internal::formatFloat(buffer, sizeof(buffer), f, writtenDigits(f));
+      return String(buffer, length);
+    }
+
+    /**
+      @brief Shortest representation of @p f which parses back to exactly the same value.
+
+      Starts with the precision of floatToString() (which gives short, "human" numbers like 88.99)
+      and only adds digits (up to std::numeric_limits<T>::max_digits10) where they are needed to restore @p f exactly.
+      Use this when writing values which are read again (e.g. by toDouble()) and must not lose precision.
+    */
+    template <typename T>
+    inline String floatToShortestString(T f)
+    {
+      char buffer[32];
+      Size length = Internal::formatFloat(buffer, sizeof(buffer), f, writtenDigits(f));
+      if (!std::isfinite(f)) return String(buffer, length);
+      for (int precision = writtenDigits(f) + 1; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+      {
+        if (Internal::parseFloatExact<T>(buffer, buffer + length) == f) break;
+        length = Internal::formatFloat(buffer, sizeof(buffer), f, precision);
+      }
+      return String(buffer, length);
     }
 
     /// toString functions (single argument)
@@ -90,6 +236,43 @@ namespace OpenMS
       return std::string(s);
     }
 
+    // integers: std::to_string() avoids constructing a stream and gives the same output
+    template <>
+    inline String toString(int i)
+    {
+      return std::to_string(i);
+    }
+
+    template <>
+    inline String toString(unsigned int i)
+    {
+      return std::to_string(i);
+    }
+
+    template <>
+    inline String toString(long int i)
+    {
+      return std::to_string(i);
+    }
+
+    template <>
+    inline String toString(long unsigned int i)
+    {
+      return std::to_string(i);
+    }
+
+    template <>
+    inline String toString(long long signed int i)
+    {
+      return std::to_string(i);
+    }
+
+    template <>
+    inline String toString(long long unsigned int i)
+    {
+      return std::to_string(i);
+    }
+
     template <>
     inline String toString(float f)
     {
@@ -707,6 +890,11 @@ public:
       {
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Prefix of string '") + this_s + "' successfully converted to a float value. Additional characters found at position " + (int)(distance(this_s.begin(), it) + 1));
       }
+      // Spirit is fast, but not correctly rounded for long numbers
+      if (!StringConversions::Internal::isParsedExactly<float>(this_s.c_str(), this_s.c_str() + this_s.size()))
+      {
+        ret = StringConversions::Internal::parseFloatExact<float>(this_s.c_str(), this_s.c_str() + this_s.size());
+      }
       return ret;
     }
 
@@ -725,10 +913,45 @@ public:
       {
         throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Prefix of string '") + this_s + "' successfully converted to a double value. Additional characters found at position " + (int)(distance(this_s.begin(), it) + 1));
       }
+      // Spirit is fast, but not correctly rounded for long numbers
+      if (!StringConversions::Internal::isParsedExactly<double>(this_s.c_str(), this_s.c_str() + this_s.size()))
+      {
+        ret = StringConversions::Internal::parseFloatExact<double>(this_s.c_str(), this_s.c_str() + this_s.size());
+      }
       return ret;
     }
 
 
+    /**
+      @brief Parses the character range [@p begin, @p end) as integer, without constructing a String.
+
+      Leading and trailing whitespace is skipped.
+
+      @return false if the range does not contain exactly one integer value (@p target is undefined then)
+    */
+    static bool toInt(const char* begin, const char* end, Int& target)
+    {
+      return boost::spirit::qi::phrase_parse(begin, end, boost::spirit::qi::int_, boost::spirit::ascii::space, target) && begin == end;
+    }
+
+    /// Parses the character range [@p begin, @p end) as float, without constructing a String (see toInt(const char*, const char*, Int&))
+    static bool toFloat(const char* begin, const char* end, float& target)
+    {
+      const char* start = begin;
+      if (!boost::spirit::qi::phrase_parse(begin, end, parse_float_, boost::spirit::ascii::space, target) || begin != end) return false;
+      if (!StringConversions::Internal::isParsedExactly<float>(start, end)) target = StringConversions::Internal::parseFloatExact<float>(start, end);
+      return true;
+    }
+
+    /// Parses the character range [@p begin, @p end) as double, without constructing a String (see toInt(const char*, const char*, Int&))
+    static bool toDouble(const char* begin, const char* end, double& target)
+    {
+      const char* start = begin;
+      if (!boost::spirit::qi::phrase_parse(begin, end, parse_double_, boost::spirit::ascii::space, target) || begin != end) return false;
+      if (!StringConversions::Internal::isParsedExactly<double>(start, end)) target = StringConversions::Internal::parseFloatExact<double>(start, end);
+      return true;
+    }
+
     static String& toUpper(String & this_s)
     {
       std::transform(this_s.begin(), this_s.end(), this_s.begin(), (int (*)(int))toupper);
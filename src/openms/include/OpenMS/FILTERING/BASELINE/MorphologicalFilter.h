@@ -37,6 +37,7 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
@@ -180,6 +181,14 @@ public:
       defaultsToParam_();
     }
 
+    /// Copy constructor (e.g. to create one filter per thread)
+    MorphologicalFilter(const MorphologicalFilter & source) :
+      ProgressLogger(source),
+      DefaultParamHandler(source),
+      struct_size_in_datapoints_(source.struct_size_in_datapoints_)
+    {
+    }
+
     /// Destructor
     ~MorphologicalFilter() override
     {
@@ -199,8 +208,8 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
+      // scratch buffer for the compound operations (local, so concurrent calls are safe)
+      std::vector<typename InputIterator::value_type> buffer;
       const UInt size = input_end - input_begin;
 
       //determine the struct size in data points if not already set
@@ -327,11 +336,9 @@ public:
     void filterExperiment(PeakMap & exp)
     {
       startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
-      {
-        filter(exp[i]);
-        setProgress(i);
-      }
+      // the structuring element size is stored per filter, so each thread uses its own copy
+      ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                    [](MorphologicalFilter& f, MSSpectrum& s) { f.filter(s); }, this);
       endProgress();
     }
 
@@ -351,8 +358,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -451,8 +457,7 @@ protected:
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -576,11 +581,6 @@ protected:
       return;
     }
 
-private:
-
-    /// copy constructor not implemented
-    MorphologicalFilter(const MorphologicalFilter & source);
-
   };
 
 } // namespace OpenMS
@@ -68,6 +68,7 @@ namespace OpenMS
     The filter functions for vectors of peptide/protein IDs do not include clean-up steps (e.g. removal of IDs without hits, reassignment of hit ranks, ...).
     They only carry out their specific filtering operations.
     This is so filters can be chained without having to repeat clean-up operations.
+    Filters that work on the hit level process the IDs of a vector in parallel (if OpenMP is enabled); the predicates used there must therefore not modify shared state.
     The group of clean-up functions provides helpers that are useful to ensure data integrity after filters have been applied, but it is up to the individual developer to use them when necessary.
 
     The filter functions for MS/MS experiments do include clean-up steps, because they filter peptide and protein IDs in conjunction and potential contradictions between the two must be eliminated.
@@ -635,10 +636,12 @@ public:
     template <class IdentificationType>
     static void updateHitRanks(std::vector<IdentificationType>& ids)
     {
-      for (typename std::vector<IdentificationType>::iterator it = ids.begin();
-           it != ids.end(); ++it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        it->assignRanks();
+        ids[i].assignRanks();
       }
     }
 
@@ -694,12 +697,14 @@ public:
     static void filterHitsByScore(std::vector<IdentificationType>& ids,
                                   double threshold_score)
     {
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
         struct HasGoodScore<typename IdentificationType::HitType> score_filter(
-          threshold_score, id_it->isHigherScoreBetter());
-        keepMatchingItems(id_it->getHits(), score_filter);
+          threshold_score, ids[i].isHigherScoreBetter());
+        keepMatchingItems(ids[i].getHits(), score_filter);
       }
     }
 
@@ -712,14 +717,16 @@ public:
     static void filterHitsBySignificance(std::vector<IdentificationType>& ids,
                                          double threshold_fraction = 1.0)
     {
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
         double threshold_score = (threshold_fraction *
-                                  id_it->getSignificanceThreshold());
+                                  ids[i].getSignificanceThreshold());
         struct HasGoodScore<typename IdentificationType::HitType> score_filter(
-          threshold_score, id_it->isHigherScoreBetter());
-        keepMatchingItems(id_it->getHits(), score_filter);
+          threshold_score, ids[i].isHigherScoreBetter());
+        keepMatchingItems(ids[i].getHits(), score_filter);
       }
     }
 
@@ -731,11 +738,13 @@ public:
     template <class IdentificationType>
     static void keepNBestHits(std::vector<IdentificationType>& ids, Size n)
     {
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        id_it->sort();
-        if (n < id_it->getHits().size()) id_it->getHits().resize(n);
+        ids[i].sort();
+        if (n < ids[i].getHits().size()) ids[i].getHits().resize(n);
       }
     }
 
@@ -762,20 +771,24 @@ public:
       {
         struct HasMaxRank<typename IdentificationType::HitType>
           rank_filter(min_rank - 1);
-        for (typename std::vector<IdentificationType>::iterator id_it =
-               ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
         {
-          removeMatchingItems(id_it->getHits(), rank_filter);
+          removeMatchingItems(ids[i].getHits(), rank_filter);
         }
       }
       if (max_rank >= min_rank)
       {
         struct HasMaxRank<typename IdentificationType::HitType>
           rank_filter(max_rank);
-        for (typename std::vector<IdentificationType>::iterator id_it =
-               ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
         {
-          keepMatchingItems(id_it->getHits(), rank_filter);
+          keepMatchingItems(ids[i].getHits(), rank_filter);
         }
       }
     }
@@ -792,10 +805,12 @@ public:
     {
       struct HasDecoyAnnotation<typename IdentificationType::HitType>
         decoy_filter;
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        removeMatchingItems(id_it->getHits(), decoy_filter);
+        removeMatchingItems(ids[i].getHits(), decoy_filter);
       }
     }
 
@@ -812,10 +827,12 @@ public:
     {
       struct HasMatchingAccession<typename IdentificationType::HitType>
         acc_filter(accessions);
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        removeMatchingItems(id_it->getHits(), acc_filter);
+        removeMatchingItems(ids[i].getHits(), acc_filter);
       }
     }
 
@@ -832,10 +849,12 @@ public:
     {
       struct HasMatchingAccession<typename IdentificationType::HitType>
         acc_filter(accessions);
-      for (typename std::vector<IdentificationType>::iterator id_it =
-             ids.begin(); id_it != ids.end(); ++id_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
-        keepMatchingItems(id_it->getHits(), acc_filter);
+        keepMatchingItems(ids[i].getHits(), acc_filter);
       }
     }
 
@@ -38,6 +38,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilterAlgorithm.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -192,18 +193,12 @@ public:
     */
     void filterExperiment(PeakMap & map)
     {
-      Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
+      // spectra and chromatograms are smoothed independently (one filter copy per thread)
+      ParallelSpectrumFilter::apply(map.getSpectra(), *this,
+                                    [](GaussFilter& f, MSSpectrum& s) { f.filter(s); }, this);
+      ParallelSpectrumFilter::apply(map.getChromatograms(), *this,
+                                    [](GaussFilter& f, MSChromatogram& c) { f.filter(c); }, this, map.size());
       endProgress();
     }
 
@@ -36,6 +36,7 @@
 
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
@@ -213,18 +214,12 @@ public:
     */
     void filterExperiment(PeakMap & map)
     {
-      Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
+      // spectra and chromatograms are smoothed independently (one filter copy per thread)
+      ParallelSpectrumFilter::apply(map.getSpectra(), *this,
+                                    [](SavitzkyGolayFilter& f, MSSpectrum& s) { f.filter(s); }, this);
+      ParallelSpectrumFilter::apply(map.getChromatograms(), *this,
+                                    [](SavitzkyGolayFilter& f, MSChromatogram& c) { f.filter(c); }, this, map.size());
       endProgress();
     }
 
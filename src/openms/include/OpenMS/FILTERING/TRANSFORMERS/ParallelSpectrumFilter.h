@@ -0,0 +1,119 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+//
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
+
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMS
+{
+  /**
+    @brief Applies a filter to each spectrum (or chromatogram) of a container in parallel.
+
+    Every thread works on its own copy of the filter. Filters that keep state while
+    processing a single spectrum (cached parameters, scratch buffers, pre-computed kernels, ...)
+    can therefore be used without locking. Spectra are processed independently of each other,
+    so the result is identical to a serial loop over the container.
+
+    The operation is any callable taking the (thread-local) filter and one element, e.g.:
+    @code
+    NLargest filter;
+    ParallelSpectrumFilter::apply(exp.getSpectra(), filter,
+                                  [](NLargest& f, MSSpectrum& s) { f.filterSpectrum(s); });
+    @endcode
+
+    The first exception thrown by the operation is re-thrown once all threads have finished.
+
+    @ingroup SpectraPreprocessers
+  */
+  class ParallelSpectrumFilter
+  {
+public:
+    /**
+      @brief Applies @p operation to every element of @p data, using one copy of @p filter per thread
+
+      @param data Spectra or chromatograms to process (in-place)
+      @param filter The filter (it is copied for each thread, i.e. left unchanged)
+      @param operation Callable with signature void(FilterType&, ContainerType::value_type&)
+      @param progress_logger If given, progress is reported (by the master thread) to this logger, starting at @p progress_offset
+      @param progress_offset Progress value corresponding to the first element of @p data
+    */
+    template <typename ContainerType, typename FilterType, typename OperationType>
+    static void apply(ContainerType& data, const FilterType& filter, OperationType operation,
+                      const ProgressLogger* progress_logger = nullptr, Size progress_offset = 0)
+    {
+      Size progress = 0;
+      ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        FilterType local_filter(filter);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 10)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)data.size(); ++i)
+        {
+          try
+          {
+            operation(local_filter, data[i]);
+          }
+          catch (...)
+          {
+            exceptions.capture();
+          }
+          if (progress_logger != nullptr)
+          {
+            IF_MASTERTHREAD progress_logger->setProgress(progress_offset + progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            ++progress;
+          }
+        }
+      }
+      exceptions.rethrow();
+    }
+  };
+
+} // namespace OpenMS
+
@@ -18,6 +18,7 @@ NLargest.h
 NeutralLossDiffFilter.h
 NeutralLossMarker.h
 Normalizer.h
+ParallelSpectrumFilter.h
 ParentPeakMower.h
 PeakMarker.h
 Scaler.h
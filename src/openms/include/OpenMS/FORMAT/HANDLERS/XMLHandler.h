@@ -140,6 +140,24 @@ public:
       */
       static void appendASCII(const XMLCh * str, const XMLSize_t length, String & result);
 
+      /**
+       * @brief Widens the ASCII C string @p str into @p buffer (null-terminated) without allocating memory
+       *
+       * @return false if @p str (including the terminating null) does not fit into @p buffer_size characters
+      */
+      static bool widenASCII(const char * str, XMLCh * buffer, const Size buffer_size);
+
+      /**
+       * @brief Narrows the null-terminated XMLCh* @p str into @p buffer without allocating memory
+       *
+       * @return Pointer past the last written character, or nullptr if @p str
+       * does not fit into @p buffer_size characters or contains non-ASCII characters
+      */
+      static char * narrowASCII(const XMLCh * str, char * buffer, const Size buffer_size);
+
+      /// Buffer size (in characters) used for allocation-free transcoding of short strings, e.g. attribute names and numbers
+      static const Size ASCII_BUFFER_SIZE = 64;
+
     };
 
     /**
@@ -331,6 +349,14 @@ protected:
         return xercesc::XMLString::parseInt(in);
       }
 
+      /// Conversion of a Xerces string to a double value (short values are parsed without a transient String)
+      inline double asDouble_(const XMLCh * in)
+      {
+        double res;
+        if (parseASCII_(in, res)) return res;
+        return asDouble_(sm_.convert(in));
+      }
+
       /// Conversion of a String to an unsigned integer value
       inline UInt asUInt_(const String & in)
       {
@@ -431,10 +457,33 @@ protected:
       ///@name Accessing attributes
       //@{
 
+      /// Returns the value of the attribute @p name (or nullptr if not present); short names are transcoded without allocation
+      inline const XMLCh * getAttributeValue_(const xercesc::Attributes & a, const char * name) const
+      {
+        XMLCh buffer[StringManager::ASCII_BUFFER_SIZE];
+        if (StringManager::widenASCII(name, buffer, StringManager::ASCII_BUFFER_SIZE)) return a.getValue(buffer);
+        return a.getValue(sm_.convert(name).c_str());
+      }
+
+      /// Converts the attribute value @p val to a double (throws Exception::ConversionError on failure)
+      inline double xercesToDouble_(const XMLCh * val) const
+      {
+        double res;
+        if (parseASCII_(val, res)) return res;
+        return String(sm_.convert(val)).toDouble();
+      }
+
+      /**
+        @brief Parses @p in as double without allocating memory
+
+        @return false if @p in is too long, not ASCII or not a number (use the String based conversion then, which reports the error)
+      */
+      static bool parseASCII_(const XMLCh * in, double & value);
+
       /// Converts an attribute to a String
       inline String attributeAsString_(const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
         return sm_.convert(val);
       }
@@ -442,7 +491,7 @@ protected:
       /// Converts an attribute to a Int
       inline Int attributeAsInt_(const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
         return xercesc::XMLString::parseInt(val);
       }
@@ -450,9 +499,9 @@ protected:
       /// Converts an attribute to a double
       inline double attributeAsDouble_(const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + name + "' not present!");
-        return String(sm_.convert(val)).toDouble();
+        return xercesToDouble_(val);
       }
 
       /// Converts an attribute to a DoubleList
@@ -483,7 +532,7 @@ protected:
       */
       inline bool optionalAttributeAsString_(String & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
           value = sm_.convert(val);
@@ -499,7 +548,7 @@ protected:
       */
       inline bool optionalAttributeAsInt_(Int & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
           value = xercesc::XMLString::parseInt(val);
@@ -515,7 +564,7 @@ protected:
       */
       inline bool optionalAttributeAsUInt_(UInt & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
           value = xercesc::XMLString::parseInt(val);
@@ -531,10 +580,10 @@ protected:
       */
       inline bool optionalAttributeAsDouble_(double & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
-          value = String(sm_.convert(val)).toDouble();
+          value = xercesToDouble_(val);
           return true;
         }
         return false;
@@ -547,7 +596,7 @@ protected:
       */
       inline bool optionalAttributeAsDoubleList_(DoubleList & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
           value = attributeAsDoubleList_(a, name);
@@ -563,7 +612,7 @@ protected:
       */
       inline bool optionalAttributeAsStringList_(StringList & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
           value = attributeAsStringList_(a, name);
@@ -579,7 +628,7 @@ protected:
       */
       inline bool optionalAttributeAsIntList_(IntList & value, const xercesc::Attributes & a, const char * name) const
       {
-        const XMLCh * val = a.getValue(sm_.convert(name).c_str());
+        const XMLCh * val = getAttributeValue_(a, name);
         if (val != nullptr)
         {
           value = attributeAsIntList_(a, name);
@@ -609,7 +658,7 @@ protected:
       {
         const XMLCh * val = a.getValue(name);
         if (val == nullptr) fatalError(LOAD, String("Required attribute '") + sm_.convert(name) + "' not present!");
-        return String(sm_.convert(val)).toDouble();
+        return xercesToDouble_(val);
       }
 
       /// Converts an attribute to a DoubleList
@@ -679,7 +728,7 @@ protected:
         const XMLCh * val = a.getValue(name);
         if (val != nullptr)
         {
-          value = String(sm_.convert(val)).toDouble();
+          value = xercesToDouble_(val);
           return true;
         }
         return false;
@@ -42,6 +42,8 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/OpenMSConfig.h>
 
+#include <boost/container/flat_set.hpp>
+
 #include <set>
 
 namespace OpenMS
@@ -62,6 +64,13 @@ namespace OpenMS
     FeatureHandle instances.  Each ConsensusFeature "contains" zero or more
     FeatureHandles.
 
+    The handles are kept in a sorted, contiguous container (ordered by
+    FeatureHandle::IndexLess, i.e. by map index and then unique id). Iteration
+    order and uniqueness are the same as for a std::set, but memory use is
+    much lower and traversal is cache friendly. Note that inserting into or
+    erasing from the middle invalidates iterators; appending handles in
+    IndexLess order is amortized constant time.
+
     @see ConsensusMap
 
     @ingroup Kernel
@@ -72,7 +81,7 @@ namespace OpenMS
 public:
     ///Type definitions
     //@{
-    typedef std::set<FeatureHandle, FeatureHandle::IndexLess> HandleSetType;
+    typedef boost::container::flat_set<FeatureHandle, FeatureHandle::IndexLess> HandleSetType;
     typedef HandleSetType::const_iterator const_iterator;
     typedef HandleSetType::iterator iterator;
     typedef HandleSetType::const_reverse_iterator const_reverse_iterator;
@@ -39,6 +39,7 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
 
 namespace OpenMS
 {
@@ -107,6 +108,21 @@ public:
     /// Access the picked (centroided) experiment
     const SimTypes::MSSimExperiment& getPeakMap() const;
 
+    /**
+      @brief Passes the simulated spectra one by one to @p consumer (e.g. a PlainMSDataWritingConsumer)
+
+      The peaks of each spectrum are released as soon as it was consumed, so memory
+      is returned while writing. This does not lower the peak memory of the
+      simulation, which holds the complete map before anything is consumed.
+      The spectrum meta data (RT, precursors, meta values) is kept, i.e.
+      getIdentifications() still works afterwards, but getExperiment() only
+      holds empty spectra.
+    */
+    void consumeExperiment(Interfaces::IMSDataConsumer& consumer);
+
+    /// Like consumeExperiment(), for the picked (centroided) experiment
+    void consumePeakMap(Interfaces::IMSDataConsumer& consumer);
+
     /**
       @brief Access the simulated identifications (proteins and peptides)
 
@@ -149,6 +165,9 @@ protected:
     /// Synchronize members with param class
     void updateMembers_() override;
 
+    /// passes the spectra of @p experiment to @p consumer and releases their peaks
+    void consumeAndRelease_(SimTypes::MSSimExperiment& experiment, Interfaces::IMSDataConsumer& consumer);
+
 private:
     /// Holds the simulated data
     SimTypes::MSSimExperiment experiment_;
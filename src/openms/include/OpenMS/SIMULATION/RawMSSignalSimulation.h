@@ -53,6 +53,13 @@ namespace OpenMS
    Simulates MS signals for a given set of peptides, with charge annotation,
    given detectabilities, predicted retention times and charge values.
 
+   For LC/MS data the signals of the features are sampled in parallel (if
+   OpenMP is enabled). Every feature draws its technical noise from its own
+   random number stream, seeded from the technical random number generator in
+   feature order. The features are processed in blocks of fixed size, after
+   which the map is compressed, and peaks are summed in a fixed order, so the
+   simulated data does not depend on the number of threads.
+
    @htmlinclude OpenMS_RawMSSignalSimulation.parameters
 
    @ingroup Simulation
@@ -119,8 +126,9 @@ protected:
      @param feature The feature which should be simulated
      @param experiment The experiment to which the simulated signals should be added
      @param experiment_ct Ground truth for picked peaks
+     @param rng Random number generator for the technical noise of this feature
      */
-    void add2DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct);
+    void add2DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, boost::random::mt19937_64& rng);
 
     /**
      @brief Samples signals for the given 1D model
@@ -150,6 +158,7 @@ protected:
      @param experiment Experiment to which the sampled signals will be added
      @param experiment_ct Experiment to which the centroided Ground Truth sampled signals will be added
      @param activeFeature The current feature that is simulated
+     @param rng Random number generator for the m/z error
      */
     void samplePeptideModel2D_(const ProductModel<2>& pm,
                                const SimTypes::SimCoordinateType mz_start,
@@ -158,7 +167,8 @@ protected:
                                SimTypes::SimCoordinateType rt_end,
                                SimTypes::MSSimExperiment& experiment,
                                SimTypes::MSSimExperiment& experiment_ct,
-                               Feature& activeFeature);
+                               Feature& activeFeature,
+                               boost::random::mt19937_64& rng);
 
     /**
      @brief Add the correct Elution profile to the passed ProductModel
@@ -195,6 +205,9 @@ protected:
     /// Compress signals in a single RT scan (to merge signals which were sampled overlapping)
     void compressSignals_(SimTypes::MSSimExperiment& experiment);
 
+    /// Sorts the peaks of @p spectrum by m/z and, for equal m/z, by intensity (i.e. independent of their original order)
+    static void sortByPositionAndIntensity_(SimTypes::MSSimExperiment::SpectrumType& spectrum);
+
     /// number of points sampled per peak's FWHM
     Int sampling_points_per_FWHM_;
 
@@ -208,11 +221,13 @@ protected:
      *
      * @param feature_intensity Intensity of the current feature.
      * @param natural_scaling_factor Additional scaling factor used by some of the sampling models.
+     * @param rng Random number generator for the intensity variation.
      *
      * @return Rescaled feature intensity.
      */
     SimTypes::SimIntensityType getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity,
-                                                          const SimTypes::SimIntensityType natural_scaling_factor);
+                                                          const SimTypes::SimIntensityType natural_scaling_factor,
+                                                          boost::random::mt19937_64& rng);
 
 
     /**
@@ -261,19 +276,6 @@ protected:
 
     std::vector<ContaminantInfo> contaminants_;
 
-    /**
-    @p threaded_random_numbers keeps a set of random numbers for each thread simulating a feature.
-      */
-    std::vector<std::vector<double> > threaded_random_numbers_;
-
-    /**
-      Indicates which random numbers each thread has used already and if the random number pool
-      should be rebuild.
-      */
-    std::vector<Size> threaded_random_numbers_index_;
-
-    static const Size THREADED_RANDOM_NUMBER_POOL_SIZE_ = 500;
-
     bool contaminants_loaded_;
   };
 
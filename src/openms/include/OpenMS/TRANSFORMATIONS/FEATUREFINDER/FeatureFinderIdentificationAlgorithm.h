@@ -77,6 +77,10 @@ public:
   PeakMap& getChromatograms() { return chrom_data_; }
   const PeakMap& getChromatograms() const { return chrom_data_; }
 
+  /// Keep the extracted chromatograms (see getChromatograms()) after feature detection? (default: true)
+  /// If not, only the chromatograms of the batches being processed are held in memory.
+  void setKeepChromatograms(bool keep) { keep_chromatograms_ = keep; }
+
   ProgressLogger& getProgressLogger() { return prog_log_; }
   const ProgressLogger& getProgressLogger() const { return prog_log_; }
 
@@ -109,6 +113,7 @@ protected:
 
   double isotope_pmin_; //< min. isotope probability for peptide assay
   Size n_isotopes_; //< number of isotopes for peptide assay
+  Size batch_size_; //< number of assays per chromatogram extraction batch
 
   double rt_quantile_;
 
@@ -197,6 +202,7 @@ protected:
 
   PeakMap ms_data_; //< input LC-MS data
   PeakMap chrom_data_; //< accumulated chromatograms (XICs)
+  bool keep_chromatograms_; //< keep chromatograms after feature detection?
   TargetedExperiment library_; //< accumulated assays for peptides
 
   /// SVM probability -> number of pos./neg. features (for FDR calculation):
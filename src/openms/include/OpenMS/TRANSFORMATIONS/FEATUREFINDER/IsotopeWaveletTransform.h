@@ -232,6 +232,20 @@ protected:
         * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform. */
     virtual void getTransformHighRes(MSSpectrum& c_trans, const MSSpectrum& c_ref, const UInt c);
 
+    /** @brief Computes the isotope wavelet transform of charge state @p c on plain m/z and intensity arrays.
+        *
+        * This is the convolution kernel behind getTransform() and getTransformHighRes(). It does not touch any member
+        * and may therefore be called concurrently for different scans and charge states.
+        * @param trans The transform (resized to the length of @p mz).
+        * @param mz The m/z values of the reference spectrum (sorted ascendingly).
+        * @param intens The intensities of the reference spectrum.
+        * @param c The charge state minus 1 (e.g. c=2 means charge state 3) at which you want to compute the transform.
+        * @param from_max_to_left The number of data points left of the wavelet's maximum (as set by initializeScan()).
+        * @param min_spacing The minimal m/z spacing of the reference spectrum (as computed by computeMinSpacing()).
+        * @param hr_data Plain summation (high resolution data) instead of trapezoidal integration (low resolution data). */
+    static void computeTransform(std::vector<double>& trans, const std::vector<double>& mz, const std::vector<double>& intens,
+                                 const UInt c, const Int from_max_to_left, const double min_spacing, const bool hr_data);
+
     /** @brief Given an isotope wavelet transformed spectrum @p candidates, this function assigns to every significant
         * pattern its corresponding charge state and a score indicating the reliability of the prediction. The result of this
         * process is stored internally. Important: Before calling this function, apply updateRanges() to the original map.
@@ -562,81 +576,98 @@ protected:
   template <typename PeakType>
   void IsotopeWaveletTransform<PeakType>::getTransform(MSSpectrum& c_trans, const MSSpectrum& c_ref, const UInt c)
   {
-    Int spec_size((Int)c_ref.size());
-    //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
-    //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
-    UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
-
-    for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
+    std::vector<double> mz(c_ref.size()), intens(c_ref.size()), trans;
+    for (Size k = 0; k < c_ref.size(); ++k)
     {
-      value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
-      old = 0; old_pos = (my_local_pos - from_max_to_left_ - 1 >= 0) ? c_ref[my_local_pos - from_max_to_left_ - 1].getMZ() : c_ref[0].getMZ() - min_spacing_;
-      my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
-      c_diff = 0;
-      origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
-
-      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
-      {
-        if (current_conv_pos >= spec_size)
-        {
-          value += 0.5 * old * min_spacing_;
-          break;
-        }
-
-        c_mz = c_ref[current_conv_pos].getMZ();
-        c_diff = c_mz + origin;
-
-        //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
-        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
+      mz[k] = c_ref[k].getMZ();
+      intens[k] = c_ref[k].getIntensity();
+    }
 
-        value += 0.5 * (current + old) * (c_mz - old_pos);
+    computeTransform(trans, mz, intens, c, from_max_to_left_, min_spacing_, false);
 
-        old = current;
-        old_pos = c_mz;
-      }
+    for (Size k = 0; k < trans.size(); ++k)
+    {
+      c_trans[k].setIntensity(trans[k]);
+    }
+  }
 
+  template <typename PeakType>
+  void IsotopeWaveletTransform<PeakType>::getTransformHighRes(MSSpectrum& c_trans, const MSSpectrum& c_ref, const UInt c)
+  {
+    std::vector<double> mz(c_ref.size()), intens(c_ref.size()), trans;
+    for (Size k = 0; k < c_ref.size(); ++k)
+    {
+      mz[k] = c_ref[k].getMZ();
+      intens[k] = c_ref[k].getIntensity();
+    }
 
+    computeTransform(trans, mz, intens, c, from_max_to_left_, min_spacing_, true);
 
-      c_trans[my_local_pos].setIntensity(value);
+    for (Size k = 0; k < trans.size(); ++k)
+    {
+      c_trans[k].setIntensity(trans[k]);
     }
   }
 
   template <typename PeakType>
-  void IsotopeWaveletTransform<PeakType>::getTransformHighRes(MSSpectrum& c_trans, const MSSpectrum& c_ref, const UInt c)
+  void IsotopeWaveletTransform<PeakType>::computeTransform(std::vector<double>& trans, const std::vector<double>& mz, const std::vector<double>& intens,
+                                                           const UInt c, const Int from_max_to_left, const double min_spacing, const bool hr_data)
   {
-    Int spec_size((Int)c_ref.size());
+    Int spec_size((Int)mz.size());
     //in the very unlikely case that size_t will not fit to int anymore this will be a problem of course
     //for the sake of simplicity (we need here a signed int) we do not cast at every following comparison individually
+    trans.assign(spec_size, 0);
+    if (spec_size == 0)
+    {
+      return;
+    }
+
+    //work on the raw arrays, s.t. the inner convolution runs over contiguous memory
+    const double* mz_ptr = &mz[0];
+    const double* intens_ptr = &intens[0];
     UInt charge = c + 1;
-    double value, T_boundary_left, T_boundary_right, c_diff, current, my_local_MZ, my_local_lambda, origin, c_mz;
+    double value, T_boundary_left, T_boundary_right, old, c_diff, current, old_pos, my_local_MZ, my_local_lambda, origin, c_mz;
 
     for (Int my_local_pos = 0; my_local_pos < spec_size; ++my_local_pos)
     {
-      value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(c_ref[my_local_pos].getMZ(), charge) / (double)charge;
-
-
-      my_local_MZ = c_ref[my_local_pos].getMZ(); my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
+      my_local_MZ = mz_ptr[my_local_pos];
+      value = 0; T_boundary_left = 0, T_boundary_right = IsotopeWavelet::getMzPeakCutOffAtMonoPos(my_local_MZ, charge) / (double)charge;
+      old = 0; old_pos = (my_local_pos - from_max_to_left - 1 >= 0) ? mz_ptr[my_local_pos - from_max_to_left - 1] : mz_ptr[0] - min_spacing;
+      my_local_lambda = IsotopeWavelet::getLambdaL(my_local_MZ * charge);
       c_diff = 0;
       origin = -my_local_MZ + Constants::IW_QUARTER_NEUTRON_MASS / (double)charge;
 
-      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left_); c_diff < T_boundary_right; ++current_conv_pos)
+      for (Int current_conv_pos =  std::max(0, my_local_pos - from_max_to_left); c_diff < T_boundary_right; ++current_conv_pos)
       {
         if (current_conv_pos >= spec_size)
         {
+          if (!hr_data)
+          {
+            value += 0.5 * old * min_spacing;
+          }
           break;
         }
 
-        c_mz = c_ref[current_conv_pos].getMZ();
+        c_mz = mz_ptr[current_conv_pos];
         c_diff = c_mz + origin;
 
         //Attention! The +1. has nothing to do with the charge, it is caused by the wavelet's formula (tz1).
-        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * c_ref[current_conv_pos].getIntensity() : 0;
+        current = c_diff > T_boundary_left && c_diff <= T_boundary_right ? IsotopeWavelet::getValueByLambda(my_local_lambda, c_diff * charge + 1.) * intens_ptr[current_conv_pos] : 0;
+
+        if (hr_data)
+        {
+          value += current;
+        }
+        else
+        {
+          value += 0.5 * (current + old) * (c_mz - old_pos);
+        }
 
-        value += current;
+        old = current;
+        old_pos = c_mz;
       }
 
-      c_trans[my_local_pos].setIntensity(value);
+      trans[my_local_pos] = value;
     }
   }
 
@@ -1723,19 +1754,30 @@ protected:
   FeatureMap IsotopeWaveletTransform<PeakType>::mapSeeds2Features(const PeakMap& map, const UInt RT_votes_cutoff)
   {
     FeatureMap feature_map;
-    typename std::multimap<double, Box>::iterator iter;
-    typename Box::iterator box_iter;
-    UInt best_charge_index; double best_charge_score, c_mz, c_RT; UInt c_charge;
-    double av_intens = 0, av_ref_intens = 0, av_score = 0, av_mz = 0, av_RT = 0, mz_cutoff, sum_of_ref_intenses_g;
-    bool restart = false;
 
-    typename std::pair<double, double> c_extend;
-    for (iter = closed_boxes_.begin(); iter != closed_boxes_.end(); ++iter)
+    //Every closed box is mapped independently of all others, hence we evaluate them in parallel and
+    //collect the resulting features afterwards in the order of the boxes
+    std::vector<Box*> boxes;
+    boxes.reserve(closed_boxes_.size());
+    for (typename std::multimap<double, Box>::iterator iter = closed_boxes_.begin(); iter != closed_boxes_.end(); ++iter)
     {
-      sum_of_ref_intenses_g = 0;
-      Box& c_box = iter->second;
+      boxes.push_back(&(iter->second));
+    }
+    std::vector<Feature> features(boxes.size());
+    std::vector<char> accepted(boxes.size(), 0); //no std::vector<bool>, since it is written concurrently
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (SignedSize b = 0; b < (SignedSize)boxes.size(); ++b)
+    {
+      typename Box::iterator box_iter;
+      UInt best_charge_index; double best_charge_score, c_mz, c_RT; UInt c_charge;
+      double av_intens = 0, av_ref_intens = 0, av_score = 0, av_mz = 0, av_RT = 0, mz_cutoff, sum_of_ref_intenses_g = 0;
+      bool restart = false;
+
+      Box& c_box = *boxes[b];
       std::vector<double> charge_votes(max_charge_, 0), charge_binary_votes(max_charge_, 0);
-      restart = false;
 
       //Let's first determine the charge
       //Therefor, we can use two types of votes: qualitative ones (charge_binary_votes) or quantitative ones (charge_votes)
@@ -1896,7 +1938,16 @@ protected:
       c_feature.setIntensity(av_intens);
       c_feature.setRT(av_RT);
       c_feature.setOverallQuality(av_score);
-      feature_map.push_back(c_feature);
+      features[b] = c_feature;
+      accepted[b] = 1;
+    }
+
+    for (Size b = 0; b < boxes.size(); ++b)
+    {
+      if (accepted[b])
+      {
+        feature_map.push_back(features[b]);
+      }
     }
 
     return feature_map;
@@ -111,6 +111,35 @@ public:
     MSExperiment& getCentroidedExperiment();
 
 protected:
+    /**
+     * @brief peak of the white experiment which passed filterPeakPositions_()
+     *
+     * The filter() methods collect these candidates for all spectra in parallel,
+     * before accepting them in the original order.
+     */
+    struct FilteredCandidate_
+    {
+      FilteredCandidate_(size_t mz_idx_white, const MultiplexFilteredPeak& filtered_peak) :
+        mz_idx(mz_idx_white), peak(filtered_peak), passed(false)
+      {
+      }
+
+      /**
+       * @brief index of the peak in its white spectrum
+       */
+      size_t mz_idx;
+
+      /**
+       * @brief peak with set of satellite peaks (and satellite data points in profile mode)
+       */
+      MultiplexFilteredPeak peak;
+
+      /**
+       * @brief boolean if the peak passed all remaining filters
+       */
+      bool passed;
+    };
+
     /**
      * @brief construct an MS experiment from exp_centroided_ containing
      * peaks which have not been previously blacklisted in blacklist_
@@ -149,6 +178,22 @@ protected:
      */
     bool filterPeakPositions_(const MSSpectrum::ConstIterator& it_mz, const MSExperiment::ConstIterator& it_rt_begin, const MSExperiment::ConstIterator& it_rt_band_begin, const MSExperiment::ConstIterator& it_rt_band_end, const MultiplexIsotopicPeakPattern& pattern, MultiplexFilteredPeak& peak) const;
 
+    /**
+     * @brief check if the blacklist still admits the peak and all its satellites
+     *
+     * The filter() methods first filter all peaks of the white experiment in parallel,
+     * i.e. against the blacklist as it was at the start of the current pattern. They
+     * then accept the peaks one by one in the original order, blacklisting each accepted
+     * peak. A peak still admitted by the (now extended) blacklist would pass
+     * filterPeakPositions_() with exactly the same satellites again, and hence needs no
+     * re-filtering.
+     *
+     * @param peak    peak with set of satellite peaks (as returned by filterPeakPositions_())
+     *
+     * @return boolean if neither the peak nor any of its satellites were blacklisted for a different mass trace
+     */
+    bool checkBlacklist_(const MultiplexFilteredPeak& peak) const;
+
     /**
      * @brief blacklist this peak
      * 
@@ -92,6 +92,18 @@ public:
      */
     std::vector<MultiplexFilteredMSExperiment> filter();
 
+private:
+    /**
+     * @brief filter a single peak of the white experiment
+     *
+     * @param pattern    m/z pattern to search for
+     * @param idx_rt    index of the spectrum in <exp_centroided_white_>
+     * @param candidate    freshly constructed candidate of the peak, filter result output
+     *
+     * @return boolean if filterPeakPositions_() was passed (<candidate.passed> reports the remaining filters)
+     */
+    bool filterPeak_(const MultiplexIsotopicPeakPattern& pattern, size_t idx_rt, FilteredCandidate_& candidate) const;
+
   };
 
 }
@@ -110,6 +110,21 @@ public:
     std::vector<std::vector<PeakPickerHiRes::PeakBoundary> >& getPeakBoundaries();
 
 private:
+    /**
+     * @brief filter a single peak of the white experiment
+     *
+     * Scans the spline interpolated profile data from peak boundary to peak boundary.
+     * Satellite data points which pass all filters are added to the peak.
+     *
+     * @param pattern    m/z pattern to search for
+     * @param idx_rt    index of the spectrum in <exp_centroided_white_>
+     * @param navigators    navigators of the spline interpolated spectra (not shared between threads, since they cache their position)
+     * @param candidate    freshly constructed candidate of the peak, filter result output
+     *
+     * @return boolean if filterPeakPositions_() was passed (<candidate.passed> reports the remaining filters)
+     */
+    bool filterPeak_(const MultiplexIsotopicPeakPattern& pattern, size_t idx_rt, std::vector<SplineInterpolatedPeaks::Navigator>& navigators, FilteredCandidate_& candidate) const;
+
     /**
      * @brief averagine filter for profile mode
      *
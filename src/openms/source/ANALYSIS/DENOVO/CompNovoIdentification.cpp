@@ -39,6 +39,7 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIonScoring.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 //#define DAC_DEBUG
 //#define ESTIMATE_PRECURSOR_DEBUG
@@ -79,47 +80,78 @@ namespace OpenMS
 
   void CompNovoIdentification::getIdentifications(vector<PeptideIdentification> & pep_ids, const PeakMap & exp)
   {
-    Size count(1);
-    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it, ++count)
+    // pair each CID spectrum with the ETD spectrum of the same precursor
+    // following it, sequencing of the pairs is independent
+    vector<pair<Size, Size> > cid_etd_pairs;
+    for (Size i = 0; i < exp.size(); ++i)
     {
-      //cerr << count << "/" << exp.size() / 2 << endl;
-
-      PeptideIdentification id;
-      PeakSpectrum CID_spec(*it);
-      double cid_rt(it->getRT());
+      const PeakSpectrum & CID_spec = exp[i];
+      double cid_rt(CID_spec.getRT());
       double cid_mz(0);
-      if (!it->getPrecursors().empty())
+      if (!CID_spec.getPrecursors().empty())
       {
-        cid_mz = it->getPrecursors().begin()->getMZ();
+        cid_mz = CID_spec.getPrecursors().begin()->getMZ();
       }
 
-      if (it->getPrecursors().empty() || cid_mz == 0)
+      if (CID_spec.getPrecursors().empty() || cid_mz == 0)
       {
-        cerr << "CompNovoIdentification: Spectrum id=\"" << it->getNativeID() << "\" at RT=" << cid_rt << " does not have valid precursor information." << endl;
+        cerr << "CompNovoIdentification: Spectrum id=\"" << CID_spec.getNativeID() << "\" at RT=" << cid_rt << " does not have valid precursor information." << endl;
         continue;
       }
-      id.setRT(cid_rt);
-      id.setMZ(cid_mz);
 
-      if ((it + 1) != exp.end() && !(it + 1)->getPrecursors().empty())
+      if (i + 1 < exp.size() && !exp[i + 1].getPrecursors().empty())
       {
-        double etd_rt = (it + 1)->getRT();
-        double etd_mz = (it + 1)->getPrecursors().begin()->getMZ();
+        double etd_rt = exp[i + 1].getRT();
+        double etd_mz = exp[i + 1].getPrecursors().begin()->getMZ();
 
         if (fabs(etd_rt - cid_rt) < 10 &&         // RT distance is not too large
             fabs(etd_mz - cid_mz) < 0.01)             // same precursor used
         {
-          PeakSpectrum ETD_spec(*(++it));
+          cid_etd_pairs.push_back(make_pair(i, i + 1));
+          ++i;
+        }
+      }
+    }
 
-          subspec_to_sequences_.clear();
-          permute_cache_.clear();
+    // one slot per pair, so the output order does not depend on the scheduling
+    vector<PeptideIdentification> ids(cid_etd_pairs.size());
 
-          getIdentification(id, CID_spec, ETD_spec);
-          //cerr << "size_of id=" << id.getHits().size() << endl;
-          pep_ids.push_back(id);
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // the sub-spectrum and permutation caches and the decomposer are
+      // per thread, the decompositions are shared between all threads
+      CompNovoIdentification worker(*this);
+      worker.decomp_cache_ = decomp_cache_;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)cid_etd_pairs.size(); ++i)
+      {
+        try
+        {
+          const PeakSpectrum & CID_spec = exp[cid_etd_pairs[i].first];
+          const PeakSpectrum & ETD_spec = exp[cid_etd_pairs[i].second];
+          ids[i].setRT(CID_spec.getRT());
+          ids[i].setMZ(CID_spec.getPrecursors().begin()->getMZ());
+
+          worker.subspec_to_sequences_.clear();
+          worker.permute_cache_.clear();
+
+          worker.getIdentification(ids[i], CID_spec, ETD_spec);
+        }
+        catch (...)
+        {
+          exceptions.capture();
         }
       }
     }
+    exceptions.rethrow();
+
+    pep_ids.insert(pep_ids.end(), ids.begin(), ids.end());
     return;
   }
 
@@ -38,6 +38,7 @@
 #include <OpenMS/CHEMISTRY/ModificationDefinitionsSet.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
+#include <OpenMS/MATH/MISC/MathFunctions.h>
 
 // #define MIN_DOUBLE_MZ 900.0
 
@@ -58,7 +59,8 @@ namespace OpenMS
     min_mz_(200.0),
     max_decomp_weight_(450.0),
     max_subscore_number_(30),
-    max_isotope_(3)
+    max_isotope_(3),
+    decomp_cache_(new DecompositionCache())
   {
     defaults_.setValue("max_number_aa_per_decomp", 4, "maximal amino acid frequency per decomposition", ListUtils::create<String>("advanced"));
     defaults_.setValue("tryptic_only", "true", "if set to true only tryptic peptides are reported");
@@ -349,23 +351,42 @@ namespace OpenMS
 
   void CompNovoIdentificationBase::getDecompositions_(vector<MassDecomposition> & decomps, double mass, bool no_caching)
   {
-    //static Map<double, vector<MassDecomposition> > decomp_cache;
-    if (!no_caching)
+    if (no_caching || decomp_weights_precision_ <= 0)
     {
-      if (decomp_cache_.has(mass))
+      mass_decomp_algorithm_.getDecompositions(decomps, mass);
+      filterDecomps_(decomps);
+      return;
+    }
+
+    // decompose the bin center, so the result does not depend on which mass
+    // of the bin (i.e. which spectrum or thread) filled the cache first
+    Int64 mass_bin = (Int64)Math::round(mass / decomp_weights_precision_);
+    DecompositionCache::key_type key(mass_bin, fragment_mass_tolerance_);
+
+    bool found(false);
+#ifdef _OPENMP
+#pragma omp critical (CompNovoIdentificationBase_decomp_cache)
+#endif
+    {
+      DecompositionCache::const_iterator it = decomp_cache_->find(key);
+      if (it != decomp_cache_->end())
       {
-        decomps = decomp_cache_[mass];
-        return;
+        decomps = it->second;
+        found = true;
       }
     }
+    if (found)
+    {
+      return;
+    }
 
-    mass_decomp_algorithm_.getDecompositions(decomps, mass);
+    mass_decomp_algorithm_.getDecompositions(decomps, (double)mass_bin * decomp_weights_precision_);
     filterDecomps_(decomps);
 
-    if (!no_caching)
-    {
-      decomp_cache_[mass]  = decomps;
-    }
+#ifdef _OPENMP
+#pragma omp critical (CompNovoIdentificationBase_decomp_cache)
+#endif
+    decomp_cache_->insert(make_pair(key, decomps));
 
     return;
   }
@@ -759,6 +780,9 @@ for (set<Size>::const_iterator it = used_pos.begin(); it != used_pos.end(); ++it
     decomp_param.setValue("variable_modifications", param_.getValue("variable_modifications"));
     mass_decomp_algorithm_.setParameters(decomp_param);
 
+    // cached decompositions depend on the alphabet and filter settings
+    decomp_cache_.reset(new DecompositionCache());
+
     min_aa_weight_ = numeric_limits<double>::max();
     for (Map<char, double>::const_iterator it = aa_to_weight_.begin(); it != aa_to_weight_.end(); ++it)
     {
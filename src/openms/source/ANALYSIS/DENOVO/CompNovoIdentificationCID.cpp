@@ -38,6 +38,7 @@
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
 #include <OpenMS/COMPARISON/SPECTRA/SpectrumAlignmentScore.h>
 #include <OpenMS/ANALYSIS/DENOVO/CompNovoIonScoringCID.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 //#define DAC_DEBUG
 
@@ -84,32 +85,45 @@ namespace OpenMS
 
   void CompNovoIdentificationCID::getIdentifications(vector<PeptideIdentification> & pep_ids, const PeakMap & exp)
   {
-    Size count(1);
-    for (PeakMap::ConstIterator it = exp.begin(); it != exp.end(); ++it, ++count)
+    // one slot per spectrum, so the output order does not depend on the scheduling
+    vector<PeptideIdentification> ids(exp.size());
+
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-      //cerr << count << "/" << exp.size() << endl;
-      PeptideIdentification id;
-      // TODO check if both CID and ETD is present;
-      PeakSpectrum CID_spec(*it);
-      id.setRT(it->getRT());
-      id.setMZ(it->getPrecursors().begin()->getMZ());
-
-      subspec_to_sequences_.clear();
-      permute_cache_.clear();
-      decomp_cache_.clear();
-
-      getIdentification(id, CID_spec);
-      //cerr << "size_of id=" << id.getHits().size() << endl;
-      pep_ids.push_back(id);
-
-      //++it;
-
-      //
-      //if (count == 10)
-      //{
-      //return;
-      //}
+      // the sub-spectrum and permutation caches and the decomposer are
+      // per thread, the decompositions are shared between all threads
+      CompNovoIdentificationCID worker(*this);
+      worker.decomp_cache_ = decomp_cache_;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+      {
+        try
+        {
+          // TODO check if both CID and ETD is present;
+          const PeakSpectrum & CID_spec = exp[i];
+          ids[i].setRT(CID_spec.getRT());
+          ids[i].setMZ(CID_spec.getPrecursors().begin()->getMZ());
+
+          worker.subspec_to_sequences_.clear();
+          worker.permute_cache_.clear();
+
+          worker.getIdentification(ids[i], CID_spec);
+        }
+        catch (...)
+        {
+          exceptions.capture();
+        }
+      }
     }
+    exceptions.rethrow();
+
+    pep_ids.insert(pep_ids.end(), ids.begin(), ids.end());
     return;
   }
 
@@ -70,11 +70,8 @@ namespace OpenMS
                                                      AASequence seq2)
   {
     if (seq1 == seq2) return 1.0;
-    // order of sequences matters for cache look-up:
+    // use a fixed order, so the result is symmetric:
     if (seq2 < seq1) std::swap(seq1, seq2); // "operator>" not defined
-    pair<AASequence, AASequence> seq_pair = make_pair(seq1, seq2);
-    SimilarityCache::iterator pos = similarities_.find(seq_pair);
-    if (pos != similarities_.end()) return pos->second; // score found in cache
 
     // compare b and y ion series of seq. 1 and seq. 2:
     vector<double> ions1(2 * seq1.size()), ions2(2 * seq2.size());
@@ -139,7 +136,6 @@ namespace OpenMS
     {
       score_sim = matches.size() / float(min(ions1.size(), ions2.size()));
     }
-    similarities_[seq_pair] = score_sim; // cache the similarity score
 
     return score_sim;
   }
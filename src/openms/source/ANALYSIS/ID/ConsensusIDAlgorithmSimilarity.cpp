@@ -59,12 +59,24 @@ namespace OpenMS
       }
     }
 
-    for (vector<PeptideIdentification>::iterator id1 = ids.begin();
-         id1 != ids.end(); ++id1)
+    // string representations of all sequences (used as keys for the cache):
+    vector<vector<String> > keys(ids.size());
+    for (Size i = 0; i < ids.size(); ++i)
     {
-      for (vector<PeptideHit>::iterator hit1 = id1->getHits().begin();
-           hit1 != id1->getHits().end(); ++hit1)
+      keys[i].reserve(ids[i].getHits().size());
+      for (vector<PeptideHit>::const_iterator hit = ids[i].getHits().begin();
+           hit != ids[i].getHits().end(); ++hit)
       {
+        keys[i].push_back(hit->getSequence().toString());
+      }
+    }
+
+    for (Size i1 = 0; i1 < ids.size(); ++i1)
+    {
+      vector<PeptideHit>& hits1 = ids[i1].getHits();
+      for (Size h1 = 0; h1 < hits1.size(); ++h1)
+      {
+        vector<PeptideHit>::iterator hit1 = hits1.begin() + h1;
         // have we scored this sequence already? if yes, skip:
         SequenceGrouping::iterator pos = results.find(hit1->getSequence());
         if (pos != results.end())
@@ -77,25 +89,25 @@ namespace OpenMS
         // similarity scores and PEPs of best matches for all ID runs:
         vector<pair<double, double> > best_matches;
         best_matches.reserve(ids.size() - 1);
-        for (vector<PeptideIdentification>::iterator id2 = ids.begin();
-             id2 != ids.end(); ++id2)
+        for (Size i2 = 0; i2 < ids.size(); ++i2)
         {
-          if (id1 == id2) continue;
+          if (i1 == i2) continue;
           
           // similarity scores and PEPs of all matches in current ID run
           // (to get the best match, we look for highest similarity, breaking
           // ties by better PEP - so we need to transform PEP so higher scores
           // are better, same as similarity):
+          const vector<PeptideHit>& hits2 = ids[i2].getHits();
           vector<pair<double, double> > current_matches;
-          current_matches.reserve(id2->getHits().size());
-          for (vector<PeptideHit>::iterator hit2 = id2->getHits().begin();
-               hit2 != id2->getHits().end(); ++hit2)
+          current_matches.reserve(hits2.size());
+          for (Size h2 = 0; h2 < hits2.size(); ++h2)
           {
-            double sim_score = getSimilarity_(hit1->getSequence(),
-                                              hit2->getSequence());
+            double sim_score = getCachedSimilarity_(
+              hit1->getSequence(), keys[i1][h1],
+              hits2[h2].getSequence(), keys[i2][h2]);
             // use "1 - PEP" so higher scores are better (for "max_element"):
             current_matches.push_back(make_pair(sim_score,
-                                                1.0 - hit2->getScore()));
+                                                1.0 - hits2[h2].getScore()));
           }
           best_matches.push_back(*max_element(current_matches.begin(),
                                               current_matches.end()));
@@ -130,4 +142,23 @@ namespace OpenMS
     }
   }
 
+
+  double ConsensusIDAlgorithmSimilarity::getCachedSimilarity_(
+    const AASequence& seq1, const String& key1, const AASequence& seq2,
+    const String& key2)
+  {
+    // identical sequences - nothing to compute:
+    if (key1 == key2) return 1.0;
+
+    // order of sequences matters for cache look-up:
+    pair<String, String> seq_pair = ((key1 < key2) ? make_pair(key1, key2) :
+                                     make_pair(key2, key1));
+    SimilarityCache::iterator pos = similarities_.find(seq_pair);
+    if (pos != similarities_.end()) return pos->second; // score found in cache
+
+    double score_sim = getSimilarity_(seq1, seq2);
+    similarities_[seq_pair] = score_sim; // cache the similarity score
+    return score_sim;
+  }
+
 } // namespace OpenMS
@@ -34,6 +34,9 @@
 
 #include <OpenMS/ANALYSIS/ID/FalseDiscoveryRate.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
+
+#include <algorithm>
 
 // #define FALSE_DISCOVERY_RATE_DEBUG
 // #undef  FALSE_DISCOVERY_RATE_DEBUG
@@ -79,23 +82,35 @@ namespace OpenMS
 
     bool higher_score_better(ids.begin()->isHigherScoreBetter());
 
-    // first search for all identifiers and charge variants
-    set<String> identifiers;
-    set<SignedSize> charge_variants;
-    for (auto it = ids.begin(); it != ids.end(); ++it)
+    // sorting (and truncating) the hits is independent for every ID
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
     {
-      identifiers.insert(it->getIdentifier());
-      it->sort();
+      ids[i].sort();
 
       if (!use_all_hits)
       {
-        it->getHits().resize(1);
+        ids[i].getHits().resize(1);
       }
+    }
+
+    // first search for all identifiers and charge variants, and lay out the
+    // hits of all IDs consecutively (hits of ID i start at 'hit_offsets[i]')
+    set<String> identifiers;
+    set<SignedSize> charge_variants;
+    vector<Size> hit_offsets(1, 0);
+    hit_offsets.reserve(ids.size() + 1);
+    for (auto it = ids.begin(); it != ids.end(); ++it)
+    {
+      identifiers.insert(it->getIdentifier());
 
       for (auto pit = it->getHits().begin(); pit != it->getHits().end(); ++pit)
       {
         charge_variants.insert(pit->getCharge());
       }
+      hit_offsets.push_back(hit_offsets.back() + it->getHits().size());
     }
 
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
@@ -115,74 +130,131 @@ namespace OpenMS
     cerr << endl;
 #endif
 
-    for (auto zit = charge_variants.begin(); zit != charge_variants.end(); ++zit)
+    // Every hit belongs to exactly one group (charge variant x run, both only
+    // if they are treated separately), groups are numbered in the order in
+    // which they are processed: charge variants first, then runs.
+    map<SignedSize, Size> charge_index;
+    if (split_charge_variants)
+    {
+      for (auto zit = charge_variants.begin(); zit != charge_variants.end(); ++zit)
+      {
+        charge_index.insert(make_pair(*zit, charge_index.size()));
+      }
+    }
+    map<String, Size> run_index;
+    if (treat_runs_separately)
     {
-#ifdef FALSE_DISCOVERY_RATE_DEBUG
-      cerr << "Charge variant=" << *zit << endl;
-#endif
-
-      // for all identifiers
       for (auto iit = identifiers.begin(); iit != identifiers.end(); ++iit)
       {
-        if (!treat_runs_separately && iit != identifiers.begin())
-        {
-          continue;
-        }
-
-#ifdef FALSE_DISCOVERY_RATE_DEBUG
-        cerr << "Id-run: " << *iit << endl;
+        run_index.insert(make_pair(*iit, run_index.size()));
+      }
+    }
+    const Size n_charges = split_charge_variants ? charge_variants.size() : std::min(charge_variants.size(), Size(1));
+    const Size n_runs = treat_runs_separately ? identifiers.size() : 1;
+    const Size n_groups = n_charges * n_runs;
+
+    // single pass over all hits: extract group, target/decoy state and score
+    // into flat arrays, so the groups don't have to rescan all IDs
+    enum TargetDecoy { TD_NONE, TD_TARGET, TD_DECOY };
+    const Size n_hits = hit_offsets.back();
+    vector<Size> hit_group(n_hits);
+    vector<char> hit_td(n_hits);
+    vector<double> hit_score(n_hits);
+
+    // resolve the meta value once - lookups by name lock the meta info registry
+    const UInt td_index = MetaInfoInterface::metaRegistry().getIndex("target_decoy");
+
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
 #endif
-        // get the scores of all peptide hits
-        vector<double> target_scores, decoy_scores;
-        for (auto it = ids.begin(); it != ids.end(); ++it)
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
+    {
+      try
+      {
+        const vector<PeptideHit>& hits = ids[i].getHits();
+        const Size run = treat_runs_separately ? run_index.find(ids[i].getIdentifier())->second : 0;
+        for (Size j = 0; j < hits.size(); ++j)
         {
-          // if runs should be treated separately, the identifiers must be the same
-          if (treat_runs_separately && it->getIdentifier() != *iit)
+          const Size h = hit_offsets[i] + j;
+          const Size charge = split_charge_variants ? charge_index.find(hits[j].getCharge())->second : 0;
+          hit_group[h] = charge * n_runs + run;
+          hit_score[h] = hits[j].getScore();
+
+          if (td_index == UInt(-1) || !hits[j].metaValueExists(td_index))
           {
-            continue;
+#ifdef _OPENMP
+#pragma omp critical (FalseDiscoveryRate_log)
+#endif
+            LOG_FATAL_ERROR << "Meta value 'target_decoy' does not exists, reindex the idXML file with 'PeptideIndexer' first (run-id='" << ids[i].getIdentifier() << ", rank=" << j + 1 << " of " << hits.size() << ")!" << endl;
+            throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Meta value 'target_decoy' does not exist!");
           }
 
-          for (Size i = 0; i < it->getHits().size(); ++i)
+          String target_decoy(hits[j].getMetaValue(td_index));
+          if (target_decoy == "target" || target_decoy == "target+decoy")
           {
-            if (split_charge_variants && it->getHits()[i].getCharge() != *zit)
-            {
-              continue;
-            }
+            hit_td[h] = TD_TARGET;
+          }
+          else if (target_decoy == "decoy")
+          {
+            hit_td[h] = TD_DECOY;
+          }
+          else if (target_decoy == "")
+          {
+            hit_td[h] = TD_NONE;
+          }
+          else
+          {
+            throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", target_decoy);
+          }
+        }
+      }
+      catch (...)
+      {
+        exceptions.capture();
+      }
+    }
+    exceptions.rethrow();
 
-            if (!it->getHits()[i].metaValueExists("target_decoy"))
-            {
-              LOG_FATAL_ERROR << "Meta value 'target_decoy' does not exists, reindex the idXML file with 'PeptideIndexer' first (run-id='" << it->getIdentifier() << ", rank=" << i + 1 << " of " << it->getHits().size() << ")!" << endl;
-              throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Meta value 'target_decoy' does not exist!");
-            }
+    // scores per group (in the order of the IDs and hits)
+    vector<vector<double> > target_scores(n_groups), decoy_scores(n_groups);
+    for (Size h = 0; h < n_hits; ++h)
+    {
+      if (hit_td[h] == TD_TARGET)
+      {
+        target_scores[hit_group[h]].push_back(hit_score[h]);
+      }
+      else if (hit_td[h] == TD_DECOY)
+      {
+        decoy_scores[hit_group[h]].push_back(hit_score[h]);
+      }
+    }
 
-            String target_decoy(it->getHits()[i].getMetaValue("target_decoy"));
-            if (target_decoy == "target" || target_decoy == "target+decoy")
-            {
-              target_scores.push_back(it->getHits()[i].getScore());
-            }
-            else
-            {
-              if (target_decoy == "decoy")
-              {
-                decoy_scores.push_back(it->getHits()[i].getScore());
-              }
-              else
-              {
-                if (target_decoy != "")
-                {
-                  throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", target_decoy);
-                }
-              }
-            }
-          }
+    // calculate FDRs per group; groups without targets or decoys get pseudo-scores below
+    vector<Map<double, double> > score_to_fdr(n_groups);
+    vector<char> no_fdr(n_groups, false);
+    Size group = 0;
+    for (auto zit = charge_variants.begin(); zit != charge_variants.end(); ++zit)
+    {
+#ifdef FALSE_DISCOVERY_RATE_DEBUG
+      cerr << "Charge variant=" << *zit << endl;
+#endif
+
+      // for all identifiers
+      for (auto iit = identifiers.begin(); iit != identifiers.end(); ++iit, ++group)
+      {
+        if (!treat_runs_separately && iit != identifiers.begin())
+        {
+          break;
         }
 
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
-        cerr << "#target-scores=" << target_scores.size() << ", #decoy-scores=" << decoy_scores.size() << endl;
+        cerr << "Id-run: " << *iit << endl;
+        cerr << "#target-scores=" << target_scores[group].size() << ", #decoy-scores=" << decoy_scores[group].size() << endl;
 #endif
 
         // check decoy scores
-        if (decoy_scores.empty())
+        if (decoy_scores[group].empty())
         {
           String error_string = "FalseDiscoveryRate: #decoy sequences is zero! Setting all target sequences to q-value/FDR 0! ";
           if (split_charge_variants || treat_runs_separately)
@@ -202,7 +274,7 @@ namespace OpenMS
         }
 
         // check target scores
-        if (target_scores.empty())
+        if (target_scores[group].empty())
         {
           String error_string = "FalseDiscoveryRate: #target sequences is zero! Ignoring. ";
           if (split_charge_variants || treat_runs_separately)
@@ -221,119 +293,92 @@ namespace OpenMS
           LOG_ERROR << error_string << std::endl;
         }
 
-        if (target_scores.empty() || decoy_scores.empty())
+        if (target_scores[group].empty() || decoy_scores[group].empty())
         {
-          // no remove the the relevant entries, or put 'pseudo-scores' in
-          for (auto it = ids.begin(); it != ids.end(); ++it)
-          {
-            // if runs should be treated separately, the identifiers must be the same
-            if (treat_runs_separately && it->getIdentifier() != *iit)
-            {
-              continue;
-            }
-
-            vector<PeptideHit> hits(it->getHits()), new_hits;
-            for (Size i = 0; i < hits.size(); ++i)
-            {
-              if (split_charge_variants && hits[i].getCharge() != *zit)
-              {
-                new_hits.push_back(hits[i]);
-                continue;
-              }
-
-              if (!hits[i].metaValueExists("target_decoy"))
-              {
-                LOG_FATAL_ERROR << "Meta value 'target_decoy' does not exists, reindex the idXML file with 'PeptideIndexer' (run-id='" << it->getIdentifier() << ", rank=" << i + 1 << " of " << hits.size() << ")!" << endl;
-                throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Meta value 'target_decoy' does not exist!");
-              }
-
-              String target_decoy(hits[i].getMetaValue("target_decoy"));
-              if (target_decoy == "target" || target_decoy == "target+decoy")
-              {
-                // if it is a target hit, there are now decoys, fdr/q-value should be zero then
-                new_hits.push_back(hits[i]);
-                String score_type = it->getScoreType() + "_score";
-                new_hits.back().setMetaValue(score_type, new_hits.back().getScore());
-                new_hits.back().setScore(0);
-              }
-              else
-              {
-                if (target_decoy != "decoy")
-                {
-                  throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", target_decoy);
-                }
-              }
-            }
-            it->setHits(new_hits);
-          }
+          no_fdr[group] = true;
           continue;
         }
 
         // calculate fdr for the forward scores
-        Map<double, double> score_to_fdr;
-        calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
+        calculateFDRs_(score_to_fdr[group], target_scores[group], decoy_scores[group], q_value, higher_score_better);
+      }
+      if (!split_charge_variants)
+      {
+        break;
+      }
+    }
 
-        // annotate fdr
-        for (auto it = ids.begin(); it != ids.end(); ++it)
+    // annotate fdr - every ID only touches its own hits and reads the
+    // (now constant) score maps, so this can run in parallel
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
+    {
+      try
+      {
+        PeptideIdentification& id = ids[i];
+        const UInt score_index = MetaInfoInterface::metaRegistry().registerName(id.getScoreType() + "_score");
+        const vector<PeptideHit>& old_hits = id.getHits();
+        vector<PeptideHit> hits;
+        hits.reserve(old_hits.size());
+        for (Size j = 0; j < old_hits.size(); ++j)
         {
-          // if runs should be treated separately, the identifiers must be the same
-          if (treat_runs_separately && it->getIdentifier() != *iit)
-          {
-            continue;
-          }
-
-          String score_type = it->getScoreType() + "_score";
-          vector<PeptideHit> hits;
-          for (vector<PeptideHit>::const_iterator pit = it->getHits().begin(); pit != it->getHits().end(); ++pit)
+          const Size h = hit_offsets[i] + j;
+          const Size g = hit_group[h];
+          if (no_fdr[g])
           {
-            PeptideHit hit = *pit;
-
-            if (split_charge_variants && pit->getCharge() != *zit)
+            // no remove the the relevant entries, or put 'pseudo-scores' in
+            if (hit_td[h] == TD_TARGET)
             {
-              hits.push_back(*pit);
-              continue;
+              // if it is a target hit, there are now decoys, fdr/q-value should be zero then
+              hits.push_back(old_hits[j]);
+              hits.back().setMetaValue(score_index, hit_score[h]);
+              hits.back().setScore(0);
             }
-            if (hit.metaValueExists("target_decoy"))
+            else if (hit_td[h] != TD_DECOY)
             {
-              String meta_value = (String)hit.getMetaValue("target_decoy");
-              if (meta_value == "decoy" && !add_decoy_peptides)
-              {
-                continue;
-              }
+              throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown value of meta value 'target_decoy'", "");
             }
-            hit.setMetaValue(score_type, pit->getScore());
-            hit.setScore(score_to_fdr[pit->getScore()]);
-            hits.push_back(hit);
+            continue;
+          }
+
+          if (hit_td[h] == TD_DECOY && !add_decoy_peptides)
+          {
+            continue;
           }
-          it->getHits().swap(hits);
+          hits.push_back(old_hits[j]);
+          hits.back().setMetaValue(score_index, hit_score[h]);
+          // scores without an FDR (no target/decoy annotation) are set to zero
+          Map<double, double>::const_iterator fdr_it = score_to_fdr[g].find(hit_score[h]);
+          hits.back().setScore(fdr_it == score_to_fdr[g].end() ? 0.0 : fdr_it->second);
         }
-      }
-      if (!split_charge_variants)
-      {
-        break;
-      }
-    }
+        id.getHits().swap(hits);
 
-    // higher-score-better can be set now, calculations are finished
-    for (vector<PeptideIdentification>::iterator it = ids.begin(); it != ids.end(); ++it)
-    {
-      if (q_value)
-      {
-        if (it->getScoreType() != "q-value")
+        // higher-score-better can be set now, calculations are finished
+        if (q_value)
         {
-          it->setScoreType("q-value");
+          if (id.getScoreType() != "q-value")
+          {
+            id.setScoreType("q-value");
+          }
         }
-      }
-      else
-      {
-        if (it->getScoreType() != "FDR")
+        else
         {
-          it->setScoreType("FDR");
+          if (id.getScoreType() != "FDR")
+          {
+            id.setScoreType("FDR");
+          }
         }
+        id.setHigherScoreBetter(false);
+        id.assignRanks();
+      }
+      catch (...)
+      {
+        exceptions.capture();
       }
-      it->setHigherScoreBetter(false);
-      it->assignRanks();
     }
+    exceptions.rethrow();
 
     return;
   }
@@ -671,12 +716,22 @@ namespace OpenMS
       const double& ds = decoy_scores[i];
 
       // advance target index until score is better than decoy score
+      // (for q-values, the targets are sorted worst-first, so the targets not
+      // better than 'ds' form a prefix and binary search finds its end; for
+      // FDRs they are sorted best-first and form a suffix, so the scan stops
+      // either at the first target or runs through all of them)
+      auto not_better = [&ds, higher_score_better](double ts)
+      {
+        return (ts <= ds && higher_score_better) || (ts >= ds && !higher_score_better);
+      };
       size_t k{0};
-      while (k != target_scores.size() && 
-             ((target_scores[k] <= ds && higher_score_better) ||
-              (target_scores[k] >= ds && !higher_score_better)))
+      if (q_value)
+      {
+        k = partition_point(target_scores.begin(), target_scores.end(), not_better) - target_scores.begin();
+      }
+      else if (!target_scores.empty() && not_better(target_scores[0]))
       {
-        ++k;
+        k = target_scores.size();
       }
 
       // corner cases
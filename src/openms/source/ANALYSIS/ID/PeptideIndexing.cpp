@@ -91,6 +91,8 @@ using namespace std;
     defaults_.setValue("IL_equivalent", "false", "Treat the isobaric amino acids isoleucine ('I') and leucine ('L') as equivalent (indistinguishable). Also occurences of 'J' will be treated as 'I' thus avoiding ambiguous matching.");
     defaults_.setValidStrings("IL_equivalent", ListUtils::create<String>("true,false"));
 
+    defaults_.setValue("automaton_cache", "", "Directory in which the search trie built from the peptide sequences is stored, and from which it is loaded in later runs with the same peptides and settings (e.g. when indexing against several databases). Empty: no caching.", ListUtils::create<String>("advanced"));
+
     defaultsToParam_();
   }
 
@@ -114,6 +116,7 @@ using namespace std;
     IL_equivalent_ = param_.getValue("IL_equivalent").toBool();
     aaa_max_ = static_cast<Int>(param_.getValue("aaa_max"));
     mm_max_ = static_cast<Int>(param_.getValue("mismatches_max"));
+    automaton_cache_ = static_cast<String>(param_.getValue("automaton_cache"));
   }
 
 const String &PeptideIndexing::getDecoyString() const
@@ -38,6 +38,9 @@
 
 #include <OpenMS/CONCEPT/Exception.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace OpenMS
 {
 
@@ -291,14 +294,34 @@ namespace OpenMS
         "Input to extractChromatogram needs to be sorted by m/z");
     }
 
+    // if all coordinates are limited in RT, spectra outside of the joint RT
+    // range do not contribute to any chromatogram and need not be loaded
+    bool rt_limited = true;
+    double rt_min = std::numeric_limits<double>::max();
+    double rt_max = -std::numeric_limits<double>::max();
+    for (Size k = 0; k < extraction_coordinates.size(); ++k)
+    {
+      if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start <= 0)
+      {
+        rt_limited = false;
+        break;
+      }
+      rt_min = std::min(rt_min, extraction_coordinates[k].rt_start);
+      rt_max = std::max(rt_max, extraction_coordinates[k].rt_end);
+    }
+
     //go through all spectra
     startProgress(0, input_size, "Extracting chromatograms");
     for (Size scan_idx = 0; scan_idx < input_size; ++scan_idx)
     {
       setProgress(scan_idx);
 
-      OpenSwath::SpectrumPtr sptr = input->getSpectrumById(scan_idx);
       OpenSwath::SpectrumMeta s_meta = input->getSpectrumMetaById(scan_idx);
+      if (rt_limited && (s_meta.RT < rt_min || s_meta.RT > rt_max))
+      {
+        continue;
+      }
+      OpenSwath::SpectrumPtr sptr = input->getSpectrumById(scan_idx);
 
       OpenSwath::BinaryDataArrayPtr mz_arr = sptr->getMZArray();
       OpenSwath::BinaryDataArrayPtr int_arr = sptr->getIntensityArray();
@@ -39,6 +39,15 @@
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// deleter for shared pointers that do not own the referenced object
+    struct NoOpDeleter
+    {
+      void operator()(const void*) const {}
+    };
+  }
+
   bool SimpleOpenMSSpectraFactory::isExperimentCached(boost::shared_ptr<PeakMap> exp)
   {
     for (std::size_t i = 0; i < exp->getSpectra().size(); ++i)
@@ -79,5 +88,10 @@ namespace OpenMS
     }
   }
 
+  OpenSwath::SpectrumAccessPtr SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtrNoCopy(PeakMap& exp)
+  {
+    return getSpectrumAccessOpenMSPtr(boost::shared_ptr<PeakMap>(&exp, NoOpDeleter()));
+  }
+
 }//end Namespace
 
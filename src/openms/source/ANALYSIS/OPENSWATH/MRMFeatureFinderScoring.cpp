@@ -46,6 +46,7 @@
 // Helpers
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/foreach.hpp>
@@ -58,7 +59,8 @@ bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std:
 }
 
 void processFeatureForOutput(OpenMS::Feature& curr_feature, bool write_convex_hull_, double
-                             quantification_cutoff_, double& total_intensity, double& total_peak_apices, std::string ms_level)
+                             quantification_cutoff_, double& total_intensity, double& total_peak_apices, std::string ms_level,
+                             bool assign_unique_id = true)
 {
   // Save some space when writing out the featureXML
   if (!write_convex_hull_)
@@ -67,7 +69,10 @@ void processFeatureForOutput(OpenMS::Feature& curr_feature, bool write_convex_hu
   }
 
   // Ensure a unique id is present
-  curr_feature.ensureUniqueId();
+  if (assign_unique_id)
+  {
+    curr_feature.ensureUniqueId();
+  }
 
   // Sum up intensities of the features
   if (curr_feature.getMZ() > quantification_cutoff_)
@@ -150,6 +155,7 @@ namespace OpenMS
     defaultsToParam_();
 
     strict_ = true;
+    assign_unique_ids_ = true;
   }
 
   MRMFeatureFinderScoring::~MRMFeatureFinderScoring()
@@ -221,31 +227,104 @@ namespace OpenMS
     // Step 3
     //
     // Go through all transition groups: first create consensus features, then score them
-    MRMTransitionGroupPicker trgroup_picker;
     Param trgroup_picker_param = param_.copy("TransitionGroupPicker:", true);
     // If use_total_mi_score is defined, we need to instruct MRMTransitionGroupPicker to compute the score
     if (su_.use_total_mi_score_)
     {
       trgroup_picker_param.setValue("compute_total_mi", "true");
     }
-    trgroup_picker.setParameters(trgroup_picker_param);
 
-    Size progress = 0;
-    startProgress(0, transition_group_map.size(), "picking peaks");
+    // Transition groups are independent of each other and are picked and
+    // scored in parallel. Features are collected per group and appended to
+    // the output in map order afterwards, so the result does not depend on
+    // the number of threads.
+    std::vector<MRMTransitionGroupType*> transition_groups;
+    transition_groups.reserve(transition_group_map.size());
     for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
     {
+      transition_groups.push_back(&trgroup_it->second);
+    }
+    std::vector<FeatureMap> group_features(transition_groups.size());
 
-      setProgress(++progress);
-      MRMTransitionGroupType& transition_group = trgroup_it->second;
-      if (transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
+    Size progress = 0;
+    startProgress(0, transition_groups.size(), "picking peaks");
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      // Picker and scoring objects are not shared between threads: each
+      // thread uses its own feature finder (holding its own DIA, SONAR and
+      // EMG scoring) and light clones of the spectrum access pointers
+      // (file-backed access must not be seeked concurrently).
+      MRMTransitionGroupPicker trgroup_picker;
+      trgroup_picker.setParameters(trgroup_picker_param);
+
+      MRMFeatureFinderScoring thread_scorer;
+      thread_scorer.setParameters(param_);
+      thread_scorer.setStrictFlag(strict_);
+      thread_scorer.assign_unique_ids_ = false; // assigned in input order below
+      thread_scorer.PeptideRefMap_ = PeptideRefMap_;
+      if (ms1_map_)
       {
-        continue;
+        thread_scorer.setMS1Map(ms1_map_->lightClone());
       }
 
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_maps, output);
+      std::vector<OpenSwath::SwathMap> thread_swath_maps = swath_maps;
+      for (Size i = 0; i < thread_swath_maps.size(); ++i)
+      {
+        if (thread_swath_maps[i].sptr)
+        {
+          thread_swath_maps[i].sptr = thread_swath_maps[i].sptr->lightClone();
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)transition_groups.size(); ++i)
+      {
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+
+        MRMTransitionGroupType& transition_group = *transition_groups[i];
+        if (transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
+        {
+          continue;
+        }
+
+        try
+        {
+          trgroup_picker.pickTransitionGroup(transition_group);
+          thread_scorer.scorePeakgroups(transition_group, trafo, thread_swath_maps, group_features[i]);
+        }
+        catch (...)
+        {
+          exceptions.capture();
+        }
+      }
     }
     endProgress();
+    exceptions.rethrow();
+
+    // unique ids are drawn here (and not by the threads), so they do not depend on the thread schedule;
+    // ids set by the transition group picker are replaced as well
+    for (Size i = 0; i < group_features.size(); ++i)
+    {
+      for (FeatureMap::const_iterator f_it = group_features[i].begin(); f_it != group_features[i].end(); ++f_it)
+      {
+        output.push_back(*f_it);
+        Feature& feature = output.back();
+        feature.setUniqueId();
+        for (std::vector<Feature>::iterator sub_it = feature.getSubordinates().begin(); sub_it != feature.getSubordinates().end(); ++sub_it)
+        {
+          sub_it->setUniqueId();
+        }
+      }
+    }
 
     //output.sortByPosition(); // if the exact same order is needed
     return;
@@ -974,7 +1053,10 @@ namespace OpenMS
       pep_id_.setIdentifier(run_identifier);
 
       mrmfeature->getPeptideIdentifications().push_back(pep_id_);
-      mrmfeature->ensureUniqueId();
+      if (assign_unique_ids_)
+      {
+        mrmfeature->ensureUniqueId();
+      }
 
       mrmfeature->setMetaValue("PrecursorMZ", precursor_mz);
 
@@ -986,7 +1068,7 @@ namespace OpenMS
 
       for (std::vector<Feature>::iterator f_it = allFeatures.begin(); f_it != allFeatures.end(); ++f_it)
       {
-        processFeatureForOutput(*f_it, write_convex_hull_, quantification_cutoff_, total_intensity, total_peak_apices, "MS2");
+        processFeatureForOutput(*f_it, write_convex_hull_, quantification_cutoff_, total_intensity, total_peak_apices, "MS2", assign_unique_ids_);
       }
       // Also append data for MS1 precursors
       std::vector<String> precursors_ids;
@@ -998,7 +1080,7 @@ namespace OpenMS
         {
           curr_feature.setCharge(pep->getChargeState());
         }
-        processFeatureForOutput(curr_feature, write_convex_hull_, quantification_cutoff_, ms1_total_intensity, ms1_total_peak_apices, "MS1");
+        processFeatureForOutput(curr_feature, write_convex_hull_, quantification_cutoff_, ms1_total_intensity, ms1_total_peak_apices, "MS1", assign_unique_ids_);
         if (ms1only)
         {
           total_intensity += curr_feature.getIntensity();
@@ -67,6 +67,23 @@ namespace OpenMS
     int signal_not_unique;  ///< counts if more than one peak was found within the search window of each reporter position
   };
 
+  /// reporter signal of a single channel in a single spectrum (computed in parallel, evaluated in scan order)
+  struct ReporterSignal
+  {
+    // C'tor
+    ReporterSignal() :
+      found(false),
+      not_unique(false),
+      mz_delta(0.0),
+      intensity(0)
+    {}
+
+    bool found; ///< a non-zero peak was found within the QC window around the expected position
+    bool not_unique; ///< more than one peak was found within the reporter mass shift
+    double mz_delta; ///< m/z distance between expected position and closest peak
+    Peak2D::IntensityType intensity; ///< intensity of the closest peak, if it is within the reporter mass shift
+  };
+
 
   IsobaricChannelExtractor::PuritySate_::PuritySate_(const PeakMap& targetExp) :
     baseExperiment(targetExp)
@@ -507,8 +524,10 @@ namespace OpenMS
     LOG_INFO << "Using MS-level " << quant_ms_level << " for quantification." << std::endl;
 
     // now we have picked data
-    // --> assign peaks to channels
-    UInt64 element_index(0);
+    // --> collect the spectra used for quantification (serial, as the purity state depends on the scan order)
+    std::vector<PeakMap::ConstIterator> quant_spectra;
+    std::vector<PeakMap::ConstIterator> quant_last_MS2;
+    std::vector<PuritySate_> quant_purity_states;
 
     // remember the current precursor spectrum
     PuritySate_ pState(ms_exp_data);
@@ -564,11 +583,83 @@ namespace OpenMS
         continue;
       }
 
+      quant_spectra.push_back(it);
+      quant_last_MS2.push_back(it_last_MS2);
+      quant_purity_states.push_back(pState);
+    } // ! Experiment iterator
+
+    // --> compute precursor purity and assign peaks to channels (independent for each spectrum)
+    std::vector<double> precursor_purities(quant_spectra.size(), -1.0);
+    std::vector<std::vector<ReporterSignal> > reporter_signals(quant_spectra.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 100)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)quant_spectra.size(); ++i)
+    {
+      const PeakMap::ConstIterator& it = quant_spectra[i];
+
       // check precursor purity if we have a valid precursor ..
-      double precursor_purity = -1.0;
-      if (pState.precursorScan != ms_exp_data.end())
+      if (quant_purity_states[i].precursorScan != ms_exp_data.end())
+      {
+        precursor_purities[i] = computePrecursorPurity_(it, quant_purity_states[i]);
+        // check if purity is high enough (reported below)
+        if (precursor_purities[i] < min_precursor_purity_) continue;
+      }
+
+      std::vector<ReporterSignal>& signals = reporter_signals[i];
+      signals.reserve(number_of_channels);
+      for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
+            cl_it != quant_method_->getChannelInformation().end();
+            ++cl_it)
+      {
+        ReporterSignal signal;
+
+        // as every evaluation requires time, we cache the MZEnd iterator
+        const PeakMap::SpectrumType::ConstIterator mz_end = it->MZEnd(cl_it->center + qc_dist_mz);
+
+        // search for the non-zero signal closest to theoretical position
+        // & check for closest signal within reasonable distance (0.5 Da) -- might find neighbouring TMT channel, but that should not confuse anyone
+        int peak_count(0); // count peaks in user window -- should be only one, otherwise Window is too large
+        PeakMap::SpectrumType::ConstIterator idx_nearest(mz_end);
+        for (PeakMap::SpectrumType::ConstIterator mz_it = it->MZBegin(cl_it->center - qc_dist_mz);
+              mz_it != mz_end;
+              ++mz_it)
+        {
+          if (mz_it->getIntensity() == 0) continue; // ignore 0-intensity shoulder peaks -- could be detrimental when de-calibrated
+          double dist_mz = fabs(mz_it->getMZ() - cl_it->center);
+          if (dist_mz < reporter_mass_shift_) ++peak_count;
+          if (idx_nearest == mz_end // first peak
+              || ((dist_mz < fabs(idx_nearest->getMZ() - cl_it->center)))) // closer to best candidate
+          {
+            idx_nearest = mz_it;
+          }
+        }
+        if (idx_nearest != mz_end)
+        {
+          signal.found = true;
+          signal.mz_delta = cl_it->center - idx_nearest->getMZ();
+          signal.not_unique = (peak_count > 1);
+          // pass user threshold
+          if (std::fabs(signal.mz_delta) < reporter_mass_shift_)
+          {
+            signal.intensity = idx_nearest->getIntensity();
+          }
+        }
+        signals.push_back(signal);
+      } // ! channel_iterator
+    }
+
+    // --> assemble the consensus features in the order of the spectra in the experiment
+    UInt64 element_index(0);
+
+    for (Size i = 0; i < quant_spectra.size(); ++i)
+    {
+      const PeakMap::ConstIterator& it = quant_spectra[i];
+
+      double precursor_purity = precursor_purities[i];
+      if (quant_purity_states[i].precursorScan != ms_exp_data.end())
       {
-        precursor_purity = computePrecursorPurity_(it, pState);
         // check if purity is high enough
         if (precursor_purity < min_precursor_purity_)
         {
@@ -582,14 +673,14 @@ namespace OpenMS
       }
 
       // store RT&MZ of MS1 parent ion as centroid of ConsensusFeature
-      if (it_last_MS2 == ms_exp_data.end())
+      if (quant_last_MS2[i] == ms_exp_data.end())
       { // this only happens if an MS3 spec does not have a preceding MS2
         throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No MS2 precursor information given for MS3 scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
       }
       ConsensusFeature cf;
       cf.setUniqueId();
-      cf.setRT(it_last_MS2->getRT());
-      cf.setMZ(it_last_MS2->getPrecursors()[0].getMZ());
+      cf.setRT(quant_last_MS2[i]->getRT());
+      cf.setMZ(quant_last_MS2[i]->getPrecursors()[0].getMZ());
 
       Peak2D channel_value;
       channel_value.setRT(it->getRT());
@@ -601,42 +692,16 @@ namespace OpenMS
             cl_it != quant_method_->getChannelInformation().end();
             ++cl_it)
       {
+        const ReporterSignal& signal = reporter_signals[i][map_index];
         // set mz-position of channel
         channel_value.setMZ(cl_it->center);
-        // reset intensity
-        channel_value.setIntensity(0);
-
-        // as every evaluation requires time, we cache the MZEnd iterator
-        const PeakMap::SpectrumType::ConstIterator mz_end = it->MZEnd(cl_it->center + qc_dist_mz);
+        channel_value.setIntensity(signal.intensity);
 
-        // search for the non-zero signal closest to theoretical position
-        // & check for closest signal within reasonable distance (0.5 Da) -- might find neighbouring TMT channel, but that should not confuse anyone
-        int peak_count(0); // count peaks in user window -- should be only one, otherwise Window is too large
-        PeakMap::SpectrumType::ConstIterator idx_nearest(mz_end);
-        for (PeakMap::SpectrumType::ConstIterator mz_it = it->MZBegin(cl_it->center - qc_dist_mz);
-              mz_it != mz_end;
-              ++mz_it)
+        if (signal.found)
         {
-          if (mz_it->getIntensity() == 0) continue; // ignore 0-intensity shoulder peaks -- could be detrimental when de-calibrated
-          double dist_mz = fabs(mz_it->getMZ() - cl_it->center);
-          if (dist_mz < reporter_mass_shift_) ++peak_count;
-          if (idx_nearest == mz_end // first peak
-              || ((dist_mz < fabs(idx_nearest->getMZ() - cl_it->center)))) // closer to best candidate
-          {
-            idx_nearest = mz_it;
-          }
-        }
-        if (idx_nearest != mz_end)
-        {
-          double mz_delta = cl_it->center - idx_nearest->getMZ();
           // stats: we don't care what shift the user specified
-          channel_mz_delta[cl_it->name].mz_deltas.push_back(mz_delta);
-          if (peak_count > 1) ++channel_mz_delta[cl_it->name].signal_not_unique;
-          // pass user threshold
-          if (std::fabs(mz_delta) < reporter_mass_shift_)
-          {
-            channel_value.setIntensity(idx_nearest->getIntensity());
-          }
+          channel_mz_delta[cl_it->name].mz_deltas.push_back(signal.mz_delta);
+          if (signal.not_unique) ++channel_mz_delta[cl_it->name].signal_not_unique;
         }
 
         // discard contribution of this channel as it is below the required intensity threshold
@@ -679,7 +744,7 @@ namespace OpenMS
 
       // the tandem-scan in the order they appear in the experiment
       ++element_index;
-    } // ! Experiment iterator
+    } // ! quantified spectra
 
     // print stats about m/z calibration / presence of signal
     LOG_INFO << "Calibration stats: Median distance of observed reporter ions m/z to expected position (up to " << qc_dist_mz << " Th):\n";
@@ -38,12 +38,15 @@
 
 #include <OpenMS/DATASTRUCTURES/Utils/MatrixUtils.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 // NNLS isotope correction
 #include <OpenMS/MATH/MISC/NonNegativeLeastSquaresSolver.h>
 
 #include <Eigen/LU>
 
+#include <algorithm>
+
 // #define ISOBARIC_QUANT_DEBUG
 
 namespace OpenMS
@@ -73,11 +76,8 @@ namespace OpenMS
 
     // convert to Eigen matrix
     EigenMatrixXdPtr m(convertOpenMSMatrix2EigenMatrixXd(correction_matrix));
+    // the decomposition is computed once and shared (read-only) by all features
     Eigen::FullPivLU<Eigen::MatrixXd> ludecomp(*m);
-    Eigen::VectorXd b;
-    b.resize(quant_method->getNumberOfChannels());
-    b.setZero();
-    std::vector<double> x(quant_method->getNumberOfChannels(), 0);
 
     if (!ludecomp.isInvertible())
     {
@@ -85,50 +85,94 @@ namespace OpenMS
       throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: The given isotope correction matrix is not invertible!");
     }
 
-    // data structures for NNLS
-    Matrix<double> m_b(quant_method->getNumberOfChannels(), 1);
-    Matrix<double> m_x(quant_method->getNumberOfChannels(), 1);
+    // resolve map index -> channel id once, instead of once per feature handle
+    const ChannelIndexMap channel_ids = getChannelIds_(consensus_map_in);
+
+    // solutions of both methods per feature; stats are computed afterwards in map order
+    std::vector<Eigen::MatrixXd> naive_solutions(consensus_map_out.size());
+    std::vector<Matrix<double> > nnls_solutions(consensus_map_out.size());
+    std::vector<float> cf_intensities(consensus_map_out.size(), 0);
 
     // correct all consensus elements
-    for (ConsensusMap::size_type i = 0; i < consensus_map_out.size(); ++i)
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
+      // data structures for Eigen/NNLS (one set per thread)
+      Eigen::VectorXd b(quant_method->getNumberOfChannels());
+      Matrix<double> m_b(quant_method->getNumberOfChannels(), 1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 100)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)consensus_map_out.size(); ++i)
+      {
+        try
+        {
 #ifdef ISOBARIC_QUANT_DEBUG
-      std::cout << "\nMAP element  #### " << i << " #### \n" << std::endl;
+          std::cout << "\nMAP element  #### " << i << " #### \n" << std::endl;
 #endif
-      // delete only the consensus handles from the output map
-      consensus_map_out[i].clear();
+          // delete only the consensus handles from the output map
+          consensus_map_out[i].clear();
 
-      // fill b vector
-      fillInputVector_(b, m_b, consensus_map_in[i], consensus_map_in);
+          // fill b vector
+          fillInputVector_(b, m_b, consensus_map_in[i], channel_ids);
 
-      //solve
-      Eigen::MatrixXd e_mx = ludecomp.solve(b);
-      if (!((*m) * e_mx).isApprox(b))
-      {
-        throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: Cannot multiply!");
-      }
-      solveNNLS_(correction_matrix, m_b, m_x);
+          //solve
+          naive_solutions[i] = ludecomp.solve(b);
+          if (!((*m) * naive_solutions[i]).isApprox(b))
+          {
+            throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: Cannot multiply!");
+          }
+          solveNNLS_(correction_matrix, m_b, nnls_solutions[i]);
 
-      // update the output consensus map with the corrected intensities
-      float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, i, m_x);
+          // update the output consensus map with the corrected intensities
+          cf_intensities[i] = updateOutpuMap_(consensus_map_in, consensus_map_out, i, nnls_solutions[i], channel_ids);
+        }
+        catch (...)
+        {
+          exceptions.capture();
+        }
+      }
+    }
+    exceptions.rethrow();
 
-      // check consistency
-      computeStats_(m_x, e_mx, cf_intensity, quant_method, stats);    
+    // check consistency
+    for (Size i = 0; i < consensus_map_out.size(); ++i)
+    {
+      computeStats_(nnls_solutions[i], naive_solutions[i], cf_intensities[i], quant_method, stats);
     }
 
     return stats;
   }
 
+  IsobaricIsotopeCorrector::ChannelIndexMap
+  IsobaricIsotopeCorrector::getChannelIds_(const ConsensusMap& cm)
+  {
+    ChannelIndexMap channel_ids;
+    for (ConsensusMap::ColumnHeaders::const_iterator it = cm.getColumnHeaders().begin();
+         it != cm.getColumnHeaders().end();
+         ++it)
+    {
+      channel_ids[it->first] = Int(it->second.getMetaValue("channel_id"));
+    }
+    return channel_ids;
+  }
+
   void
   IsobaricIsotopeCorrector::fillInputVector_(Eigen::VectorXd& b,
-                                             Matrix<double>& m_b, const ConsensusFeature& cf, const ConsensusMap& cm)
+                                             Matrix<double>& m_b, const ConsensusFeature& cf, const ChannelIndexMap& channel_ids)
   {
+    // channels without a handle in this feature must not keep values of the previous one
+    b.setZero();
+    std::fill(m_b.begin(), m_b.end(), 0.0);
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = cf.getFeatures().begin();
          it_elements != cf.getFeatures().end();
          ++it_elements)
     {
       //find channel_id of current element
-      Int index = Int(cm.getColumnHeaders().find(it_elements->getMapIndex())->second.getMetaValue("channel_id"));
+      Int index = channel_ids.find(it_elements->getMapIndex())->second;
 #ifdef ISOBARIC_QUANT_DEBUG
       std::cout << "  map_index " << it_elements->getMapIndex() << "-> id " << index << " with intensity " << it_elements->getIntensity() << "\n" << std::endl;
 #endif
@@ -192,7 +236,8 @@ namespace OpenMS
   float
   IsobaricIsotopeCorrector::updateOutpuMap_(
     const ConsensusMap& consensus_map_in, ConsensusMap& consensus_map_out,
-    ConsensusMap::size_type current_cf, const Matrix<double>& m_x)
+    ConsensusMap::size_type current_cf, const Matrix<double>& m_x,
+    const ChannelIndexMap& channel_ids)
   {
     float cf_intensity(0);
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = consensus_map_in[current_cf].begin();
@@ -201,7 +246,7 @@ namespace OpenMS
     {
       FeatureHandle handle = *it_elements;
       //find channel_id of current element
-      Int index = Int(consensus_map_out.getColumnHeaders()[it_elements->getMapIndex()].getMetaValue("channel_id"));
+      Int index = channel_ids.find(it_elements->getMapIndex())->second;
       handle.setIntensity(float(m_x(index, 0)));
 
       consensus_map_out[current_cf].insert(handle);
@@ -37,6 +37,16 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/FORMAT/SVOutStream.h>
 
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -69,6 +79,11 @@ SimpleSVM::SimpleSVM():
   defaults_.setValidStrings("no_shrinking",
                             ListUtils::create<String>("true,false"));
 
+  defaults_.setValue("successive_halving", "false",
+                     "Speed up parameter optimization by successive halving: parameter combinations are evaluated on one cross-validation partition after another, and the worse half is discarded after each round. Discarded combinations are reported with a performance of 0.", advanced);
+  defaults_.setValidStrings("successive_halving",
+                            ListUtils::create<String>("true,false"));
+
   defaultsToParam_();
 
   svm_set_print_string_function(&printNull_); // suppress output of LIBSVM
@@ -370,6 +385,79 @@ pair<double, double> SimpleSVM::chooseBestParameters_() const
 }
 
 
+void SimpleSVM::createXvalFolds_(vector<XvalFold_>& folds) const
+{
+  // group observations by class and shuffle each group (with a fixed seed, so
+  // results are reproducible and do not depend on LIBSVM's use of "rand()"):
+  map<double, vector<Size> > class_indexes;
+  for (Size i = 0; i < Size(data_.l); ++i)
+  {
+    class_indexes[data_.y[i]].push_back(i);
+  }
+  boost::mt19937 generator(42);
+  boost::uniform_int<> uni_dist;
+  boost::variate_generator<boost::mt19937&, boost::uniform_int<> >
+    pseudoRNG(generator, uni_dist);
+  // deal observations of each class to the partitions in turn (stratified):
+  vector<Size> fold_assignment(data_.l);
+  Size counter = 0;
+  for (map<double, vector<Size> >::iterator it = class_indexes.begin();
+       it != class_indexes.end(); ++it)
+  {
+    vector<Size>& indexes = it->second;
+    for (vector<Size>::iterator idx_it = indexes.begin() + 1;
+         idx_it < indexes.end(); ++idx_it)
+    {
+      iter_swap(idx_it, indexes.begin() + pseudoRNG((idx_it - indexes.begin()) + 1));
+    }
+    for (vector<Size>::iterator idx_it = indexes.begin();
+         idx_it != indexes.end(); ++idx_it, ++counter)
+    {
+      fold_assignment[*idx_it] = counter % n_parts_;
+    }
+  }
+
+  folds.clear();
+  folds.resize(n_parts_);
+  for (Size i = 0; i < Size(data_.l); ++i)
+  {
+    for (Size fold = 0; fold < n_parts_; ++fold)
+    {
+      // with a single partition, training and test data are the same:
+      if ((fold != fold_assignment[i]) || (n_parts_ == 1))
+      {
+        folds[fold].train_x.push_back(data_.x[i]);
+        folds[fold].train_y.push_back(data_.y[i]);
+      }
+    }
+    folds[fold_assignment[i]].test.push_back(i);
+  }
+}
+
+
+Size SimpleSVM::evaluateXvalFold_(const XvalFold_& fold,
+                                  const struct svm_parameter& params) const
+{
+  // LIBSVM needs non-const pointers, but does not modify the training data:
+  struct svm_problem problem;
+  problem.l = int(fold.train_x.size());
+  problem.x = const_cast<struct svm_node**>(&(fold.train_x[0]));
+  problem.y = const_cast<double*>(&(fold.train_y[0]));
+
+  // training and prediction only use local state (no probability estimates,
+  // so no "rand()" calls), hence this is safe to run in parallel:
+  struct svm_model* model = svm_train(&problem, &params);
+  Size n_correct = 0;
+  for (vector<Size>::const_iterator it = fold.test.begin();
+       it != fold.test.end(); ++it)
+  {
+    if (svm_predict(model, data_.x[*it]) == data_.y[*it]) n_correct++;
+  }
+  svm_free_and_destroy_model(&model);
+  return n_correct;
+}
+
+
 void SimpleSVM::optimizeParameters_()
 {
   log2_C_ = param_.getValue("log2_C");
@@ -381,41 +469,98 @@ void SimpleSVM::optimizeParameters_()
   {
     log2_gamma_ = vector<double>(1, 0.0);
   }
+  bool halving = param_.getValue("successive_halving").toBool();
 
   LOG_INFO << "Running cross-validation to find optimal SVM parameters..." 
            << endl;
+  // the partitions of the data are the same for all parameter combinations:
+  vector<XvalFold_> folds;
+  createXvalFolds_(folds);
+
+  // parameter combinations to test ("C"s vary fastest):
+  Size n_combinations = log2_gamma_.size() * log2_C_.size();
+  vector<Size> candidates(n_combinations);
+  for (Size i = 0; i < n_combinations; ++i) candidates[i] = i;
+  // number of correct predictions per parameter combination and partition:
+  vector<vector<Size> > n_correct(n_combinations, vector<Size>(n_parts_, 0));
+
   Size prog_counter = 0;
   ProgressLogger prog_log;
-  prog_log.startProgress(1, log2_gamma_.size() * log2_C_.size(),
+  prog_log.startProgress(1, n_combinations * n_parts_,
                          "testing SVM parameters");
-  // classification performance for different parameter pairs:
-  performance_.resize(log2_gamma_.size());
-  // vary "C"s in inner loop to keep results for all "C"s in one vector:
-  for (Size g_index = 0; g_index < log2_gamma_.size(); ++g_index)
+  // without successive halving, all partitions are evaluated in one round:
+  Size folds_per_round = halving ? 1 : n_parts_;
+  for (Size first_fold = 0; first_fold < n_parts_;
+       first_fold += folds_per_round)
   {
-    svm_params_.gamma = pow(2.0, log2_gamma_[g_index]);
-    performance_[g_index].resize(log2_C_.size());
-    for (Size c_index = 0; c_index < log2_C_.size(); ++c_index)
+    // all (parameter combination x partition) training jobs of this round
+    // are independent of each other:
+    Size n_folds = min(folds_per_round, n_parts_ - first_fold);
+    SignedSize n_jobs = candidates.size() * n_folds;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize job = 0; job < n_jobs; ++job)
     {
-      svm_params_.C = pow(2.0, log2_C_[c_index]);
-      vector<double> targets(data_.l);
-      svm_cross_validation(&data_, &svm_params_, n_parts_, &(targets[0]));
-      Size n_correct = 0;
-      for (Size i = 0; i < Size(data_.l); ++i)
+      Size combination = candidates[job / n_folds];
+      Size fold = first_fold + job % n_folds;
+      struct svm_parameter params = svm_params_;
+      params.C = pow(2.0, log2_C_[combination % log2_C_.size()]);
+      params.gamma = pow(2.0, log2_gamma_[combination / log2_C_.size()]);
+      n_correct[combination][fold] = evaluateXvalFold_(folds[fold], params);
+
+      IF_MASTERTHREAD prog_log.setProgress(prog_counter);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++prog_counter;
+    }
+
+    // discard the worse half of the parameter combinations:
+    Size n_evaluated = first_fold + n_folds;
+    if (halving && (n_evaluated < n_parts_) && (candidates.size() > 1))
+    {
+      vector<pair<Size, Size> > ranking; // (-correct, combination)
+      for (vector<Size>::iterator it = candidates.begin();
+           it != candidates.end(); ++it)
+      {
+        Size correct = 0;
+        for (Size fold = 0; fold < n_evaluated; ++fold)
+        {
+          correct += n_correct[*it][fold];
+        }
+        ranking.push_back(make_pair(Size(data_.l) - correct, *it));
+      }
+      sort(ranking.begin(), ranking.end());
+      candidates.clear();
+      for (Size i = 0; i < (ranking.size() + 1) / 2; ++i)
       {
-        if (targets[i] == data_.y[i]) n_correct++;
+        candidates.push_back(ranking[i].second);
       }
-      double ratio = n_correct / double(data_.l);
-      performance_[g_index][c_index] = ratio;
-      prog_log.setProgress(++prog_counter);
-      LOG_DEBUG << "Performance (log2_C = " << log2_C_[c_index] 
-                << ", log2_gamma = " << log2_gamma_[g_index] << "): " 
-                << n_correct << " correct (" << float(ratio * 100.0) << "%)"
-                << endl;
+      sort(candidates.begin(), candidates.end());
     }
   }
   prog_log.endProgress();
 
+  // classification performance for different parameter pairs:
+  performance_.assign(log2_gamma_.size(), vector<double>(log2_C_.size(), 0.0));
+  for (vector<Size>::iterator it = candidates.begin(); it != candidates.end();
+       ++it)
+  {
+    Size g_index = *it / log2_C_.size(), c_index = *it % log2_C_.size();
+    Size correct = 0;
+    for (Size fold = 0; fold < n_parts_; ++fold)
+    {
+      correct += n_correct[*it][fold];
+    }
+    double ratio = correct / double(data_.l);
+    performance_[g_index][c_index] = ratio;
+    LOG_DEBUG << "Performance (log2_C = " << log2_C_[c_index] 
+              << ", log2_gamma = " << log2_gamma_[g_index] << "): " 
+              << correct << " correct (" << float(ratio * 100.0) << "%)"
+              << endl;
+  }
+
   pair<double, double> best_params = chooseBestParameters_();
   LOG_INFO << "Best SVM parameters: log2_C = " << best_params.first
            << ", log2_gamma = " << best_params.second << endl;
@@ -423,4 +568,3 @@ void SimpleSVM::optimizeParameters_()
   svm_params_.C = pow(2.0, best_params.first);
   svm_params_.gamma = pow(2.0, best_params.second);
 }
-
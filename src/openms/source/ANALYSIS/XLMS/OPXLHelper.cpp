@@ -52,122 +52,173 @@ namespace OpenMS
     // initialize empty vector for the results
     vector<OPXLDataStructs::XLPrecursor> mass_to_candidates;
 
+    if (peptides.empty() || spectrum_precursors.empty())
+    {
+      return mass_to_candidates;
+    }
+
     double min_precursor = spectrum_precursors[0];
     double max_precursor = spectrum_precursors[spectrum_precursors.size()-1];
+    // mass range of all precursors, used to skip the residue checks for loop-links early
+    std::pair<vector<double>::const_iterator, vector<double>::const_iterator> precursor_range = std::minmax_element(spectrum_precursors.begin(), spectrum_precursors.end());
+
+    // The first peptides are split into blocks of consecutive peptides. Each block collects its candidates
+    // in its own vectors, which are concatenated in block order afterwards. This avoids locking and
+    // results in the same order of candidates as a serial enumeration.
+    const Size n_peptides = peptides.size();
+    const Size n_blocks = std::min(n_peptides, Size(256));
+    vector< vector<OPXLDataStructs::XLPrecursor> > block_candidates(n_blocks);
+    vector< vector< int > > block_correction_positions(n_blocks);
 
 #ifdef _OPENMP
-#pragma omp parallel for schedule(guided)
+#pragma omp parallel for schedule(dynamic)
 #endif
-    for (SignedSize p1 = 0; p1 < static_cast<SignedSize>(peptides.size()); ++p1)
+    for (SignedSize block = 0; block < static_cast<SignedSize>(n_blocks); ++block)
     {
-      // get the amino acid sequence of this peptide as a character string
-      String seq_first = peptides[p1].peptide_seq.toUnmodifiedString();
+      vector<OPXLDataStructs::XLPrecursor>& candidates = block_candidates[block];
+      vector< int >& correction_positions = block_correction_positions[block];
 
-      // generate mono-links: one cross-linker with one peptide attached to one side
-      for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
-      {
-        // Monoisotopic weight of the peptide + cross-linker
-        double cross_linked_pair_mass = peptides[p1].peptide_mass + cross_link_mass_mono_link[i];
-
-        // Make sure it is clear only one peptide is considered here. Use an out-of-range value for the second peptide.
-        // to check: if(precursor.beta_index < peptides.size()) returns "false" for a mono-link
-        OPXLDataStructs::XLPrecursor precursor;
-        precursor.precursor_mass = cross_linked_pair_mass;
-        precursor.alpha_index = p1;
-        precursor.beta_index = peptides.size() + 1; // an out-of-range index to represent an empty index
-
-        // call function to compare with spectrum precursor masses
-        // will only add this candidate, if the mass is within the given tolerance to any precursor in the spectra data
-        // after the first monolink is added, stop enumerating masses (if other candidates fit within the same precursor, they will have exactly the same fragment matching)
-        if (filter_and_add_candidate(mass_to_candidates, spectrum_precursors, precursor_correction_positions, precursor_mass_tolerance_unit_ppm, precursor_mass_tolerance, precursor))
-        {
-          break;
-        }
-      }
+      // index of the lightest peptide that can be the second peptide of a cross-link,
+      // moves towards lighter peptides while the first peptide gets heavier (two-pointer search)
+      Size p2_begin = 0;
+      bool p2_begin_initialized = false;
 
-       // test if this peptide could have loop-links: one cross-link with both sides attached to the same peptide
-       // TODO check for distance between the two linked residues
-      bool first_res = false; // is there a residue the first side of the linker can attach to?
-      bool second_res = false; // is there a residue the second side of the linker can attach to?
-      for (Size k = 0; k < seq_first.size()-1; ++k)
+      for (Size p1 = n_peptides * block / n_blocks; p1 < n_peptides * (block + 1) / n_blocks; ++p1)
       {
-        for (Size i = 0; i < cross_link_residue1.size(); ++i)
+        // generate mono-links: one cross-linker with one peptide attached to one side
+        for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
         {
-          if (cross_link_residue1[i].size() == 1 && seq_first.substr(k, 1) == cross_link_residue1[i])
+          // Monoisotopic weight of the peptide + cross-linker
+          double cross_linked_pair_mass = peptides[p1].peptide_mass + cross_link_mass_mono_link[i];
+
+          // Make sure it is clear only one peptide is considered here. Use an out-of-range value for the second peptide.
+          // to check: if(precursor.beta_index < peptides.size()) returns "false" for a mono-link
+          OPXLDataStructs::XLPrecursor precursor;
+          precursor.precursor_mass = cross_linked_pair_mass;
+          precursor.alpha_index = p1;
+          precursor.beta_index = peptides.size() + 1; // an out-of-range index to represent an empty index
+
+          // call function to compare with spectrum precursor masses
+          // will only add this candidate, if the mass is within the given tolerance to any precursor in the spectra data
+          // after the first monolink is added, stop enumerating masses (if other candidates fit within the same precursor, they will have exactly the same fragment matching)
+          if (filter_and_add_candidate(candidates, spectrum_precursors, correction_positions, precursor_mass_tolerance_unit_ppm, precursor_mass_tolerance, precursor))
           {
-            first_res = true;
+            break;
           }
         }
-        for (Size i = 0; i < cross_link_residue2.size(); ++i)
+
+        // loop-links: one cross-link with both sides attached to the same peptide
+        // also only one peptide
+        OPXLDataStructs::XLPrecursor loop_precursor;
+        loop_precursor.precursor_mass = peptides[p1].peptide_mass + cross_link_mass;
+        loop_precursor.alpha_index = p1;
+        loop_precursor.beta_index = peptides.size() + 1; // an out-of-range index to represent an empty index
+
+        // only look for linkable residues, if the mass can fit to any precursor at all
+        double loop_error = precursor_mass_tolerance_unit_ppm ? loop_precursor.precursor_mass * precursor_mass_tolerance * 1e-6 : precursor_mass_tolerance;
+        if (loop_precursor.precursor_mass + loop_error >= *precursor_range.first && loop_precursor.precursor_mass - loop_error <= *precursor_range.second)
         {
-          if (cross_link_residue2[i].size() == 1 && seq_first.substr(k, 1) == cross_link_residue2[i])
+          // get the amino acid sequence of this peptide as a character string
+          String seq_first = peptides[p1].peptide_seq.toUnmodifiedString();
+
+          // test if this peptide could have loop-links
+          // TODO check for distance between the two linked residues
+          bool first_res = false; // is there a residue the first side of the linker can attach to?
+          bool second_res = false; // is there a residue the second side of the linker can attach to?
+          for (Size k = 0; k < seq_first.size()-1; ++k)
           {
-            second_res = true;
+            for (Size i = 0; i < cross_link_residue1.size(); ++i)
+            {
+              if (cross_link_residue1[i].size() == 1 && seq_first[k] == cross_link_residue1[i][0])
+              {
+                first_res = true;
+              }
+            }
+            for (Size i = 0; i < cross_link_residue2.size(); ++i)
+            {
+              if (cross_link_residue2[i].size() == 1 && seq_first[k] == cross_link_residue2[i][0])
+              {
+                second_res = true;
+              }
+            }
           }
-        }
-      }
 
-      // If both sides of a cross-linker can link to this peptide, generate the loop-link
-      if (first_res && second_res)
-      {
-        // Monoisotopic weight of the peptide + cross-linker
-        double cross_linked_pair_mass = peptides[p1].peptide_mass + cross_link_mass;
-
-        // also only one peptide
-        OPXLDataStructs::XLPrecursor precursor;
-        precursor.precursor_mass = cross_linked_pair_mass;
-        precursor.alpha_index = p1;
-        precursor.beta_index = peptides.size() + 1; // an out-of-range index to represent an empty index
-
-        // call function to compare with spectrum precursor masses
-        filter_and_add_candidate(mass_to_candidates, spectrum_precursors, precursor_correction_positions, precursor_mass_tolerance_unit_ppm, precursor_mass_tolerance, precursor);
-      }
+          // If both sides of a cross-linker can link to this peptide, generate the loop-link
+          if (first_res && second_res)
+          {
+            // call function to compare with spectrum precursor masses
+            filter_and_add_candidate(candidates, spectrum_precursors, correction_positions, precursor_mass_tolerance_unit_ppm, precursor_mass_tolerance, loop_precursor);
+          }
+        }
 
-      // check for minimal mass of second peptide, jump farther than current peptide if possible
-      double allowed_error = 0;
-      if (precursor_mass_tolerance_unit_ppm) // ppm
-      {
-        allowed_error = min_precursor * precursor_mass_tolerance * 1e-6;
-      }
-      else // Dalton
-      {
-        allowed_error = precursor_mass_tolerance;
-      }
-      double min_second_peptide_mass = min_precursor - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
+        // check for minimal mass of second peptide, jump farther than current peptide if possible
+        double allowed_error = 0;
+        if (precursor_mass_tolerance_unit_ppm) // ppm
+        {
+          allowed_error = min_precursor * precursor_mass_tolerance * 1e-6;
+        }
+        else // Dalton
+        {
+          allowed_error = precursor_mass_tolerance;
+        }
+        double min_second_peptide_mass = min_precursor - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
 
-      if (precursor_mass_tolerance_unit_ppm) // ppm
-      {
-        allowed_error = max_precursor * precursor_mass_tolerance * 1e-6;
-      }
-      double max_second_peptide_mass = max_precursor - cross_link_mass - peptides[p1].peptide_mass + allowed_error;
+        if (precursor_mass_tolerance_unit_ppm) // ppm
+        {
+          allowed_error = max_precursor * precursor_mass_tolerance * 1e-6;
+        }
+        double max_second_peptide_mass = max_precursor - cross_link_mass - peptides[p1].peptide_mass + allowed_error;
 
-      // Generate cross-links: one cross-linker linking two separate peptides, the most important case
-      // Loop over all p2 peptide candidates, that come after p1 in the list
-      for (Size p2 = p1; p2 < peptides.size(); ++p2)
-      {
-        // skip peptides, that are too small in any case
-        if (peptides[p2].peptide_mass < min_second_peptide_mass)
+        // the peptides are sorted by mass and min_second_peptide_mass decreases with every p1,
+        // so the start of the range of possible second peptides only moves towards lighter peptides
+        if (!p2_begin_initialized)
         {
-          continue;
+          p2_begin = lower_bound(peptides.begin(), peptides.end(), min_second_peptide_mass, OPXLDataStructs::AASeqWithMassComparator()) - peptides.begin();
+          p2_begin_initialized = true;
         }
-        else if (peptides[p2].peptide_mass > max_second_peptide_mass)
+        while (p2_begin > 0 && peptides[p2_begin - 1].peptide_mass >= min_second_peptide_mass)
         {
-          break;
+          --p2_begin;
         }
 
-        // Monoisotopic weight of the first peptide + the second peptide + cross-linker
-        double cross_linked_pair_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
+        // Generate cross-links: one cross-linker linking two separate peptides, the most important case
+        // Loop over all p2 peptide candidates, that come after p1 in the list and are heavy enough
+        for (Size p2 = std::max(p1, p2_begin); p2 < n_peptides; ++p2)
+        {
+          if (peptides[p2].peptide_mass > max_second_peptide_mass)
+          {
+            break;
+          }
+
+          // Monoisotopic weight of the first peptide + the second peptide + cross-linker
+          double cross_linked_pair_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
 
-        // this time both peptides have valid indices
-        OPXLDataStructs::XLPrecursor precursor;
-        precursor.precursor_mass = cross_linked_pair_mass;
-        precursor.alpha_index = p1;
-        precursor.beta_index = p2;
+          // this time both peptides have valid indices
+          OPXLDataStructs::XLPrecursor precursor;
+          precursor.precursor_mass = cross_linked_pair_mass;
+          precursor.alpha_index = p1;
+          precursor.beta_index = p2;
 
-        // call function to compare with spectrum precursor masses
-        filter_and_add_candidate(mass_to_candidates, spectrum_precursors, precursor_correction_positions, precursor_mass_tolerance_unit_ppm, precursor_mass_tolerance, precursor);
+          // call function to compare with spectrum precursor masses
+          filter_and_add_candidate(candidates, spectrum_precursors, correction_positions, precursor_mass_tolerance_unit_ppm, precursor_mass_tolerance, precursor);
+        }
       }
     } // end of parallelized for-loop
+
+    // concatenate the candidates of all blocks in order
+    Size n_candidates = 0;
+    for (Size block = 0; block < n_blocks; ++block)
+    {
+      n_candidates += block_candidates[block].size();
+    }
+    mass_to_candidates.reserve(n_candidates);
+    precursor_correction_positions.reserve(precursor_correction_positions.size() + n_candidates);
+    for (Size block = 0; block < n_blocks; ++block)
+    {
+      mass_to_candidates.insert(mass_to_candidates.end(), block_candidates[block].begin(), block_candidates[block].end());
+      precursor_correction_positions.insert(precursor_correction_positions.end(), block_correction_positions[block].begin(), block_correction_positions[block].end());
+      vector<OPXLDataStructs::XLPrecursor>().swap(block_candidates[block]);
+    }
     return mass_to_candidates;
   }
 
@@ -195,12 +246,9 @@ namespace OpenMS
 
     if (low_it != up_it) // if they are not equal, there are matching precursors in the data
     {
-#pragma omp critical (mass_to_candidates_access)
-      {
-        mass_to_candidates.push_back(precursor);
-        // take the position of the highest matching precursor mass in the vector (prioritize smallest correction)
-        precursor_correction_positions.push_back(std::distance(spectrum_precursors.begin(), std::prev(up_it, 1)));
-      }
+      mass_to_candidates.push_back(precursor);
+      // take the position of the highest matching precursor mass in the vector (prioritize smallest correction)
+      precursor_correction_positions.push_back(std::distance(spectrum_precursors.begin(), std::prev(up_it, 1)));
       return true;
     }
     else
@@ -223,14 +271,14 @@ namespace OpenMS
     return modifications;
   }
 
-  std::vector<OPXLDataStructs::AASeqWithMass> OPXLHelper::digestDatabase(vector<FASTAFile::FASTAEntry> fasta_db, EnzymaticDigestion digestor, Size min_peptide_length, StringList cross_link_residue1, StringList cross_link_residue2, std::vector<ResidueModification> fixed_modifications, std::vector<ResidueModification> variable_modifications, Size max_variable_mods_per_peptide)
+  std::vector<OPXLDataStructs::AASeqWithMass> OPXLHelper::digestDatabase(const vector<FASTAFile::FASTAEntry>& fasta_db, const EnzymaticDigestion& digestor, Size min_peptide_length, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const std::vector<ResidueModification>& fixed_modifications, const std::vector<ResidueModification>& variable_modifications, Size max_variable_mods_per_peptide)
   {
     multimap<StringView, AASequence> processed_peptides;
     vector<OPXLDataStructs::AASeqWithMass> peptide_masses;
 
     bool n_term_linker = false;
     bool c_term_linker = false;
-    for (String res : cross_link_residue1)
+    for (const String& res : cross_link_residue1)
     {
       if (res == "N-term")
       {
@@ -241,7 +289,7 @@ namespace OpenMS
         c_term_linker = true;
       }
     }
-    for (String res : cross_link_residue2)
+    for (const String& res : cross_link_residue2)
     {
       if (res == "N-term")
       {
@@ -287,14 +335,14 @@ namespace OpenMS
         }
         else
         {
-          for (String res : cross_link_residue1)
+          for (const String& res : cross_link_residue1)
           {
             if (res.size() == 1 && (cit->getString().find(res) < cit->getString().size()-1))
             {
               skip = false;
             }
           }
-          for (String res : cross_link_residue2)
+          for (const String& res : cross_link_residue2)
           {
             if (res.size() == 1 && (cit->getString().find(res) < cit->getString().size()-1))
             {
@@ -352,7 +400,7 @@ namespace OpenMS
   {
     bool n_term_linker = false;
     bool c_term_linker = false;
-    for (String res : cross_link_residue1)
+    for (const String& res : cross_link_residue1)
     {
       if (res == "N-term")
       {
@@ -363,7 +411,7 @@ namespace OpenMS
         c_term_linker = true;
       }
     }
-    for (String res : cross_link_residue2)
+    for (const String& res : cross_link_residue2)
     {
       if (res == "N-term")
       {
@@ -1116,7 +1164,7 @@ namespace OpenMS
     return new_peptide_ids;
   }
 
-  std::vector <OPXLDataStructs::ProteinProteinCrossLink> OPXLHelper::collectPrecursorCandidates(const IntList& precursor_correction_steps, double precursor_mass, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm, const vector<OPXLDataStructs::AASeqWithMass>& filtered_peptide_masses, double cross_link_mass, DoubleList cross_link_mass_mono_link, StringList cross_link_residue1, StringList cross_link_residue2, String cross_link_name)
+  std::vector <OPXLDataStructs::ProteinProteinCrossLink> OPXLHelper::collectPrecursorCandidates(const IntList& precursor_correction_steps, double precursor_mass, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm, const vector<OPXLDataStructs::AASeqWithMass>& filtered_peptide_masses, double cross_link_mass, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const String& cross_link_name)
   {
     // determine candidates
     std::vector< OPXLDataStructs::XLPrecursor > candidates;
@@ -429,9 +429,15 @@ using namespace OpenMS;
     progresslogger.startProgress(0, 1, "Matching to theoretical spectra and scoring...");
     Size spectrum_counter = 0;
 
-// #ifdef _OPENMP
-// #pragma omp parallel for schedule(guided)
-// #endif
+    // The spectrum generators are only used through const member functions and
+    // everything else written in the loop is local to the current pair. The top
+    // CSMs of each pair are stored in their own slot and collected in pair order
+    // after the loop, so the output does not depend on the number of threads.
+    vector< vector< OPXLDataStructs::CrossLinkSpectrumMatch > > top_csms_per_pair(spectrum_pairs.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (SignedSize pair_index = 0; pair_index < static_cast<SignedSize>(spectrum_pairs.size()); ++pair_index)
     {
       Size scan_index = spectrum_pairs[pair_index].first;
@@ -450,7 +456,7 @@ using namespace OpenMS;
       const PeakSpectrum& xlink_peaks = preprocessed_pair_spectra.spectra_xlink_peaks[pair_index];
       const PeakSpectrum& all_peaks = preprocessed_pair_spectra.spectra_all_peaks[pair_index];
 
-      vector< OPXLDataStructs::CrossLinkSpectrumMatch > top_csms_spectrum;
+      vector< OPXLDataStructs::CrossLinkSpectrumMatch >& top_csms_spectrum = top_csms_per_pair[pair_index];
 
       // ignore this spectrum pair, if they have less paired peaks than the minimal peptide size
       if (all_peaks.size() < peptide_min_size_)
@@ -477,9 +483,7 @@ using namespace OpenMS;
 
       vector< OPXLDataStructs::CrossLinkSpectrumMatch > mainscore_csms_spectrum;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(guided)
-#endif
+      // parallelization happens over the spectrum pairs, the candidates are scored in their given order
       for (SignedSize i = 0; i < static_cast<SignedSize>(cross_link_candidates.size()); ++i)
       {
         OPXLDataStructs::ProteinProteinCrossLink cross_link_candidate = cross_link_candidates[i];
@@ -600,7 +604,6 @@ using namespace OpenMS;
         csm.match_odds_beta = match_odds_beta;
         csm.precursor_error_ppm = rel_error;
 
-#pragma omp critical (mainscore_csms_spectrum_access)
         mainscore_csms_spectrum.push_back(csm);
       }
       // progresslogger.endProgress();
@@ -1071,30 +1074,22 @@ using namespace OpenMS;
         top_csms_spectrum.push_back(all_csms_spectrum[top]);
       }
 
-      Size all_top_csms_current_index = 0;
-#ifdef _OPENMP
-#pragma omp critical (all_top_csms_access)
-#endif
-      {
-        if (!top_csms_spectrum.empty())
-        {
-          all_top_csms.push_back(top_csms_spectrum);
-          all_top_csms_current_index = all_top_csms.size()-1;
-        }
-      }
-
-      // Write PeptideIdentifications and PeptideHits for n top hits of this spectrum
-      if (!top_csms_spectrum.empty())
-      {
-        OPXLHelper::buildPeptideIDs(peptide_ids, top_csms_spectrum, all_top_csms, all_top_csms_current_index, spectra, scan_index, scan_index_heavy);
-      }
-
 #ifdef DEBUG_OPENPEPXLALGO
 #pragma omp critical (LOG_DEBUG_access)
       LOG_DEBUG << "Next Spectrum #############################################" << endl;
 #endif
     } // end of matching / scoring, end of parallel for-loop
 
+    // Write PeptideIdentifications and PeptideHits for n top hits of each spectrum pair
+    for (Size pair_index = 0; pair_index < spectrum_pairs.size(); ++pair_index)
+    {
+      if (top_csms_per_pair[pair_index].empty()) continue;
+
+      all_top_csms.push_back(top_csms_per_pair[pair_index]);
+      OPXLHelper::buildPeptideIDs(peptide_ids, top_csms_per_pair[pair_index], all_top_csms, all_top_csms.size() - 1, spectra, spectrum_pairs[pair_index].first, spectrum_pairs[pair_index].second);
+      top_csms_per_pair[pair_index].clear();
+    }
+
     progresslogger.endProgress();
 
 #ifdef DEBUG_OPENPEPXLALGO
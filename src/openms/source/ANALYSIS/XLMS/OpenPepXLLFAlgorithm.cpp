@@ -392,9 +392,16 @@ using namespace OpenMS;
     LOG_DEBUG << "Spectra left after preprocessing and filtering: " << spectra.size() << " of " << unprocessed_spectra.size() << endl;
 #endif
 
-// #ifdef _OPENMP
-// #pragma omp parallel for schedule(guided)
-// #endif
+    // The spectrum generators are only used through const member functions and
+    // everything else written in the loop is local to the current spectrum. The
+    // top CSMs of each spectrum are stored in their own slot and collected in
+    // spectrum order after the loop, so the output does not depend on the number
+    // of threads.
+    vector< vector< OPXLDataStructs::CrossLinkSpectrumMatch > > top_csms_per_spectrum(spectra.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for (SignedSize scan_index = 0; scan_index < static_cast<SignedSize>(spectra.size()); ++scan_index)
     {
       const PeakSpectrum& spectrum = spectra[scan_index];
@@ -403,7 +410,7 @@ using namespace OpenMS;
       const double precursor_mz = spectrum.getPrecursors()[0].getMZ();
       const double precursor_mass = (precursor_mz * static_cast<double>(precursor_charge)) - (static_cast<double>(precursor_charge) * Constants::PROTON_MASS_U);
 
-      vector< OPXLDataStructs::CrossLinkSpectrumMatch > top_csms_spectrum;
+      vector< OPXLDataStructs::CrossLinkSpectrumMatch >& top_csms_spectrum = top_csms_per_spectrum[scan_index];
       vector< OPXLDataStructs::ProteinProteinCrossLink > cross_link_candidates = OPXLHelper::collectPrecursorCandidates(precursor_correction_steps_, precursor_mass, precursor_mass_tolerance_, precursor_mass_tolerance_unit_ppm_, filtered_peptide_masses, cross_link_mass_, cross_link_mass_mono_link_, cross_link_residue1_, cross_link_residue2_, cross_link_name_);
 
 #ifdef DEBUG_OPENPEPXLLFALGO
@@ -425,9 +432,7 @@ using namespace OpenMS;
 
       vector< OPXLDataStructs::CrossLinkSpectrumMatch > mainscore_csms_spectrum;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(guided)
-#endif
+      // parallelization happens over the spectra, the candidates are scored in their given order
       for (SignedSize i = 0; i < static_cast<SignedSize>(cross_link_candidates.size()); ++i)
       {
         OPXLDataStructs::ProteinProteinCrossLink cross_link_candidate = cross_link_candidates[i];
@@ -539,7 +544,6 @@ using namespace OpenMS;
         csm.match_odds_beta = match_odds_beta;
         csm.precursor_error_ppm = rel_error;
 
-#pragma omp critical (mainscore_csms_spectrum_access)
         mainscore_csms_spectrum.push_back(csm);
 
       }
@@ -956,30 +960,22 @@ using namespace OpenMS;
         all_csms_spectrum[top].rank = top+1;
         top_csms_spectrum.push_back(all_csms_spectrum[top]);
       }
-
-      Size all_top_csms_current_index = 0;
-#ifdef _OPENMP
-#pragma omp critical (all_top_csms_access)
-#endif
-      {
-        if (!top_csms_spectrum.empty())
-        {
-          all_top_csms.push_back(top_csms_spectrum);
-          all_top_csms_current_index = all_top_csms.size()-1;
-        }
-      }
-
-      // Write PeptideIdentifications and PeptideHits for n top hits
-      if (!top_csms_spectrum.empty())
-      {
-        OPXLHelper::buildPeptideIDs(peptide_ids, top_csms_spectrum, all_top_csms, all_top_csms_current_index, spectra, scan_index, scan_index);
-      }
 #ifdef DEBUG_OPENPEPXLLFALGO
 #pragma omp critical (LOG_DEBUG_access)
       LOG_DEBUG << "Next Spectrum ##################################" << endl;
 #endif
     }
 
+    // Write PeptideIdentifications and PeptideHits for n top hits of each spectrum
+    for (Size scan_index = 0; scan_index < spectra.size(); ++scan_index)
+    {
+      if (top_csms_per_spectrum[scan_index].empty()) continue;
+
+      all_top_csms.push_back(top_csms_per_spectrum[scan_index]);
+      OPXLHelper::buildPeptideIDs(peptide_ids, top_csms_per_spectrum[scan_index], all_top_csms, all_top_csms.size() - 1, spectra, scan_index, scan_index);
+      top_csms_per_spectrum[scan_index].clear();
+    }
+
     // end of matching / scoring
     progresslogger.endProgress();
 
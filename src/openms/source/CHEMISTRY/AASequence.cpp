@@ -42,6 +42,8 @@
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/CONCEPT/PrecisionWrapper.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -1302,13 +1304,33 @@ namespace OpenMS
         specificity = ResidueModification::C_TERM;
       }
      
-      if (*str_it == '(')
-      {
-        str_it = parseModRoundBrackets_(str_it, peptide, aas, specificity);
-      }
-      else if (*str_it == '[')
+      if (*str_it == '(' || *str_it == '[')
       {
-        str_it = parseModSquareBrackets_(str_it, peptide, aas, specificity);
+        // resolving a modification may add entries to the (shared) residue and
+        // modification DBs, so only one thread at a time may do it (e.g. when
+        // files are loaded concurrently); exceptions must not leave the critical section
+        std::exception_ptr mod_exception;
+#ifdef _OPENMP
+#pragma omp critical (AASequence_parseModification)
+#endif
+        {
+          try
+          {
+            if (*str_it == '(')
+            {
+              str_it = parseModRoundBrackets_(str_it, peptide, aas, specificity);
+            }
+            else
+            {
+              str_it = parseModSquareBrackets_(str_it, peptide, aas, specificity);
+            }
+          }
+          catch (...)
+          {
+            mod_exception = std::current_exception();
+          }
+        }
+        if (mod_exception) std::rethrow_exception(mod_exception);
       }
       else
       {
@@ -33,8 +33,12 @@
 // --------------------------------------------------------------------------
 //
 
+#include <fstream>
 #include <iostream>
 #include <OpenMS/CHEMISTRY/MASSDECOMPOSITION/IMS/RealMassDecomposer.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 namespace OpenMS
 {
@@ -47,11 +51,40 @@ namespace OpenMS
 
       rounding_errors_ = std::make_pair(weights.getMinRoundingError(), weights.getMaxRoundingError());
       precision_ = weights.getPrecision();
-      decomposer_ = std::shared_ptr<integer_decomposer_type>(
+      decomposer_ = std::shared_ptr<const integer_decomposer_type>(
         new integer_decomposer_type(weights));
     }
 
-    RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error)
+    RealMassDecomposer::RealMassDecomposer(const Weights & weights, const std::string & table_file) :
+      weights_(weights)
+    {
+      rounding_errors_ = std::make_pair(weights.getMinRoundingError(), weights.getMaxRoundingError());
+      precision_ = weights.getPrecision();
+
+      std::ifstream is(table_file.c_str(), std::ios::binary);
+      if (!is)
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, table_file);
+      }
+      decomposer_ = std::shared_ptr<const integer_decomposer_type>(
+        new integer_decomposer_type(weights, is));
+    }
+
+    void RealMassDecomposer::storeTable(const std::string & table_file) const
+    {
+      std::ofstream os(table_file.c_str(), std::ios::binary);
+      if (!os)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, table_file);
+      }
+      decomposer_->store(os);
+      if (!os)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, table_file);
+      }
+    }
+
+    RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error) const
     {
       // defines the range of integers to be decomposed
       integer_value_type start_integer_mass = static_cast<integer_value_type>(
@@ -89,7 +122,7 @@ namespace OpenMS
     }
 
     RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error,
-                                                                                  const constraints_type & constraints)
+                                                                                  const constraints_type & constraints) const
     {
 
       // defines the range of integers to be decomposed
@@ -148,7 +181,31 @@ namespace OpenMS
       return all_decompositions_from_range;
     }
 
-    RealMassDecomposer::number_of_decompositions_type RealMassDecomposer::getNumberOfDecompositions(double mass, double error)
+    std::vector<RealMassDecomposer::decompositions_type> RealMassDecomposer::getDecompositions(const std::vector<double> & masses, double error) const
+    {
+      std::vector<decompositions_type> all_decompositions(masses.size());
+
+      ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)masses.size(); ++i)
+      {
+        try
+        {
+          all_decompositions[i] = getDecompositions(masses[i], error);
+        }
+        catch (...)
+        {
+          exceptions.capture();
+        }
+      }
+      exceptions.rethrow();
+
+      return all_decompositions;
+    }
+
+    RealMassDecomposer::number_of_decompositions_type RealMassDecomposer::getNumberOfDecompositions(double mass, double error) const
     {
       // defines the range of integers to be decomposed
       integer_value_type start_integer_mass = static_cast<integer_value_type>(1);
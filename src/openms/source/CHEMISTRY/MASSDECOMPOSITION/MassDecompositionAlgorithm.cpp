@@ -74,7 +74,7 @@ namespace OpenMS
     delete decomposer_;
   }
 
-  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass)
+  void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass) const
   {
     double tolerance((double) param_.getValue("tolerance"));
     ims::RealMassDecomposer::decompositions_type decompositions = decomposer_->getDecompositions(mass, tolerance);
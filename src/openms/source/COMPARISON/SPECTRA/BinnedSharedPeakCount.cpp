@@ -87,4 +87,28 @@ namespace OpenMS
     return static_cast<double>(s.nonZeros()) / denominator;
   }
 
+  void BinnedSharedPeakCount::compareRange_(const std::vector<BinnedSpectrum>& queries, Size q_begin, Size q_end,
+                                            const std::vector<BinnedSpectrum>& targets, Size t_begin, Size t_end,
+                                            SimilarityMatrix& scores) const
+  {
+    const BinnedSpectrum::SparseVectorIndexType rows = max(getBinsEnd_(queries, q_begin, q_end), getBinsEnd_(targets, t_begin, t_end));
+    StackedBinsType q, t;
+    stackBins_(queries, q_begin, q_end, rows, true, q);
+    stackBins_(targets, t_begin, t_end, rows, true, t);
+
+    // number of shared bins for all pairs at once (exact, counts are small integers)
+    StackedBinsType shared = q.transpose() * t;
+    scores = SimilarityMatrix(shared.cast<double>());
+
+    // resulting score normalized to interval [0,1]
+    for (Size j = t_begin; j < t_end; ++j)
+    {
+      for (Size i = q_begin; i < q_end; ++i)
+      {
+        size_t denominator(max(queries[i].getBins().nonZeros(), targets[j].getBins().nonZeros()));
+        scores(i - q_begin, j - t_begin) /= denominator;
+      }
+    }
+  }
+
 }
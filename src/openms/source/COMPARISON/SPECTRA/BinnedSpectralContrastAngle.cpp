@@ -85,5 +85,37 @@ namespace OpenMS
 
     return score;
   }
-}
 
+  void BinnedSpectralContrastAngle::compareRange_(const std::vector<BinnedSpectrum>& queries, Size q_begin, Size q_end,
+                                                  const std::vector<BinnedSpectrum>& targets, Size t_begin, Size t_end,
+                                                  SimilarityMatrix& scores) const
+  {
+    const BinnedSpectrum::SparseVectorIndexType rows = max(getBinsEnd_(queries, q_begin, q_end), getBinsEnd_(targets, t_begin, t_end));
+    StackedBinsType q, t;
+    stackBins_(queries, q_begin, q_end, rows, false, q);
+    stackBins_(targets, t_begin, t_end, rows, false, t);
+
+    // all numerators at once
+    StackedBinsType numerators = q.transpose() * t;
+    scores = SimilarityMatrix(numerators.cast<double>());
+
+    vector<double> sum1(q_end - q_begin), sum2(t_end - t_begin);
+    for (Size i = q_begin; i < q_end; ++i)
+    {
+      sum1[i - q_begin] = queries[i].getBins().dot(queries[i].getBins());
+    }
+    for (Size j = t_begin; j < t_end; ++j)
+    {
+      sum2[j - t_begin] = targets[j].getBins().dot(targets[j].getBins());
+    }
+
+    // resulting score standardized to interval [0,1]
+    for (Size j = 0; j < sum2.size(); ++j)
+    {
+      for (Size i = 0; i < sum1.size(); ++i)
+      {
+        scores(i, j) /= sqrt(sum1[i] * sum2[j]);
+      }
+    }
+  }
+}
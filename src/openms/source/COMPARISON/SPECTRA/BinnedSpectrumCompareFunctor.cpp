@@ -38,7 +38,12 @@
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSumAgreeingIntensities.h>
 #include <OpenMS/CONCEPT/Factory.h>
 
+#include <algorithm>
+#include <queue>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace std;
 
@@ -74,4 +79,142 @@ namespace OpenMS
     Factory<BinnedSpectrumCompareFunctor>::registerProduct(BinnedSumAgreeingIntensities::getProductName(), &BinnedSumAgreeingIntensities::create);
   }
 
+  void BinnedSpectrumCompareFunctor::compareBlock(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& targets, SimilarityMatrix& scores) const
+  {
+    compareRange_(queries, 0, queries.size(), targets, 0, targets.size(), scores);
+  }
+
+  void BinnedSpectrumCompareFunctor::compareRange_(const std::vector<BinnedSpectrum>& queries, Size q_begin, Size q_end,
+                                                   const std::vector<BinnedSpectrum>& targets, Size t_begin, Size t_end,
+                                                   SimilarityMatrix& scores) const
+  {
+    scores.resize(q_end - q_begin, t_end - t_begin);
+    for (Size i = q_begin; i < q_end; ++i)
+    {
+      for (Size j = t_begin; j < t_end; ++j)
+      {
+        scores(i - q_begin, j - t_begin) = operator()(queries[i], targets[j]);
+      }
+    }
+  }
+
+  // static
+  void BinnedSpectrumCompareFunctor::stackBins_(const std::vector<BinnedSpectrum>& spectra, Size begin, Size end, BinnedSpectrum::SparseVectorIndexType rows, bool binary, StackedBinsType& stacked)
+  {
+    Size nnz(0);
+    for (Size i = begin; i < end; ++i)
+    {
+      nnz += spectra[i].getBins().nonZeros();
+    }
+
+    // bins of a sparse vector are sorted by index, so columns can be filled in order
+    stacked.resize(rows, end - begin);
+    stacked.setZero();
+    stacked.reserve(nnz);
+    for (Size i = begin; i < end; ++i)
+    {
+      stacked.startVec(i - begin);
+      for (BinnedSpectrum::SparseVectorIteratorType it(spectra[i].getBins()); it; ++it)
+      {
+        stacked.insertBack(it.index(), i - begin) = binary ? 1.0f : it.value();
+      }
+    }
+    stacked.finalize();
+  }
+
+  // static
+  BinnedSpectrum::SparseVectorIndexType BinnedSpectrumCompareFunctor::getBinsEnd_(const std::vector<BinnedSpectrum>& spectra, Size begin, Size end)
+  {
+    BinnedSpectrum::SparseVectorIndexType bins_end(0);
+    for (Size i = begin; i < end; ++i)
+    {
+      const BinnedSpectrum::SparseVectorType& bins = spectra[i].getBins();
+      if (bins.nonZeros() > 0)
+      {
+        // indices are sorted, so the last one is the highest
+        bins_end = std::max(bins_end, BinnedSpectrum::SparseVectorIndexType(bins.innerIndexPtr()[bins.nonZeros() - 1] + 1));
+      }
+    }
+    return bins_end;
+  }
+
+  void BinnedSpectrumCompareFunctor::getTopNeighbors(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& targets, Size k, std::vector<std::vector<Neighbor> >& neighbors, Size block_size) const
+  {
+    neighbors.clear();
+    neighbors.resize(queries.size());
+    if (k == 0 || queries.empty() || targets.empty())
+    {
+      return;
+    }
+    if (block_size == 0)
+    {
+      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Block size must be positive.");
+    }
+
+    const bool same_set = (&queries == &targets);
+
+    // 'better' neighbours: higher score first, lower index on ties (for deterministic output)
+    auto better = [](const Neighbor& a, const Neighbor& b)
+    {
+      return a.second > b.second || (a.second == b.second && a.first < b.first);
+    };
+
+    const SignedSize n_query_blocks = (queries.size() + block_size - 1) / block_size;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize qb = 0; qb < n_query_blocks; ++qb)
+    {
+      const Size q_begin = qb * block_size;
+      const Size q_end = std::min(q_begin + block_size, queries.size());
+
+      // one heap per query, holding the k best neighbours seen so far (worst on top)
+      typedef std::priority_queue<Neighbor, std::vector<Neighbor>, decltype(better)> NeighborHeap;
+      std::vector<NeighborHeap> heaps(q_end - q_begin, NeighborHeap(better));
+
+      SimilarityMatrix scores;
+      for (Size t_begin = 0; t_begin < targets.size(); t_begin += block_size)
+      {
+        const Size t_end = std::min(t_begin + block_size, targets.size());
+        compareRange_(queries, q_begin, q_end, targets, t_begin, t_end, scores);
+
+        for (Size i = q_begin; i < q_end; ++i)
+        {
+          NeighborHeap& heap = heaps[i - q_begin];
+          for (Size j = t_begin; j < t_end; ++j)
+          {
+            const double score = scores(i - q_begin, j - t_begin);
+            if (!(score > 0.0) || (same_set && i == j))
+            {
+              continue; // also skips NaN
+            }
+            const Neighbor candidate(j, score);
+            if (heap.size() < k)
+            {
+              heap.push(candidate);
+            }
+            else if (better(candidate, heap.top()))
+            {
+              heap.pop();
+              heap.push(candidate);
+            }
+          }
+        }
+      }
+
+      for (Size i = q_begin; i < q_end; ++i)
+      {
+        NeighborHeap& heap = heaps[i - q_begin];
+        std::vector<Neighbor>& result = neighbors[i];
+        result.reserve(heap.size());
+        while (!heap.empty())
+        {
+          result.push_back(heap.top());
+          heap.pop();
+        }
+        std::reverse(result.begin(), result.end());
+      }
+    }
+  }
+
 }
@@ -34,6 +34,8 @@
 
 #include <OpenMS/DATASTRUCTURES/ConvexHull2D.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -58,32 +60,16 @@ namespace OpenMS
   /// equality operator
   bool ConvexHull2D::operator==(const ConvexHull2D& rhs) const
   {
-    // different size => return false
-    if (map_points_.size() != rhs.map_points_.size())
-      return false;
-
-    if (outer_points_.size() != rhs.outer_points_.size())
+    // different scans => return false
+    if (map_points_ != rhs.map_points_)
       return false;
 
-    //different points now => return false
-    for (HullPointType::ConstIterator it = rhs.map_points_.begin(); it !=   rhs.map_points_.end(); ++it)
-    {
-      if (map_points_.has(it->first))
-      {
-        if (map_points_[it->first] != it->second)
-          return false;
-      }
-      else
-        return false;
-    }
-    //different points now => return false
-    for (Size i = 0; i < rhs.outer_points_.size(); ++i)
-    {
-      if (outer_points_[i] != rhs.outer_points_[i])
-        return false;
-    }
+    // the outer points are derived from the scans (and computed lazily), so
+    // they only need to be compared if they were given by the user
+    if (!map_points_.empty())
+      return true;
 
-    return true;
+    return outer_points_ == rhs.outer_points_;
   }
 
   /// removes all points
@@ -103,7 +89,7 @@ namespace OpenMS
       outer_points_.reserve(map_points_.size() * 2);
 
       // traverse lower m/z's of RT scans
-      for (HullPointType::ConstIterator it = map_points_.begin(); it != map_points_.end(); ++it)
+      for (HullPointType::const_iterator it = map_points_.begin(); it != map_points_.end(); ++it)
       {
         PointType p;
         p.setX(it->first);
@@ -112,7 +98,7 @@ namespace OpenMS
       }
 
       // traverse higher m/z's of RT scans
-      for (HullPointType::ConstReverseIterator it = map_points_.rbegin(); it != map_points_.rend(); ++it)
+      for (HullPointType::const_reverse_iterator it = map_points_.rbegin(); it != map_points_.rend(); ++it)
       {
         PointType p;
         p.setX(it->first);
@@ -154,7 +140,7 @@ namespace OpenMS
     // the internal structure might not be defined, but we try it first
     if (map_points_.size() > 0)
     {
-      for (HullPointType::ConstIterator it = map_points_.begin(); it != map_points_.end(); ++it)
+      for (HullPointType::const_iterator it = map_points_.begin(); it != map_points_.end(); ++it)
       {
         bb.enlarge(it->first, it->second.minPosition()[0]);
         bb.enlarge(it->first, it->second.maxPosition()[0]);
@@ -171,20 +157,34 @@ namespace OpenMS
     return bb;
   }
 
+  ConvexHull2D::HullPointType::iterator ConvexHull2D::findScan_(PointType::CoordinateType rt)
+  {
+    // points usually arrive in RT order, so check the last scan first
+    if (map_points_.empty() || map_points_.back().first < rt)
+      return map_points_.end();
+    if (map_points_.back().first == rt)
+      return map_points_.end() - 1;
+
+    HullPointType::iterator it = std::lower_bound(map_points_.begin(), map_points_.end(), rt,
+                                                  [](const HullScanType& scan, PointType::CoordinateType value) { return scan.first < value; });
+    return it;
+  }
+
   bool ConvexHull2D::addPoint(const PointType& point)
   {
     outer_points_.clear();
 
-    if (map_points_.has(point[0]))
+    HullPointType::iterator it = findScan_(point[0]);
+    if (it != map_points_.end() && it->first == point[0])
     {
-      if (map_points_[point[0]].encloses(point[1]))
+      if (it->second.encloses(point[1]))
         return false;
 
-      map_points_[point[0]].enlarge(point[1]);
+      it->second.enlarge(point[1]);
     }
     else
     {
-      map_points_[point[0]] = DBoundingBox<1>(point[1], point[1]);
+      map_points_.insert(it, HullScanType(point[0], DBoundingBox<1>(point[1], point[1])));
     }
 
     return true;
@@ -206,36 +206,34 @@ namespace OpenMS
     if (map_points_.size() < 3)
       return 0; // we need at least one "middle" scan
 
-    HullPointType compressed_map;
-
-    compressed_map[map_points_.begin()->first] = map_points_.begin()->second; // copy first scan
-    HullPointType::ConstIterator pred_it = map_points_.begin();
-    HullPointType::ConstIterator middle_it = pred_it; middle_it++;
-    HullPointType::ConstIterator succ_it = pred_it; succ_it++; succ_it++;
-
+    // compact in place: 'last' is the end of the kept range, a middle scan is
+    // dropped if its m/z range equals both of its (original) neighbours
+    Size last = 1;
     for (Size p = 1; p < map_points_.size() - 1; ++p)
     {
-      if (pred_it->second == middle_it->second && middle_it->second == succ_it->second)
+      if (map_points_[p - 1].second == map_points_[p].second && map_points_[p].second == map_points_[p + 1].second)
       {
-        // middle is identical in m/z range .. do not add to the compressed_map
+        // middle is identical in m/z range .. do not keep it
+        continue;
       }
-      else
+      // last <= p, so the scans still to be compared are never overwritten
+      if (last != p)
       {
-        compressed_map[middle_it->first] = middle_it->second;
+        map_points_[last] = map_points_[p];
       }
-      ++succ_it;
-      ++middle_it;
-      ++pred_it;
+      ++last;
     }
-    compressed_map[middle_it->first] = middle_it->second; // copy last scan
-    if (succ_it != map_points_.end())
-      throw Exception::BufferOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+    map_points_[last] = map_points_.back(); // copy last scan
+    ++last;
 
-    //std::cout << "compressed CH from " << map_points_.size() << " to " << compressed_map.size() << "\n";
-    Size saved_points = map_points_.size() - compressed_map.size();
-    //copy
-    map_points_.clear();
-    map_points_.insert(compressed_map.begin(), compressed_map.end());
+    //std::cout << "compressed CH from " << map_points_.size() << " to " << last << "\n";
+    Size saved_points = map_points_.size() - last;
+    if (saved_points > 0)
+    {
+      map_points_.resize(last);
+      map_points_.shrink_to_fit();
+      outer_points_.clear();
+    }
     return saved_points;
   }
 
@@ -246,24 +244,18 @@ namespace OpenMS
       throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
 
-    if (map_points_.has(point[0]))
+    // find the two RT scans surrounding the point (scans are sorted by ascending RT)
+    HullPointType::const_iterator it = std::lower_bound(map_points_.begin(), map_points_.end(), point[0],
+                                                        [](const HullScanType& scan, PointType::CoordinateType value) { return scan.first < value; });
+    HullPointType::const_iterator it_upper = it, it_lower = map_points_.end();
+    if (it != map_points_.end() && it->first == point[0])
     {
-      if (map_points_[point[0]].encloses(point[1]))
+      if (it->second.encloses(point[1]))
         return true;
+      ++it_upper;
     }
-
-    // find the two RT scans surrounding the point:
-    HullPointType::ConstIterator it_upper = map_points_.end(), it_lower = map_points_.end();
-    // iterate over keys (which are sorted by ascending RT)
-    for (HullPointType::ConstIterator it = map_points_.begin(); it != map_points_.end(); ++it)
-    {
-      // lower bound
-      if (((it->first) < (point[0])))
-        it_lower = it;
-      // upper bound
-      if ((it_upper == map_points_.end()) && ((it->first) > (point[0])))
-        it_upper = it;
-    }
+    if (it != map_points_.begin())
+      it_lower = it - 1;
 
     // point is not between two scans
     if ((it_lower == map_points_.end()) || (it_upper == map_points_.end()))
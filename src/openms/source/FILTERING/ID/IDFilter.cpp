@@ -364,15 +364,17 @@ namespace OpenMS
   void IDFilter::keepBestPeptideHits(vector<PeptideIdentification>& peptides,
                                      bool strict)
   {
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      vector<PeptideHit>& hits = pep_it->getHits();
+      vector<PeptideHit>& hits = peptides[i].getHits();
       if (hits.size() > 1)
       {
-        pep_it->sort();
+        peptides[i].sort();
         double top_score = hits[0].getScore();
-        bool higher_better = pep_it->isHigherScoreBetter();
+        bool higher_better = peptides[i].isHigherScoreBetter();
         struct HasGoodScore<PeptideHit> good_score(top_score, higher_better);
         if (strict) // only one best score allowed
         {
@@ -410,20 +412,24 @@ namespace OpenMS
     if (min_length > 0)
     {
       struct HasMinPeptideLength length_filter(min_length);
-      for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-           pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
       {
-        keepMatchingItems(pep_it->getHits(), length_filter);
+        keepMatchingItems(peptides[i].getHits(), length_filter);
       }
     }
     ++max_length; // the predicate tests for ">=", we need ">"
     if (max_length > min_length)
     {
       struct HasMinPeptideLength length_filter(max_length);
-      for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-           pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
       {
-        removeMatchingItems(pep_it->getHits(), length_filter);
+        removeMatchingItems(peptides[i].getHits(), length_filter);
       }
     }
   }
@@ -433,19 +439,23 @@ namespace OpenMS
                                         Int min_charge, Int max_charge)
   {
     struct HasMinCharge charge_filter(min_charge);
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      keepMatchingItems(pep_it->getHits(), charge_filter);
+      keepMatchingItems(peptides[i].getHits(), charge_filter);
     }
     ++max_charge; // the predicate tests for ">=", we need ">"
     if (max_charge > min_charge)
     {
       charge_filter = HasMinCharge(max_charge);
-      for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-           pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
       {
-        removeMatchingItems(pep_it->getHits(), charge_filter);
+        removeMatchingItems(peptides[i].getHits(), charge_filter);
       }
     }
   }
@@ -470,11 +480,13 @@ namespace OpenMS
   void IDFilter::filterPeptidesByMZError(
     vector<PeptideIdentification>& peptides, double mass_error, bool unit_ppm)
   {
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      struct HasLowMZError error_filter(pep_it->getMZ(), mass_error, unit_ppm);
-      keepMatchingItems(pep_it->getHits(), error_filter);
+      struct HasLowMZError error_filter(peptides[i].getMZ(), mass_error, unit_ppm);
+      keepMatchingItems(peptides[i].getHits(), error_filter);
     }
   }
 
@@ -512,10 +524,12 @@ namespace OpenMS
     const set<String>& modifications)
   {
     struct HasMatchingModification mod_filter(modifications);
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      removeMatchingItems(pep_it->getHits(), mod_filter);
+      removeMatchingItems(peptides[i].getHits(), mod_filter);
     }
   }
 
@@ -525,10 +539,12 @@ namespace OpenMS
     const set<String>& modifications)
   {
     struct HasMatchingModification mod_filter(modifications);
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      keepMatchingItems(pep_it->getHits(), mod_filter);
+      keepMatchingItems(peptides[i].getHits(), mod_filter);
     }
   }
 
@@ -540,10 +556,12 @@ namespace OpenMS
     set<String> bad_seqs;
     extractPeptideSequences(bad_peptides, bad_seqs, ignore_mods);
     struct HasMatchingSequence seq_filter(bad_seqs, ignore_mods);
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      removeMatchingItems(pep_it->getHits(), seq_filter);
+      removeMatchingItems(peptides[i].getHits(), seq_filter);
     }
   }
 
@@ -555,10 +573,12 @@ namespace OpenMS
     set<String> good_seqs;
     extractPeptideSequences(good_peptides, good_seqs, ignore_mods);
     struct HasMatchingSequence seq_filter(good_seqs, ignore_mods);
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
-      keepMatchingItems(pep_it->getHits(), seq_filter);
+      keepMatchingItems(peptides[i].getHits(), seq_filter);
     }
   }
 
@@ -595,15 +615,17 @@ namespace OpenMS
   void IDFilter::removeDuplicatePeptideHits(vector<PeptideIdentification>&
                                             peptides, bool seq_only)
   {
-    for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
-         pep_it != peptides.end(); ++pep_it)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
     {
       vector<PeptideHit> filtered_hits;
       if (seq_only)
       {
         set<AASequence> seqs;
-        for (vector<PeptideHit>::iterator hit_it = pep_it->getHits().begin();
-             hit_it != pep_it->getHits().end(); ++hit_it)
+        for (vector<PeptideHit>::iterator hit_it = peptides[i].getHits().begin();
+             hit_it != peptides[i].getHits().end(); ++hit_it)
         {
           if (seqs.insert(hit_it->getSequence()).second) // new sequence
           {
@@ -615,8 +637,8 @@ namespace OpenMS
       {
         // there's no "PeptideHit::operator<" defined, so we can't use a set nor
         // "sort" + "unique" from the standard library:
-        for (vector<PeptideHit>::iterator hit_it = pep_it->getHits().begin();
-             hit_it != pep_it->getHits().end(); ++hit_it)
+        for (vector<PeptideHit>::iterator hit_it = peptides[i].getHits().begin();
+             hit_it != peptides[i].getHits().end(); ++hit_it)
         {
           if (find(filtered_hits.begin(), filtered_hits.end(), *hit_it) ==
               filtered_hits.end())
@@ -625,7 +647,7 @@ namespace OpenMS
           }
         }
       }
-      pep_it->getHits().swap(filtered_hits);
+      peptides[i].getHits().swap(filtered_hits);
     }
   }
   
@@ -34,6 +34,7 @@
 //
 
 #include <OpenMS/FILTERING/TRANSFORMERS/BernNorm.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -82,10 +83,8 @@ namespace OpenMS
 
   void BernNorm::filterPeakMap(PeakMap & exp)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      filterSpectrum(*it);
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [](BernNorm& f, MSSpectrum& s) { f.filterSpectrum(s); });
   }
 
 }
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 //
 #include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 using namespace std;
 
@@ -87,10 +88,8 @@ namespace OpenMS
 
   void NLargest::filterPeakMap(PeakMap & exp)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      filterSpectrum(*it);
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [](NLargest& f, MSSpectrum& s) { f.filterSpectrum(s); });
   }
 
   void NLargest::updateMembers_()
@@ -34,6 +34,7 @@
 //
 
 #include <OpenMS/FILTERING/TRANSFORMERS/Normalizer.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 using namespace std;
 namespace OpenMS
@@ -71,10 +72,8 @@ namespace OpenMS
 
   void Normalizer::filterPeakMap(PeakMap& exp) const
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      filterSpectrum(*it);
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [](Normalizer& f, MSSpectrum& s) { f.filterSpectrum(s); });
   }
 
   void Normalizer::updateMembers_()
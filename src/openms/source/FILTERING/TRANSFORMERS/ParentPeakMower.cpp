@@ -34,6 +34,7 @@
 //
 
 #include <OpenMS/FILTERING/TRANSFORMERS/ParentPeakMower.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 using namespace std;
 
@@ -78,10 +79,8 @@ namespace OpenMS
 
   void ParentPeakMower::filterPeakMap(PeakMap & exp)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      filterSpectrum(*it);
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [](ParentPeakMower& f, MSSpectrum& s) { f.filterSpectrum(s); });
   }
 
 }
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 //
 #include <OpenMS/FILTERING/TRANSFORMERS/Scaler.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 using namespace std;
 namespace OpenMS
@@ -67,10 +68,8 @@ namespace OpenMS
 
   void Scaler::filterPeakMap(PeakMap & exp)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      filterSpectrum(*it);
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [](Scaler& f, MSSpectrum& s) { f.filterSpectrum(s); });
   }
 
 }
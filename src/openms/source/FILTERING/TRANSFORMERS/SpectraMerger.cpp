@@ -35,6 +35,10 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 namespace OpenMS
 {
@@ -90,6 +94,8 @@ namespace OpenMS
     defaults_.setMinFloat("precursor_method:mz_tolerance", 0);
     defaults_.setValue("precursor_method:rt_tolerance", 5.0, "Max RT distance of the precursor entries of two spectra to be merged in [s].");
     defaults_.setMinFloat("precursor_method:rt_tolerance", 0);
+    defaults_.setValue("precursor_method:linkage", "single", "Linkage used for clustering precursors. 'single' merges all spectra connected by a chain of close precursors, 'complete' only merges spectra whose precursors are all pairwise within the tolerances.", ListUtils::create<String>("advanced"));
+    defaults_.setValidStrings("precursor_method:linkage", ListUtils::create<String>("single,complete"));
 
     defaultsToParam_();
   }
@@ -112,4 +118,150 @@ namespace OpenMS
     return *this;
   }
 
+  void SpectraMerger::clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const
+  {
+    clusters.clear();
+    if (data.empty())
+    {
+      return;
+    }
+
+    SpectraDistance_ llc;
+    Param distance_param = param_.copy("precursor_method:", true);
+    distance_param.remove("linkage"); // only used here, unknown to SpectraDistance_
+    llc.setParameters(distance_param);
+    const double rt_max = param_.getValue("precursor_method:rt_tolerance");
+    const bool complete_linkage = (String(param_.getValue("precursor_method:linkage")) == "complete");
+
+    // two precursors are linked iff their distance (1 - similarity) is below the clustering threshold of 1
+    // (computed in float precision, just like the distances of a DistanceMatrix<float>)
+    auto linked = [&llc](const BaseFeature& first, const BaseFeature& second)
+    {
+      return float(1 - llc(first, second)) < 1.0f;
+    };
+
+    // visit precursors in RT order, so only a small window of successors needs to be compared
+    std::vector<Size> order(data.size());
+    for (Size i = 0; i < order.size(); ++i)
+    {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&data](Size a, Size b) { return data[a].getRT() < data[b].getRT(); });
+
+    // sparse neighbourhood graph (each precursor stores its linked RT successors)
+    std::vector<std::vector<Size> > neighbours(data.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1000)
+#endif
+    for (SignedSize k = 0; k < (SignedSize)order.size(); ++k)
+    {
+      const BaseFeature& first = data[order[k]];
+      for (Size l = k + 1; l < order.size() && data[order[l]].getRT() - first.getRT() <= rt_max; ++l)
+      {
+        if (linked(first, data[order[l]]))
+        {
+          neighbours[order[k]].push_back(order[l]);
+        }
+      }
+    }
+
+    // connected components (union-find; the smallest index is the representative)
+    std::vector<Size> root(data.size());
+    for (Size i = 0; i < root.size(); ++i)
+    {
+      root[i] = i;
+    }
+    auto find_root = [&root](Size i)
+    {
+      while (root[i] != i)
+      {
+        root[i] = root[root[i]]; // path halving
+        i = root[i];
+      }
+      return i;
+    };
+    for (Size i = 0; i < neighbours.size(); ++i)
+    {
+      for (Size j : neighbours[i])
+      {
+        Size ri = find_root(i), rj = find_root(j);
+        if (ri < rj) root[rj] = ri;
+        else if (rj < ri) root[ri] = rj;
+      }
+      std::vector<Size>().swap(neighbours[i]); // free memory early
+    }
+
+    // components are ordered by their smallest element, members ascending
+    std::vector<std::vector<Size> > components;
+    std::vector<Size> component_index(data.size());
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      Size r = find_root(i);
+      if (r == i)
+      {
+        component_index[i] = components.size();
+        components.push_back(std::vector<Size>());
+      }
+      components[component_index[r]].push_back(i);
+    }
+
+    if (!complete_linkage)
+    {
+      clusters.swap(components);
+      return;
+    }
+
+    // complete linkage: cluster each component separately (small dense matrices only)
+    std::vector<std::vector<std::vector<Size> > > component_clusters(components.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize c = 0; c < (SignedSize)components.size(); ++c)
+    {
+      const std::vector<Size>& members = components[c];
+      if (members.size() < 2)
+      {
+        component_clusters[c].push_back(members);
+        continue;
+      }
+
+      DistanceMatrix<float> dist(members.size(), 1);
+      for (Size i = 0; i < members.size(); ++i)
+      {
+        for (Size j = 0; j < i; ++j)
+        {
+          // distance value is 1-similarity value, since similarity is in range of [0,1]
+          dist.setValueQuick(i, j, 1 - llc(data[members[i]], data[members[j]]));
+        }
+      }
+      std::vector<BinaryTreeNode> tree;
+      CompleteLinkage cl;
+      cl(dist, tree, 1.0f);
+
+      // count number of real tree nodes (not the -1 ones)
+      Size node_count = 0;
+      for (Size i = 0; i < tree.size(); ++i)
+      {
+        if (tree[i].distance != -1) ++node_count;
+      }
+      std::vector<std::vector<Size> > local_clusters;
+      ClusterAnalyzer().cut(members.size() - node_count, tree, local_clusters);
+
+      // map back to indices in 'data' (cut() returns sorted clusters, 'members' is sorted)
+      for (std::vector<Size>& cluster : local_clusters)
+      {
+        for (Size& idx : cluster)
+        {
+          idx = members[idx];
+        }
+      }
+      component_clusters[c].swap(local_clusters);
+    }
+
+    for (Size c = 0; c < component_clusters.size(); ++c)
+    {
+      clusters.insert(clusters.end(), component_clusters[c].begin(), component_clusters[c].end());
+    }
+  }
+
 }
@@ -33,6 +33,7 @@
 // --------------------------------------------------------------------------
 //
 #include <OpenMS/FILTERING/TRANSFORMERS/SqrtMower.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 using namespace std;
 
@@ -68,10 +69,8 @@ namespace OpenMS
 
   void SqrtMower::filterPeakMap(PeakMap & exp)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      filterSpectrum(*it);
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [](SqrtMower& f, MSSpectrum& s) { f.filterSpectrum(s); });
   }
 
 }
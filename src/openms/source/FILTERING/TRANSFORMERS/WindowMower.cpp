@@ -34,6 +34,7 @@
 //
 
 #include <OpenMS/FILTERING/TRANSFORMERS/WindowMower.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 
 using namespace std;
 
@@ -84,17 +85,18 @@ namespace OpenMS
   void WindowMower::filterPeakMap(PeakMap & exp)
   {
     bool sliding = (String)param_.getValue("movetype") == "slide" ? true : false;
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
-    {
-      if (sliding)
-      {
-        filterPeakSpectrumForTopNInSlidingWindow(*it);
-      }
-      else
-      {
-        filterPeakSpectrumForTopNInJumpingWindow(*it);
-      }
-    }
+    ParallelSpectrumFilter::apply(exp.getSpectra(), *this,
+                                  [sliding](WindowMower& f, MSSpectrum& s)
+                                  {
+                                    if (sliding)
+                                    {
+                                      f.filterPeakSpectrumForTopNInSlidingWindow(s);
+                                    }
+                                    else
+                                    {
+                                      f.filterPeakSpectrumForTopNInJumpingWindow(s);
+                                    }
+                                  });
   }
 
 }
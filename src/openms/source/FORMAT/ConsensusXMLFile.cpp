@@ -237,11 +237,9 @@ namespace OpenMS
           act_index_tuple.setMapIndex(map_index);
           act_index_tuple.setUniqueId(unique_id);
 
-          tmp_str = attributeAsString_(attributes, "rt");
           DPosition<2> pos;
-          pos[0] = asDouble_(tmp_str);
-          tmp_str = attributeAsString_(attributes, "mz");
-          pos[1] = asDouble_(tmp_str);
+          pos[0] = attributeAsDouble_(attributes, "rt");
+          pos[1] = attributeAsDouble_(attributes, "mz");
 
           act_index_tuple.setPosition(pos);
           act_index_tuple.setIntensity(attributeAsDouble_(attributes, "it"));
@@ -505,7 +503,7 @@ namespace OpenMS
       pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
-      const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
+      const XMLCh* refs = getAttributeValue_(attributes, "protein_refs");
       if (refs != nullptr)
       {
         String accession_string = sm_.convert(refs);
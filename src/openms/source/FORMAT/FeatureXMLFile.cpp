@@ -685,7 +685,7 @@ namespace OpenMS
       pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
-      const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
+      const XMLCh* refs = getAttributeValue_(attributes, "protein_refs");
       if (refs != nullptr)
       {
         String accession_string = sm_.convert(refs);
@@ -859,9 +859,9 @@ namespace OpenMS
     }
     else if (tag == "convexhull")
     {
-      ConvexHull2D hull;
-      hull.setHullPoints(current_chull_);
-      current_feature_->getConvexHulls().push_back(hull);
+      // construct in place: avoids copying the point list twice per hull
+      current_feature_->getConvexHulls().push_back(ConvexHull2D());
+      current_feature_->getConvexHulls().back().setHullPoints(current_chull_);
     }
     else if (tag == "subordinate")
     {
@@ -936,19 +936,19 @@ namespace OpenMS
     String& current_tag = open_tags_.back();
     if (current_tag == "intensity")
     {
-      current_feature_->setIntensity(asDouble_(sm_.convert(chars)));
+      current_feature_->setIntensity(asDouble_(chars));
     }
     else if (current_tag == "position")
     {
-      current_feature_->getPosition()[dim_] = asDouble_(sm_.convert(chars));
+      current_feature_->getPosition()[dim_] = asDouble_(chars);
     }
     else if (current_tag == "quality")
     {
-      current_feature_->setQuality(dim_, asDouble_(sm_.convert(chars)));
+      current_feature_->setQuality(dim_, asDouble_(chars));
     }
     else if (current_tag == "overallquality")
     {
-      current_feature_->setOverallQuality(asDouble_(sm_.convert(chars)));
+      current_feature_->setOverallQuality(asDouble_(chars));
     }
     else if (current_tag == "charge")
     {
@@ -956,7 +956,7 @@ namespace OpenMS
     }
     else if (current_tag == "hposition")
     {
-      hull_position_[dim_] = asDouble_(sm_.convert(chars));
+      hull_position_[dim_] = asDouble_(chars);
     }
   }
 
@@ -978,7 +978,7 @@ namespace OpenMS
     os << indent << "\t\t\t<charge>" << feat.getCharge() << "</charge>\n";
 
     // write convex hull
-    vector<ConvexHull2D> hulls = feat.getConvexHulls();
+    const vector<ConvexHull2D>& hulls = feat.getConvexHulls();
 
     Size hulls_count = hulls.size();
 
@@ -986,13 +986,16 @@ namespace OpenMS
     {
       os << indent << "\t\t\t<convexhull nr=\"" << i << "\">\n";
 
+      // compress a temporary copy only; the outer points are expanded on the
+      // copy, so the stored feature keeps its compact representation
       ConvexHull2D current_hull = hulls[i];
       current_hull.compress();
-      Size hull_size = current_hull.getHullPoints().size();
+      const ConvexHull2D::PointArrayType& hull_points = current_hull.getHullPoints();
+      Size hull_size = hull_points.size();
 
       for (Size j = 0; j < hull_size; j++)
       {
-        DPosition<2> pos = current_hull.getHullPoints()[j];
+        const DPosition<2>& pos = hull_points[j];
         /*Size pos_size = pos.size();
             os << indent << "\t\t\t\t<hullpoint>\n";
     for (Size k=0; k<pos_size; k++)
@@ -37,6 +37,7 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/StringUtils.h>
 
 using namespace std;
 using namespace xercesc;
@@ -274,6 +275,35 @@ namespace OpenMS
 
     }
 
+    bool StringManager::widenASCII(const char * str, XMLCh * buffer, const Size buffer_size)
+    {
+      for (Size i = 0; i < buffer_size; ++i)
+      {
+        if ((unsigned char)str[i] > 127) return false;
+        buffer[i] = (XMLCh)str[i];
+        if (str[i] == '\0') return true;
+      }
+      return false;
+    }
+
+    char * StringManager::narrowASCII(const XMLCh * str, char * buffer, const Size buffer_size)
+    {
+      for (Size i = 0; i < buffer_size; ++i)
+      {
+        if (str[i] == 0) return buffer + i;
+        if (str[i] > 127) return nullptr;
+        buffer[i] = (char)str[i];
+      }
+      return nullptr;
+    }
+
+    bool XMLHandler::parseASCII_(const XMLCh * in, double & value)
+    {
+      char buffer[StringManager::ASCII_BUFFER_SIZE];
+      const char * end = StringManager::narrowASCII(in, buffer, StringManager::ASCII_BUFFER_SIZE);
+      return end != nullptr && StringUtils::toDouble(buffer, end, value);
+    }
+
   }   // namespace Internal
 
 } // namespace OpenMS
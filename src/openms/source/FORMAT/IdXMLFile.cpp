@@ -632,7 +632,7 @@ namespace OpenMS
       pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
-      const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
+      const XMLCh* refs = getAttributeValue_(attributes, "protein_refs");
       if (refs != nullptr)
       {
         String accession_string = sm_.convert(refs);
@@ -79,6 +79,30 @@ private:
       XMLHandler * p_;
     };
 
+    /// Initializes the Xerces library (i.e. increments its reference count, since it is already initialized on startup)
+    static void initializeXerces_()
+    {
+      String error;
+      // the reference count is not atomic; files may be loaded concurrently
+#ifdef _OPENMP
+#pragma omp critical (XMLFile_initializeXerces)
+#endif
+      {
+        try
+        {
+          xercesc::XMLPlatformUtils::Initialize();
+        }
+        catch (const xercesc::XMLException & toCatch)
+        {
+          error = String("Error during initialization: ") + StringManager().convert(toCatch.getMessage());
+        }
+      }
+      if (!error.empty())
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", error);
+      }
+    }
+
     XMLFile::XMLFile()
     {
     }
@@ -112,15 +136,7 @@ private:
       }
 
       // initialize parser
-      try
-      {
-        xercesc::XMLPlatformUtils::Initialize();
-      }
-      catch (const xercesc::XMLException & toCatch)
-      {
-        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "", String("Error during initialization: ") + StringManager().convert(toCatch.getMessage()));
-      }
+      initializeXerces_();
 
       boost::shared_ptr< xercesc::SAX2XMLReader > parser(xercesc::XMLReaderFactory::createXMLReader());
       parser->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpaces, false);
@@ -198,15 +214,7 @@ private:
       StringManager sm;
 
       // initialize parser
-      try
-      {
-        xercesc::XMLPlatformUtils::Initialize();
-      }
-      catch (const xercesc::XMLException & toCatch)
-      {
-        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-            "", String("Error during initialization: ") + StringManager().convert(toCatch.getMessage()));
-      }
+      initializeXerces_();
 
       boost::shared_ptr< xercesc::SAX2XMLReader > parser(xercesc::XMLReaderFactory::createXMLReader());
       parser->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpaces, false);
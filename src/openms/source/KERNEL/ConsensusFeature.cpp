@@ -92,7 +92,11 @@ namespace OpenMS
 
   void ConsensusFeature::insert(const FeatureHandle& handle)
   {
-    if (!(handles_.insert(handle).second))
+    // hint at the end: handles are usually added in map order, which makes
+    // this an amortized constant time append for the flat container
+    const Size old_size = handles_.size();
+    handles_.insert(handles_.end(), handle);
+    if (handles_.size() == old_size)
     {
       String key = String("map") + handle.getMapIndex() + "/feature" + handle.getUniqueId();
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The set already contained an element with this key.", key);
@@ -133,23 +133,23 @@ namespace OpenMS
       /* double sqrt(double); --removed */
       /* integer s_wsfe(cilist *), do_fio(integer *, char *, ftnlen), e_wsfe(void); -- removed */
 
-      /* Local variables */
-      static integer i__, j, l;
-      static double t;
+      /* Local variables (not static, so this routine is reentrant) */
+      integer i__ = 0, j = 0, l = 0;
+      double t = 0;
       /* Subroutine */ int g1_(double *, double *, double *, double *, double *);
-      static double cc;
+      double cc = 0;
       /* Subroutine */ int h12_(integer *, integer *, integer *, integer *, double *, integer *, double *, double *, integer *, integer *, integer *);
-      static integer ii, jj, ip;
-      static double sm;
-      static integer iz, jz;
-      static double up, ss;
-      static integer iz1, iz2, npp1;
+      integer ii = 0, jj = 0, ip = 0;
+      double sm = 0;
+      integer iz = 0, jz = 0;
+      double up = 0, ss = 0;
+      integer iz1 = 0, iz2 = 0, npp1 = 0;
       double diff_(double *, double *);
-      static integer iter;
-      static double temp, wmax, alpha, asave;
-      static integer itmax, izmax, nsetp;
-      static double dummy, unorm, ztest;
-      static integer rtnkey;
+      integer iter = 0;
+      double temp = 0, wmax = 0, alpha = 0, asave = 0;
+      integer itmax = 0, izmax = 0, nsetp = 0;
+      double dummy = 0, unorm = 0, ztest = 0;
+      integer rtnkey = 0;
 
       /* Fortran I/O blocks */
       /* static cilist io___22 = { 0, 6, 0, "(/a)", 0 }; --removed */
@@ -559,8 +559,8 @@ L400:
       /* Builtin functions */
       /* double sqrt(double), d_sign(double *, double *); --removed */
 
-      /* Local variables */
-      static double xr, yr;
+      /* Local variables (not static, so this routine is reentrant) */
+      double xr = 0, yr = 0;
 
 
       /*     COMPUTE ORTHOGONAL ROTATION MATRIX.. */
@@ -655,12 +655,12 @@ L400:
       /* Builtin functions */
       /* double sqrt(double); --removed */
 
-      /* Local variables */
-      static double b;
-      static integer i__, j, i2, i3, i4;
-      static double cl, sm;
-      static integer incr;
-      static double clinv;
+      /* Local variables (not static, so this routine is reentrant) */
+      double b = 0;
+      integer i__ = 0, j = 0, i2 = 0, i3 = 0, i4 = 0;
+      double cl = 0, sm = 0;
+      integer incr = 0;
+      double clinv = 0;
 
       /*     ------------------------------------------------------------------ */
       /*     double precision U(IUE,M) */
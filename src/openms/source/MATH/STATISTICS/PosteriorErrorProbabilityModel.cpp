@@ -43,6 +43,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideHit.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 #include <QDir>
 
@@ -677,6 +678,29 @@ namespace OpenMS
         }
       }
 
+      // sort the hits of every peptide ID only once (in parallel) instead of
+      // copying and sorting the ID for every charge state, engine and run;
+      // stable sorting of the indices gives the same order as PeptideIdentification::sort()
+      vector<vector<Size> > hit_order(peptide_ids.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)peptide_ids.size(); ++i)
+      {
+        const vector<PeptideHit>& hits = peptide_ids[i].getHits();
+        vector<Size>& order = hit_order[i];
+        order.resize(hits.size());
+        for (Size j = 0; j < hits.size(); ++j) { order[j] = j; }
+        if (peptide_ids[i].isHigherScoreBetter())
+        {
+          stable_sort(order.begin(), order.end(), [&hits](Size a, Size b) { return hits[a].getScore() > hits[b].getScore(); });
+        }
+        else
+        {
+          stable_sort(order.begin(), order.end(), [&hits](Size a, Size b) { return hits[a].getScore() < hits[b].getScore(); });
+        }
+      }
+
       set<Int>::iterator charge_it = charges.begin(); // charges can be empty, no problem if split_charge is not set
       map<String, vector<vector<double> > > all_scores;
       char splitter = ','; // to split the engine from the charge state later on
@@ -693,25 +717,27 @@ namespace OpenMS
 
             if (supported_engine == search_engine)
             {
-              for (PeptideIdentification pep : peptide_ids)
+              for (Size i = 0; i < peptide_ids.size(); ++i)
               {
+                const PeptideIdentification& pep = peptide_ids[i];
                 // make sure we are comparing peptide and proteins of the same search run
                 if (prot.getIdentifier() == pep.getIdentifier())
                 {
-                  pep.sort();
-                  vector<PeptideHit>& hits = pep.getHits();
+                  const vector<PeptideHit>& hits = pep.getHits();
+                  const vector<Size>& order = hit_order[i];
                   if (top_hits_only)
                   {
-                    if (!hits.empty() && (!split_charge || hits[0].getCharge() == *charge_it))
+                    if (!hits.empty() && (!split_charge || hits[order[0]].getCharge() == *charge_it))
                     {
-                      double score = PosteriorErrorProbabilityModel::transformScore_(supported_engine, hits[0]);
+                      const PeptideHit& top_hit = hits[order[0]];
+                      double score = PosteriorErrorProbabilityModel::transformScore_(supported_engine, top_hit);
                       if (!boost::math::isnan(score)) // issue #740: ignore scores with 0 values, otherwise you will get the error "unable to fit data"
                       {
                         scores.push_back(score);
 
                         if (target_decoy_available)
                         {
-                          if (hits[0].getScore() < fdr_for_targets_smaller)
+                          if (top_hit.getScore() < fdr_for_targets_smaller)
                           {
                             target.push_back(score);
                           }
@@ -725,8 +751,9 @@ namespace OpenMS
                   }
                   else
                   {
-                    for (PeptideHit const & hit : hits)
+                    for (Size j : order)
                     {
+                      const PeptideHit& hit = hits[j];
                       if (!split_charge || (hit.getCharge() == *charge_it))
                       {
                         double score = PosteriorErrorProbabilityModel::transformScore_(supported_engine, hit);
@@ -783,8 +810,8 @@ namespace OpenMS
       bool & data_might_not_be_well_fit)
     {
       String engine(search_engine);
-      unable_to_fit_data = true;
-      data_might_not_be_well_fit = true;
+      // local copies, so they can be combined over threads
+      bool unable_to_fit = true, might_not_be_well_fit = true;
 
       engine.toUpper();
       for (ProteinIdentification & prot : protein_ids)
@@ -794,58 +821,74 @@ namespace OpenMS
 
         if (engine == search_engine)
         {
-          for (PeptideIdentification & pep : peptide_ids)
+          // IDs are updated independently of each other
+          ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64) reduction(&&: unable_to_fit, might_not_be_well_fit)
+#endif
+          for (SignedSize i = 0; i < (SignedSize)peptide_ids.size(); ++i)
           {
-            if (prot.getIdentifier() == pep.getIdentifier())
+            try
             {
-              String score_type = pep.getScoreType() + "_score";
-              vector<PeptideHit> hits = pep.getHits();
-              for (PeptideHit & hit : hits)
+              PeptideIdentification& pep = peptide_ids[i];
+              if (prot.getIdentifier() == pep.getIdentifier())
               {
-                if (!split_charge || (hit.getCharge() == charge))
+                String score_type = pep.getScoreType() + "_score";
+                vector<PeptideHit> hits = pep.getHits();
+                for (PeptideHit & hit : hits)
                 {
-                  double score;
-                  hit.setMetaValue(score_type, hit.getScore());
-                  score = PosteriorErrorProbabilityModel::transformScore_(engine, hit);
-
-                  if (boost::math::isnan(score)) // issue #740: ignore scores with 0 values, otherwise you will get the error "unable to fit data"
+                  if (!split_charge || (hit.getCharge() == charge))
                   {
-                    score = 1.0;
-                  }
-                  else 
-                  { 
-                    score = PEP_model.computeProbability(score);
+                    double score;
+                    hit.setMetaValue(score_type, hit.getScore());
+                    score = PosteriorErrorProbabilityModel::transformScore_(engine, hit);
 
-                    // invalid score? invalid fit!
-                    if ((score > 0.0) && (score < 1.0)) unable_to_fit_data = false; 
-                    if ((score > 0.2) && (score < 0.8)) data_might_not_be_well_fit = false;
-                  }
-                  hit.setScore(score);
-                  if (prob_correct)
-                  {
-                    hit.setScore(1.0 - score);
-                  }
-                  else
-                  {
+                    if (boost::math::isnan(score)) // issue #740: ignore scores with 0 values, otherwise you will get the error "unable to fit data"
+                    {
+                      score = 1.0;
+                    }
+                    else 
+                    { 
+                      score = PEP_model.computeProbability(score);
+
+                      // invalid score? invalid fit!
+                      if ((score > 0.0) && (score < 1.0)) unable_to_fit = false;
+                      if ((score > 0.2) && (score < 0.8)) might_not_be_well_fit = false;
+                    }
                     hit.setScore(score);
+                    if (prob_correct)
+                    {
+                      hit.setScore(1.0 - score);
+                    }
+                    else
+                    {
+                      hit.setScore(score);
+                    }
                   }
                 }
+                pep.setHits(hits);
+              }
+              if (prob_correct)
+              {
+                pep.setScoreType("Posterior Probability");
+                pep.setHigherScoreBetter(true);
+              }
+              else
+              {
+                pep.setScoreType("Posterior Error Probability");
+                pep.setHigherScoreBetter(false);
               }
-              pep.setHits(hits);
-            }
-            if (prob_correct)
-            {
-              pep.setScoreType("Posterior Probability");
-              pep.setHigherScoreBetter(true);
             }
-            else
+            catch (...)
             {
-              pep.setScoreType("Posterior Error Probability");
-              pep.setHigherScoreBetter(false);
+              exceptions.capture();
             }
           }
+          exceptions.rethrow();
         }
       }
+      unable_to_fit_data = unable_to_fit;
+      data_might_not_be_well_fit = might_not_be_well_fit;
     }
   } // namespace Math
 } // namespace OpenMS
@@ -421,6 +421,33 @@ namespace OpenMS
     return peak_map_;
   }
 
+  void MSSim::consumeExperiment(Interfaces::IMSDataConsumer& consumer)
+  {
+    consumeAndRelease_(experiment_, consumer);
+  }
+
+  void MSSim::consumePeakMap(Interfaces::IMSDataConsumer& consumer)
+  {
+    consumeAndRelease_(peak_map_, consumer);
+  }
+
+  void MSSim::consumeAndRelease_(SimTypes::MSSimExperiment& experiment, Interfaces::IMSDataConsumer& consumer)
+  {
+    consumer.setExperimentalSettings(experiment);
+    consumer.setExpectedSize(experiment.size(), experiment.getChromatograms().size());
+    for (Size i = 0; i < experiment.size(); ++i)
+    {
+      consumer.consumeSpectrum(experiment[i]);
+      experiment[i].clear(false);
+      // clear() keeps the capacity, a copy of the empty spectrum does not
+      experiment[i] = SimTypes::MSSimExperiment::SpectrumType(experiment[i]);
+    }
+    for (Size i = 0; i < experiment.getChromatograms().size(); ++i)
+    {
+      consumer.consumeChromatogram(experiment.getChromatograms()[i]);
+    }
+  }
+
   void MSSim::getIdentifications(vector<ProteinIdentification>& proteins, vector<PeptideIdentification>& peptides) const
   {
     if (param_.getValue("RawTandemSignal:status") == "disabled")
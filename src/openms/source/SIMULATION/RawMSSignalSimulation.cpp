@@ -37,6 +37,7 @@
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/SVOutStream.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 #include <boost/random/uniform_real.hpp>
 #include <boost/random/poisson_distribution.hpp>
@@ -44,6 +45,8 @@
 #include <boost/random/normal_distribution.hpp>
 #include <boost/math/distributions.hpp>
 
+#include <algorithm>
+
 #ifdef _OPENMP
 #include <omp.h>
 
@@ -390,25 +393,23 @@ namespace OpenMS
       experiments_ct.push_back(&experiment_ct); // the master thread gets the original (just a reference, no copying here)
 
 
+      // every feature gets its own random number stream, seeded in feature order,
+      // so the technical noise does not depend on the number of threads or the
+      // order in which the features are processed
+      std::vector<boost::random::mt19937_64::result_type> feature_seeds(features.size());
+      for (Size f = 0; f < features.size(); ++f)
+      {
+        feature_seeds[f] = rnd_gen_->getTechnicalRng()();
+      }
+
 #ifdef _OPENMP
-      // prepare random numbers for the different threads
-      // each possible thread gets his own set of random
-      // numbers
       Size thread_count = omp_get_max_threads();
 
-      threaded_random_numbers_.resize(thread_count);
-      threaded_random_numbers_index_.resize(thread_count);
       experiments.reserve(thread_count); // !reserve!
       experiments_ct.reserve(thread_count); // !reserve!
       std::vector<SimTypes::MSSimExperiment> experiments_tmp(thread_count - 1); // holds MSExperiments for slave threads
       std::vector<SimTypes::MSSimExperiment> experiments_ct_tmp(thread_count - 1); // holds MSExperiments (centroided) for slave threads
 
-      for (Size i = 0; i < thread_count; ++i)
-      {
-        threaded_random_numbers_[i].resize(THREADED_RANDOM_NUMBER_POOL_SIZE_);
-        threaded_random_numbers_index_[i] = THREADED_RANDOM_NUMBER_POOL_SIZE_;
-      }
-
       if (thread_count > 1)
       {
         // prepare a temporary experiment to store the results
@@ -430,63 +431,80 @@ namespace OpenMS
           experiments_ct.push_back(&(experiments_ct_tmp[i - 1]));
         }
       }
-#else
-      Size thread_count = 1;
 #endif
 
-      Size compress_size_intermediate = 20000 / thread_count; // compress map every X features, (10.000 feature are ~ 2 GB at 0.002 sampling rate)
-      Size compress_count = 0; // feature count (for each thread)
+      // features are processed in blocks of a fixed size; the map is compressed after each block (to avoid memory problems),
+      // i.e. at the same features for any number of threads (10.000 feature are ~ 2 GB at 0.002 sampling rate)
+      const Size compress_block_size = 20000;
+      for (Size block_start = 0; block_start < features.size(); block_start += compress_block_size)
+      {
+        const SignedSize block_end = (SignedSize)std::min(features.size(), block_start + compress_block_size);
 
+        ParallelExceptionCollector exceptions;
 #ifdef _OPENMP
-#pragma omp parallel for firstprivate(compress_count)
+#pragma omp parallel for
 #endif
-      for (SignedSize f = 0; f < (SignedSize)features.size(); ++f)
-      {
+        for (SignedSize f = (SignedSize)block_start; f < block_end; ++f)
+        {
 #ifdef _OPENMP // update experiment index if necessary
-        const int current_thread = omp_get_thread_num();
+          const int current_thread = omp_get_thread_num();
 #else
-        const int current_thread(0);
+          const int current_thread(0);
 #endif
-        add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]));
+          try
+          {
+            boost::random::mt19937_64 feature_rng(feature_seeds[f]);
+            add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]), feature_rng);
+          }
+          catch (...)
+          {
+            exceptions.capture();
+          }
 
-        // progresslogger, only master thread sets progress (no barrier here)
+          // progresslogger, only master thread sets progress (no barrier here)
 #ifdef _OPENMP
 #pragma omp atomic
 #endif
-        ++progress;
-        if (current_thread == 0)
+          ++progress;
+          if (current_thread == 0)
+          {
+            this->setProgress(progress);
+          }
+        } // ! raw signal sim
+        exceptions.rethrow();
+
+#ifdef _OPENMP // merge back other experiments
+        for (Size i = 1; i < experiments.size(); ++i)
         {
-          this->setProgress(progress);
+          // copy peak data from temporal experiment
+          for (Size scan = 0; scan < experiment.size(); ++scan)
+          {
+            if ((*experiments[i])[scan].empty())
+              continue; // we do not care if the spectrum wasn't touched at all
+            // append all points from temp to org
+            experiment[scan].insert(experiment[scan].end(), (*experiments[i])[scan].begin(), (*experiments[i])[scan].end());
+            // delete from child experiment to save memory (otherwise the merge would double it!)
+            (*experiments[i])[scan].clear(false);
+
+            // peak GT ( small, so no need to compress)
+            experiment_ct[scan].insert(experiment_ct[scan].end(), (*experiments_ct[i])[scan].begin(), (*experiments_ct[i])[scan].end());
+            (*experiments_ct[i])[scan].clear(false);
+          }
         }
+#endif
 
-        // intermediate compress to avoid memory problems
-        ++compress_count;
-        if (compress_count > compress_size_intermediate)
+        // intermediate compress (the last block is compressed below, together with contaminants and noise)
+        if ((Size)block_end < features.size())
         {
-          compress_count = 0;
-          compressSignals_(*(experiments[current_thread]));
+          compressSignals_(experiment);
         }
-      } // ! raw signal sim
+      }
 
-#ifdef _OPENMP // merge back other experiments
-      for (Size i = 1; i < experiments.size(); ++i)
+      // the order of the merged peaks depends on the number of threads
+      for (Size scan = 0; scan < experiment_ct.size(); ++scan)
       {
-        // copy peak data from temporal experiment
-        for (Size scan = 0; scan < experiment.size(); ++scan)
-        {
-          if ((*experiments[i])[scan].empty())
-            continue; // we do not care if the spectrum wasn't touched at all
-          // append all points from temp to org
-          experiment[scan].insert(experiment[scan].end(), (*experiments[i])[scan].begin(), (*experiments[i])[scan].end());
-          // delete from child experiment to save memory (otherwise the merge would double it!)
-          (*experiments[i])[scan].clear(false);
-
-          // peak GT ( small, so no need to compress)
-          experiment_ct[scan].insert(experiment_ct[scan].end(), (*experiments_ct[i])[scan].begin(), (*experiments_ct[i])[scan].end());
-
-        }
+        sortByPositionAndIntensity_(experiment_ct[scan]);
       }
-#endif
 
     } // ! 1D or 2D
 
@@ -534,7 +552,7 @@ namespace OpenMS
 
   void RawMSSignalSimulation::add1DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
   {
-    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 100.0);
+    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 100.0, rnd_gen_->getTechnicalRng());
 
     SimTypes::SimChargeType q = active_feature.getCharge();
     EmpiricalFormula ef = active_feature.getPeptideIdentifications()[0].getHits()[0].getSequence().getFormula();
@@ -570,9 +588,9 @@ namespace OpenMS
     samplePeptideModel1D_(isomodel, mz_start, mz_end, experiment, experiment_ct, active_feature);
   }
 
-  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, boost::random::mt19937_64& rng)
   {
-    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0);
+    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0, rng);
 
     SimTypes::SimChargeType q = active_feature.getCharge();
     EmpiricalFormula ef;
@@ -635,7 +653,7 @@ namespace OpenMS
 
     // add peptide to GLOBAL MS map
     // add CH and new intensity to feature
-    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature);
+    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature, rng);
   }
 
   void RawMSSignalSimulation::samplePeptideModel1D_(const IsotopeModel& pm,
@@ -691,7 +709,8 @@ namespace OpenMS
                                                     SimTypes::SimCoordinateType rt_end,
                                                     SimTypes::MSSimExperiment& experiment,
                                                     SimTypes::MSSimExperiment& experiment_ct,
-                                                    Feature& active_feature)
+                                                    Feature& active_feature,
+                                                    boost::random::mt19937_64& rng)
   {
     if (rt_start <= 0)
       rt_start = 0;
@@ -716,6 +735,8 @@ namespace OpenMS
     SimTypes::SimCoordinateType iso_peakdist = isomodel->getParameters().getValue("isotope:distance");
     Int q = active_feature.getCharge();
 
+    boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Sample the model ...
     SimTypes::SimCoordinateType rt(0);
@@ -755,37 +776,7 @@ namespace OpenMS
         //LOG_ERROR << "Sampling " << rt << " , " << mz << " -> " << point.getIntensity() << std::endl;
 
         // add Gaussian distributed m/z error
-#ifdef _OPENMP
-        int CURRENT_THREAD = omp_get_thread_num();
-        // check if we need to refill the random number pool for this thread
-        if (threaded_random_numbers_index_[CURRENT_THREAD] == THREADED_RANDOM_NUMBER_POOL_SIZE_)
-        {
-          if (mz_error_stddev_ != 0.0)
-          {
-#pragma omp critical(generate_random_number_for_thread)
-            {
-              boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-              for (Size i = 0; i < THREADED_RANDOM_NUMBER_POOL_SIZE_; ++i)
-              {
-                threaded_random_numbers_[CURRENT_THREAD][i] = ndist(rnd_gen_->getTechnicalRng());
-              }
-            }
-          }
-          else
-          {
-            // we do not need to care about concurrency here
-            fill(threaded_random_numbers_[CURRENT_THREAD].begin(), threaded_random_numbers_[CURRENT_THREAD].end(), mz_error_mean_);
-          }
-          // reset index for this thread to first position
-          threaded_random_numbers_index_[CURRENT_THREAD] = 0;
-        }
-
-        const double mz_err = threaded_random_numbers_[CURRENT_THREAD][threaded_random_numbers_index_[CURRENT_THREAD]++];
-#else
-        // we can use the normal Gaussian ran-gen if we do not use OPENMP
-        boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-        const double mz_err = ndist(rnd_gen_->getTechnicalRng());
-#endif
+        const double mz_err = (mz_error_stddev_ != 0.0 ? ndist(rng) : mz_error_mean_);
         point.setMZ(std::fabs(point.getMZ() + mz_err));
         exp_iter->push_back(point);
 
@@ -974,7 +965,7 @@ namespace OpenMS
       feature.setMetaValue("sum_formula", contaminants_[i].sf.toString()); // formula without adducts or charges
       feature.setCharge(contaminants_[i].q);
       feature.setMetaValue("charge_adducts", "H" + String(contaminants_[i].q)); // adducts separately
-      add2DSignal_(feature, exp, exp_ct);
+      add2DSignal_(feature, exp, exp_ct, rnd_gen_->getTechnicalRng());
       c_map.push_back(feature);
     }
 
@@ -1173,6 +1164,14 @@ namespace OpenMS
     return;
   }
 
+  void RawMSSignalSimulation::sortByPositionAndIntensity_(SimTypes::MSSimExperiment::SpectrumType& spectrum)
+  {
+    std::sort(spectrum.begin(), spectrum.end(), [](const SimTypes::SimPointType& a, const SimTypes::SimPointType& b)
+    {
+      return a.getMZ() < b.getMZ() || (a.getMZ() == b.getMZ() && a.getIntensity() < b.getIntensity());
+    });
+  }
+
   // TODO: add instrument specific sampling technique
   void RawMSSignalSimulation::compressSignals_(SimTypes::MSSimExperiment& experiment)
   {
@@ -1206,10 +1205,9 @@ namespace OpenMS
       if (experiment[i].size() <= 1)
         continue;
 
-      if (experiment[i].isSorted() == false) // this should be true - however we check
-      {
-        experiment[i].sortByPosition();
-      }
+      // peaks from several features can share an m/z; a fixed order makes the sums below independent of the order
+      // in which the peaks were added (e.g. by different threads)
+      sortByPositionAndIntensity_(experiment[i]);
 
       // copy Spectrum and remove Peaks ..
       SimTypes::MSSimExperiment::SpectrumType cont = experiment[i];
@@ -1285,7 +1283,7 @@ namespace OpenMS
     return;
   }
 
-  SimTypes::SimIntensityType RawMSSignalSimulation::getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity, const SimTypes::SimIntensityType natural_scaling_factor)
+  SimTypes::SimIntensityType RawMSSignalSimulation::getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity, const SimTypes::SimIntensityType natural_scaling_factor, boost::random::mt19937_64& rng)
   {
     SimTypes::SimIntensityType intensity = feature_intensity * natural_scaling_factor * intensity_scale_;
 
@@ -1294,7 +1292,7 @@ namespace OpenMS
     // TODO: variables model f??r den intensit??ts-einfluss
     // e.g. sqrt(intensity) || ln(intensity)
     boost::normal_distribution<SimTypes::SimIntensityType> ndist(0, intensity_scale_stddev_ * intensity);
-    intensity += ndist(rnd_gen_->getTechnicalRng());
+    intensity += ndist(rng);
 
     return intensity;
   }
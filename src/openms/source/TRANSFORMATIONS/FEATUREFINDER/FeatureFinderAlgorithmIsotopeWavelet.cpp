@@ -36,6 +36,12 @@
 
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/IsotopeWaveletTransform.h>
 
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
   FeatureFinderAlgorithmIsotopeWavelet::FeatureFinderAlgorithmIsotopeWavelet()
@@ -178,101 +184,148 @@ namespace OpenMS
     this->ff_->startProgress(0, 2 * this->map_->size() * max_charge_, "analyzing spectra");
 
     IsotopeWaveletTransform<PeakType>* iwt = new IsotopeWaveletTransform<PeakType>(min_mz, max_mz, max_charge_, max_size, hr_data_, intensity_type_);
-    for (UInt i = 0; i < this->map_->size(); ++i)
-    {
-      const MSSpectrum& c_ref((*this->map_)[i]);
 
-#ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
-      std::cout << ::std::fixed << ::std::setprecision(6) << "Spectrum " << i + 1 << " (" << (*this->map_)[i].getRT() << ") of " << this->map_->size() << " ... ";
-      std::cout.flush();
+    //The scans are processed in blocks: first, the transforms of all scans and charge states of a block are computed
+    //in parallel (they only depend on the scan itself). Afterwards, charge recognition and the sweep line consume the
+    //transforms in scan order, since they modify the (shared) box state of the transform object.
+#ifdef _OPENMP
+    const SignedSize block_size = 4 * omp_get_max_threads();
+#else
+    const SignedSize block_size = 1;
 #endif
+    const SignedSize num_scans = (SignedSize)this->map_->size();
+    for (SignedSize block_start = 0; block_start < num_scans; block_start += block_size)
+    {
+      const SignedSize block_scans = std::min(block_size, num_scans - block_start);
 
-      if (c_ref.size() <= 1)                 //unable to do transform anything
-      {
-#ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
-        std::cout << "scan empty or consisting of a single data point. Skipping." << std::endl;
-#endif
-        this->ff_->setProgress(progress_counter_ += 2);
-        continue;
-      }
+      std::vector<MSSpectrum> hr_specs(hr_data_ ? block_scans : 0); //interpolated scans (HighRes data only)
+      std::vector<std::vector<double> > mzs(block_scans), intens(block_scans);
+      std::vector<double> min_spacings(block_scans, INT_MAX);
+      std::vector<MSSpectrum> transforms(block_scans * max_charge_);
 
-      if (!hr_data_)                   //LowRes data
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize s = 0; s < block_scans; ++s)
       {
-        iwt->initializeScan((*this->map_)[i]);
-        for (UInt c = 0; c < max_charge_; ++c)
+        if ((*this->map_)[block_start + s].size() <= 1) //unable to do transform anything
         {
-          MSSpectrum c_trans(c_ref);
+          continue;
+        }
 
-          iwt->getTransform(c_trans, c_ref, c);
+        if (hr_data_)
+        {
+          MSSpectrum* new_spec = createHRData(block_start + s);
+          hr_specs[s] = *new_spec;
+          delete (new_spec); new_spec = nullptr;
+        }
 
-#ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
-          std::stringstream stream;
-          stream << "cpu_lowres_" << c_ref.getRT() << "_" << c + 1 << ".trans\0";
-          std::ofstream ofile(stream.str().c_str());
-          for (UInt k = 0; k < c_ref.size(); ++k)
+        const MSSpectrum& c_ref(hr_data_ ? hr_specs[s] : (*this->map_)[block_start + s]);
+        mzs[s].resize(c_ref.size());
+        intens[s].resize(c_ref.size());
+        for (Size k = 0; k < c_ref.size(); ++k)
+        {
+          mzs[s][k] = c_ref[k].getMZ();
+          intens[s][k] = c_ref[k].getIntensity();
+          if (k > 0)
           {
-            ofile << ::std::setprecision(8) << std::fixed << c_trans[k].getMZ() << "\t" << c_trans[k].getIntensity() << "\t" << c_ref[k].getIntensity() << std::endl;
+            min_spacings[s] = std::min(min_spacings[s], mzs[s][k] - mzs[s][k - 1]);
           }
-          ofile.close();
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
+      for (SignedSize job = 0; job < block_scans * (SignedSize)max_charge_; ++job)
+      {
+        const SignedSize s = job / max_charge_;
+        const UInt c = job % max_charge_;
+        if (mzs[s].empty())
+        {
+          continue;
+        }
 
-#ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
-          std::cout << "transform O.K. ... "; std::cout.flush();
+        //the same number of data points left of the wavelet's maximum as set by IsotopeWaveletTransform::initializeScan
+        const Int from_max_to_left = (UInt) (Constants::IW_QUARTER_NEUTRON_MASS / min_spacings[s]);
+        std::vector<double> trans;
+        IsotopeWaveletTransform<PeakType>::computeTransform(trans, mzs[s], intens[s], c, from_max_to_left, min_spacings[s], hr_data_);
+
+        MSSpectrum& c_trans(transforms[job]);
+        c_trans = hr_data_ ? hr_specs[s] : (*this->map_)[block_start + s];
+        for (Size k = 0; k < trans.size(); ++k)
+        {
+          c_trans[k].setIntensity(trans[k]);
+        }
+
+        IF_MASTERTHREAD this->ff_->setProgress(progress_counter_);
+#ifdef _OPENMP
+#pragma omp atomic
 #endif
-          this->ff_->setProgress(++progress_counter_);
+        ++progress_counter_;
+      }
 
-          iwt->identifyCharge(c_trans, c_ref, i, c, intensity_threshold_, check_PPMs_);
+      for (SignedSize s = 0; s < block_scans; ++s)
+      {
+        const UInt i = block_start + s;
+        const MSSpectrum& c_ref((*this->map_)[i]);
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
-          std::cout << "charge recognition O.K. ... "; std::cout.flush();
+        std::cout << ::std::fixed << ::std::setprecision(6) << "Spectrum " << i + 1 << " (" << (*this->map_)[i].getRT() << ") of " << this->map_->size() << " ... ";
+        std::cout.flush();
 #endif
-          this->ff_->setProgress(++progress_counter_);
+
+        if (c_ref.size() <= 1)                 //unable to do transform anything
+        {
+#ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
+          std::cout << "scan empty or consisting of a single data point. Skipping." << std::endl;
+#endif
+          this->ff_->setProgress(progress_counter_ += 2);
+          continue;
         }
-      }
-      else                   //HighRes data
-      {
-        for (UInt c = 0; c < max_charge_; ++c)
+
+        //for HighRes data, the transforms have been computed on the interpolated scan
+        const MSSpectrum& c_spec(hr_data_ ? hr_specs[s] : c_ref);
+        if (!hr_data_)                   //LowRes data
         {
-          MSSpectrum* new_spec = createHRData(i);
-          iwt->initializeScan(*new_spec, c);
-          MSSpectrum c_trans(*new_spec);
+          iwt->initializeScan(c_spec);
+        }
 
-          iwt->getTransformHighRes(c_trans, *new_spec, c);
+        for (UInt c = 0; c < max_charge_; ++c)
+        {
+          if (hr_data_)                   //HighRes data
+          {
+            iwt->initializeScan(c_spec, c);
+          }
+          const MSSpectrum& c_trans(transforms[s * max_charge_ + c]);
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::stringstream stream;
-          stream << "cpu_highres_" << new_spec->getRT() << "_" << c + 1 << ".trans\0";
+          stream << (hr_data_ ? "cpu_highres_" : "cpu_lowres_") << c_spec.getRT() << "_" << c + 1 << ".trans\0";
           std::ofstream ofile(stream.str().c_str());
-          for (UInt k = 0; k < new_spec->size(); ++k)
+          for (UInt k = 0; k < c_spec.size(); ++k)
           {
-            ofile << ::std::setprecision(8) << std::fixed << c_trans[k].getMZ() << "\t" << c_trans[k].getIntensity() << "\t" << (*new_spec)[k].getIntensity() << std::endl;
+            ofile << ::std::setprecision(8) << std::fixed << c_trans[k].getMZ() << "\t" << c_trans[k].getIntensity() << "\t" << c_spec[k].getIntensity() << std::endl;
           }
           ofile.close();
-#endif
-
-#ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::cout << "transform O.K. ... "; std::cout.flush();
 #endif
-          this->ff_->setProgress(++progress_counter_);
 
-          iwt->identifyCharge(c_trans, *new_spec, i, c, intensity_threshold_, check_PPMs_);
+          iwt->identifyCharge(c_trans, c_spec, i, c, intensity_threshold_, check_PPMs_);
 
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
           std::cout << "charge recognition O.K. ... "; std::cout.flush();
 #endif
           this->ff_->setProgress(++progress_counter_);
-
-          delete (new_spec); new_spec = nullptr;
         }
-      }
-
 
-      iwt->updateBoxStates(*this->map_, i, RT_interleave_, real_RT_votes_cutoff_);
+        iwt->updateBoxStates(*this->map_, i, RT_interleave_, real_RT_votes_cutoff_);
 #ifdef OPENMS_DEBUG_ISOTOPE_WAVELET
-      std::cout << "updated box states." << std::endl;
+        std::cout << "updated box states." << std::endl;
 #endif
 
-      std::cout.flush();
+        std::cout.flush();
+      }
     }
 
     this->ff_->endProgress();
@@ -604,16 +604,18 @@ namespace OpenMS
       // the map seeds_in_features which contains for each seed i a vector
       // of other seeds that are contained in the corresponding feature i.
       //
-      // The features are stored in an temporary feature map until it is
+      // The features are stored in a temporary per-seed slot until it is
       // decided whether they are contained within a seed of higher
-      // intensity.
-      std::map<Size, std::vector<Size> > seeds_in_features;
-      typedef std::map<Size, Feature> FeatureMapType;
-      FeatureMapType tmp_feature_map;
+      // intensity. Each seed owns its slot, so threads never share state
+      // and no locking is required while extending seeds.
+      std::vector<std::vector<Size> > seeds_in_features(seeds.size());
+      std::vector<Feature> tmp_features(seeds.size());
+      std::vector<char> has_feature(seeds.size(), 0);
+      std::vector<String> seed_abort_reasons(seeds.size());
       int gl_progress = 0;
       ff_->startProgress(0, seeds.size(), String("Extending seeds for charge ") + String(c));
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 16)
 #endif
       for (SignedSize i = 0; i < (SignedSize)seeds.size(); ++i)
       {
@@ -646,7 +648,7 @@ namespace OpenMS
 
         if (isotope_fit_quality < min_isotope_fit_)
         {
-          abort_(seeds[i], "Could not find good enough isotope pattern containing the seed");
+          seed_abort_reasons[i] = "Could not find good enough isotope pattern containing the seed";
           //continue;
         }
         else
@@ -662,7 +664,7 @@ namespace OpenMS
 
           if (!traces.isValid(seed_mz, trace_tolerance_))
           {
-            abort_(seeds[i], "Could not extend seed");
+            seed_abort_reasons[i] = "Could not extend seed";
             //continue;
           }
           else
@@ -675,11 +677,9 @@ namespace OpenMS
             Int plot_nr = -1;
 
 #ifdef _OPENMP
-#pragma omp critical (FeatureFinderAlgorithmPicked_PLOTNR)
+#pragma omp atomic capture
 #endif
-            {
-              plot_nr = ++plot_nr_global;
-            }
+            plot_nr = ++plot_nr_global;
 
             //------------------------------------------------------------------
 
@@ -734,15 +734,13 @@ namespace OpenMS
             double final_score = 0.0;
 
             bool feature_ok = checkFeatureQuality_(fitter, new_traces, seed_mz, min_feature_score, error_msg, fit_score, correlation, final_score);
+            //write debug output of feature
+            if (debug_)
+            {
 #ifdef _OPENMP
 #pragma omp critical (FeatureFinderAlgorithmPicked_DEBUG)
 #endif
-            {
-              //write debug output of feature
-              if (debug_)
-              {
-                writeFeatureDebugInfo_(fitter, traces, new_traces, feature_ok, error_msg, final_score, plot_nr, peak);
-              }
+              writeFeatureDebugInfo_(fitter, traces, new_traces, feature_ok, error_msg, final_score, plot_nr, peak);
             }
             traces = new_traces;
 
@@ -750,7 +748,7 @@ namespace OpenMS
             //validity output
             if (!feature_ok)
             {
-              abort_(seeds[i], error_msg);
+              seed_abort_reasons[i] = error_msg;
               //continue;
             }
             else
@@ -820,13 +818,6 @@ namespace OpenMS
                 f.getConvexHulls().push_back(traces[j].getConvexhull());
               }
 
-#ifdef _OPENMP
-#pragma omp critical (FeatureFinderAlgorithmPicked_TMPFEATUREMAP)
-#endif
-              {
-                tmp_feature_map[i] = f;
-              }
-
               //----------------------------------------------------------------
               //Remember all seeds that lie inside the convex hull of the new feature
               DBoundingBox<2> bb = f.getConvexHull().getBoundingBox();
@@ -836,47 +827,44 @@ namespace OpenMS
                 double mz = map_[seeds[j].spectrum][seeds[j].peak].getMZ();
                 if (bb.encloses(rt, mz) && f.encloses(rt, mz))
                 {
-#ifdef _OPENMP
-#pragma omp critical (FeatureFinderAlgorithmPicked_SEEDSINFEATURES)
-#endif
-                  {
-                    seeds_in_features[i].push_back(j);
-                  }
+                  seeds_in_features[i].push_back(j);
                 }
               }
+
+              tmp_features[i] = f;
+              has_feature[i] = 1;
             }
           }
         } // three if/else statements instead of continue (disallowed in OpenMP)
       } // end of OPENMP over seeds
 
+      // record abort reasons in seed order (not thread-safe, thus done here)
+      for (Size i = 0; i < seeds.size(); ++i)
+      {
+        if (!seed_abort_reasons[i].empty()) abort_(seeds[i], seed_abort_reasons[i]);
+      }
+
       // Here we have to evaluate which seeds are already contained in
       // features of seeds with higher intensities. Only if the seed is not
       // used in any feature with higher intensity, we can add it to the
       // features_ list.
-      std::vector<Size> seeds_contained;
-      for (std::map<Size, Feature>::iterator iter = tmp_feature_map.begin(); iter != tmp_feature_map.end(); ++iter)
+      std::vector<char> seed_contained(seeds.size(), 0);
+      for (Size seed_nr = 0; seed_nr < seeds.size(); ++seed_nr)
       {
-        Size seed_nr = iter->first;
-        bool is_used = false;
-        for (Size i = 0; i < seeds_contained.size(); ++i)
-        {
-          if (seed_nr == seeds_contained[i]) { is_used = true; break; }
-        }
-        if (!is_used)
-        {
-          ++feature_candidates;
+        if (!has_feature[seed_nr] || seed_contained[seed_nr]) continue;
 
-          //re-set label
-          iter->second.setMetaValue(3, feature_nr_global);
-          ++feature_nr_global;
-          features_->push_back(iter->second);
+        ++feature_candidates;
 
-          std::vector<Size> curr_seed = seeds_in_features[seed_nr];
-          for (Size k = 0; k < curr_seed.size(); ++k)
-          {
-            seeds_contained.push_back(curr_seed[k]);
+        //re-set label
+        tmp_features[seed_nr].setMetaValue(3, feature_nr_global);
+        ++feature_nr_global;
+        features_->push_back(tmp_features[seed_nr]);
+        tmp_features[seed_nr] = Feature(); // release memory early
 
-          }
+        const std::vector<Size>& curr_seed = seeds_in_features[seed_nr];
+        for (Size k = 0; k < curr_seed.size(); ++k)
+        {
+          seed_contained[curr_seed[k]] = 1;
         }
       }
 
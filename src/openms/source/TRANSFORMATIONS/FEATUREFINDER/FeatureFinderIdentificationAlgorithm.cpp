@@ -40,12 +40,14 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/TraceFitter.h>
 
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractor.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 #include <OpenMS/ANALYSIS/SVM/SimpleSVM.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmIdentification.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 #include <vector>
 #include <numeric>
@@ -61,7 +63,8 @@ using namespace std;
 namespace OpenMS
 {
   FeatureFinderIdentificationAlgorithm::FeatureFinderIdentificationAlgorithm() :
-    DefaultParamHandler("FeatureFinderIdentificationAlgorithm")
+    DefaultParamHandler("FeatureFinderIdentificationAlgorithm"),
+    keep_chromatograms_(true)
   {
     StringList output_file_tags;
     output_file_tags.push_back("output file");
@@ -97,6 +100,13 @@ namespace OpenMS
       ListUtils::create<String>("advanced"));
     defaults_.setMinFloat("extract:rt_window", 0.0);
 
+    defaults_.setValue(
+      "extract:batch_size",
+      5000,
+      "Number of peptide assays (per charge state and RT region) for which chromatograms are extracted and processed together. Batches are formed in order of RT and processed in parallel; smaller batches need less memory. Set to 0 to process all assays at once.",
+      ListUtils::create<String>("advanced"));
+    defaults_.setMinInt("extract:batch_size", 0);
+
     defaults_.setSectionDescription("extract", "Parameters for ion chromatogram extraction");
 
     defaults_.setValue("detect:peak_width", 60.0, "Expected elution peak width in seconds, for smoothing (Gauss filter). Also determines the RT extration window, unless set explicitly via 'extract:rt_window'.");
@@ -268,31 +278,159 @@ namespace OpenMS
     //-------------------------------------------------------------
     // run feature detection
     //-------------------------------------------------------------
-    LOG_INFO << "Extracting chromatograms..." << endl;
-    ChromatogramExtractor extractor;
-    // extractor.setLogType(ProgressLogger::NONE);
-    vector<OpenSwath::ChromatogramPtr> chrom_temp;
-    vector<ChromatogramExtractor::ExtractionCoordinates> coords;
-    extractor.prepare_coordinates(chrom_temp, coords, library_,
-                                  numeric_limits<double>::quiet_NaN(), false);
-
-    boost::shared_ptr<PeakMap> shared = boost::make_shared<PeakMap>(ms_data_);
-    OpenSwath::SpectrumAccessPtr spec_temp =
-      SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(shared);
-    extractor.extractChromatograms(spec_temp, chrom_temp, coords, mz_window_,
-                                   mz_window_ppm_, "tophat");
-    extractor.return_chromatogram(chrom_temp, coords, library_, (*shared)[0],
-                                  chrom_data_.getChromatograms(), false);
+    // The assays are processed in batches (sorted by RT), so only the
+    // chromatograms of the current batches have to be kept in memory.
+    // Batches are extracted and picked in parallel; the MS1 data is accessed
+    // in place (not copied).
+    vector<vector<Size> > batches;
+    const vector<TargetedExperiment::Peptide>& assays = library_.getPeptides();
+    if ((batch_size_ == 0) || (assays.size() <= batch_size_))
+    {
+      batches.resize(1); // empty index list: use the whole library
+    }
+    else
+    {
+      vector<pair<double, Size> > assay_rts;
+      assay_rts.reserve(assays.size());
+      for (Size i = 0; i < assays.size(); ++i)
+      {
+        assay_rts.push_back(make_pair(assays[i].getRetentionTime(), i));
+      }
+      sort(assay_rts.begin(), assay_rts.end());
+      for (Size i = 0; i < assay_rts.size(); ++i)
+      {
+        if (i % batch_size_ == 0) batches.push_back(vector<Size>());
+        batches.back().push_back(assay_rts[i].second);
+      }
+    }
+    map<String, vector<Size> > transitions_by_assay;
+    if (batches.size() > 1)
+    {
+      for (Size i = 0; i < library_.getTransitions().size(); ++i)
+      {
+        transitions_by_assay[library_.getTransitions()[i].getPeptideRef()].push_back(i);
+      }
+    }
 
-    LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
-              << " chromatogram(s)." << endl;
+    LOG_INFO << "Extracting chromatograms and detecting chromatographic peaks ("
+             << batches.size() << " batch(es))..." << endl;
+    OpenSwath::SpectrumAccessPtr spec_temp =
+      SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtrNoCopy(ms_data_);
+    SpectrumSettings spec_settings = ms_data_[0];
+    Param feat_finder_param = feat_finder_.getParameters();
+    vector<FeatureMap> batch_features(batches.size());
+    vector<PeakMap> batch_chroms(keep_chromatograms_ ? batches.size() : 0);
 
-    LOG_INFO << "Detecting chromatographic peaks..." << endl;
     // suppress status output from OpenSWATH, unless in debug mode:
     if (debug_level_ < 1) Log_info.remove(cout);
-    feat_finder_.pickExperiment(chrom_data_, features, library_,
-                                TransformationDescription(), ms_data_);
+    Size progress = 0;
+    prog_log_.startProgress(0, batches.size(), "extracting and picking chromatograms");
+    ParallelExceptionCollector exceptions;
+    // with only one batch, leave the parallelization to the peak picking:
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) if (batches.size() > 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)batches.size(); ++i)
+    {
+      try
+      {
+        // assays of the current batch (a single batch uses the library as is):
+        TargetedExperiment subset;
+        TargetedExperiment& batch_library = (batches[i].empty() ? library_ : subset);
+        if (!batches[i].empty())
+        {
+          subset.setProteins(library_.getProteins());
+          for (vector<Size>::const_iterator it = batches[i].begin();
+               it != batches[i].end(); ++it)
+          {
+            subset.addPeptide(assays[*it]);
+            map<String, vector<Size> >::const_iterator pos =
+              transitions_by_assay.find(assays[*it].id);
+            if (pos == transitions_by_assay.end()) continue;
+            for (vector<Size>::const_iterator tr_it = pos->second.begin();
+                 tr_it != pos->second.end(); ++tr_it)
+            {
+              subset.addTransition(library_.getTransitions()[*tr_it]);
+            }
+          }
+        }
+
+        // extract chromatograms:
+        ChromatogramExtractor extractor;
+        vector<OpenSwath::ChromatogramPtr> chrom_temp;
+        vector<ChromatogramExtractor::ExtractionCoordinates> coords;
+        extractor.prepare_coordinates(chrom_temp, coords, batch_library,
+                                      numeric_limits<double>::quiet_NaN(), false);
+        // light clone, so that threads do not share a file stream (if cached):
+        extractor.extractChromatograms(spec_temp->lightClone(), chrom_temp,
+                                       coords, mz_window_, mz_window_ppm_,
+                                       "tophat");
+        // "return_chromatogram" annotates the data processing objects, which
+        // are shared between copies of the settings - use private copies:
+        SpectrumSettings settings = spec_settings;
+        for (Size j = 0; j < settings.getDataProcessing().size(); ++j)
+        {
+          settings.getDataProcessing()[j] = DataProcessingPtr(
+            new DataProcessing(*settings.getDataProcessing()[j]));
+        }
+        PeakMap chroms;
+        extractor.return_chromatogram(chrom_temp, coords, batch_library,
+                                      settings, chroms.getChromatograms(),
+                                      false);
+        chrom_temp.clear();
+
+        // detect chromatographic peaks:
+        OpenSwath::LightTargetedExperiment batch_assays;
+        OpenSwathDataAccessHelper::convertTargetedExp(batch_library,
+                                                      batch_assays);
+        OpenSwath::SwathMap swath_map;
+        swath_map.sptr = spec_temp->lightClone();
+        MRMFeatureFinderScoring::TransitionGroupMapType transition_groups;
+        MRMFeatureFinderScoring feat_finder;
+        feat_finder.setParameters(feat_finder_param);
+        feat_finder.setStrictFlag(false);
+        feat_finder.pickExperiment(
+          SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtrNoCopy(chroms),
+          batch_features[i], batch_assays, TransformationDescription(),
+          vector<OpenSwath::SwathMap>(1, swath_map), transition_groups);
+
+        if (keep_chromatograms_) batch_chroms[i].getChromatograms().swap(chroms.getChromatograms());
+      }
+      catch (...)
+      {
+        exceptions.capture();
+      }
+
+      IF_MASTERTHREAD prog_log_.setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ++progress;
+    }
+    prog_log_.endProgress();
     if (debug_level_ < 1) Log_info.insert(cout); // revert logging change
+    exceptions.rethrow();
+
+    // collect results (in batch order, independent of the number of threads):
+    for (Size i = 0; i < batches.size(); ++i)
+    {
+      for (FeatureMap::ConstIterator it = batch_features[i].begin();
+           it != batch_features[i].end(); ++it)
+      {
+        features.push_back(*it);
+      }
+      batch_features[i].clear(true);
+      if (keep_chromatograms_)
+      {
+        chrom_data_.getChromatograms().insert(
+          chrom_data_.getChromatograms().end(),
+          batch_chroms[i].getChromatograms().begin(),
+          batch_chroms[i].getChromatograms().end());
+        batch_chroms[i].clear(true);
+      }
+    }
+    LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
+              << " chromatogram(s)." << endl;
     LOG_INFO << "Found " << features.size() << " feature candidates in total."
              << endl;
     ms_data_.reset(); // not needed anymore, free up the memory
@@ -975,6 +1113,7 @@ namespace OpenMS
 
     isotope_pmin_ = param_.getValue("extract:isotope_pmin");
     n_isotopes_ = param_.getValue("extract:n_isotopes");
+    batch_size_ = (Int)param_.getValue("extract:batch_size");
 
     mapping_tolerance_ = param_.getValue("detect:mapping_tolerance");
 
@@ -399,6 +399,27 @@ namespace OpenMS
     
   }
   
+  bool MultiplexFiltering::checkBlacklist_(const MultiplexFilteredPeak& peak) const
+  {
+    // The primary peak may be white or the mono-isotopic peak of the lightest (or only) peptide, see filterPeakPositions_().
+    if (blacklist_[peak.getRTidx()][peak.getMZidx()] > 0)
+    {
+      return false;
+    }
+    
+    // Satellites may be white or have been seen earlier as part of the same mass trace.
+    for (const auto &it : peak.getSatellites())
+    {
+      int entry = blacklist_[(it.second).getRTidx()][(it.second).getMZidx()];
+      if ((entry != -1) && (entry != static_cast<int>(it.first)))
+      {
+        return false;
+      }
+    }
+    
+    return true;
+  }
+  
   bool MultiplexFiltering::filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const MultiplexFilteredPeak& peak) const
   {
     // construct averagine distribution
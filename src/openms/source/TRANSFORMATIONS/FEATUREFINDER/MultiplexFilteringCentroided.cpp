@@ -38,6 +38,11 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFilteringCentroided.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // #define DEBUG
 
@@ -67,6 +72,7 @@ namespace OpenMS
 #endif
 
     // loop over all patterns
+    // (The patterns are searched in order, since peaks found for a pattern are blacklisted for all subsequent ones.)
     for (unsigned pattern_idx = 0; pattern_idx < patterns_.size(); ++pattern_idx)
     {
       // current pattern
@@ -79,40 +85,66 @@ namespace OpenMS
       updateWhiteMSExperiment_();
   
       // filter (white) experiment
-      // loop over spectra
-      for (const auto &it_rt : exp_centroided_white_)
+      // The spectra are filtered in parallel against the blacklist as it is now, i.e. at the start of the pattern.
+      // Peaks failing filterPeakPositions_() would fail it as well after further blacklisting. All other peaks are collected as candidates.
+      std::vector<std::vector<FilteredCandidate_> > candidates(exp_centroided_white_.size());
+      ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize idx_rt = 0; idx_rt < (SignedSize) exp_centroided_white_.size(); ++idx_rt)
       {
+        const MSSpectrum& spectrum = exp_centroided_white_[idx_rt];
+        
         // skip empty spectra
-        if (it_rt.empty())
+        if (spectrum.empty())
         {
           continue;
         }
 
-        setProgress(++progress);
-
-        double rt = it_rt.getRT();
-        size_t idx_rt = &it_rt - &exp_centroided_white_[0];
-        
-        MSExperiment::ConstIterator it_rt_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
-        MSExperiment::ConstIterator it_rt_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
-        
-        // loop over m/z
-        for (MSSpectrum::ConstIterator it_mz = it_rt.begin(); it_mz != it_rt.end(); ++it_mz)
+        try
         {
-          double mz = it_mz->getMZ();
-          MultiplexFilteredPeak peak(mz, rt, exp_centroided_mapping_[idx_rt][it_mz - it_rt.begin()], idx_rt);
-          
-          if (!(filterPeakPositions_(it_mz, exp_centroided_white_.begin(), it_rt_band_begin, it_rt_band_end, pattern, peak)))
+          // loop over m/z
+          for (size_t idx_mz = 0; idx_mz < spectrum.size(); ++idx_mz)
           {
-            continue;
+            FilteredCandidate_ candidate(idx_mz, MultiplexFilteredPeak(spectrum[idx_mz].getMZ(), spectrum.getRT(), exp_centroided_mapping_[idx_rt].at(idx_mz), idx_rt));
+            if (filterPeak_(pattern, idx_rt, candidate))
+            {
+              candidates[idx_rt].push_back(candidate);
+            }
           }
-          
-          if (!(filterAveragineModel_(pattern, peak)))
+        }
+        catch (...)
+        {
+          exceptions.capture();
+        }
+
+        IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        ++progress;
+      }
+      exceptions.rethrow();
+
+      // accept the candidates in the original order of spectra and peaks
+      for (size_t idx_rt = 0; idx_rt < candidates.size(); ++idx_rt)
+      {
+        for (auto &candidate : candidates[idx_rt])
+        {
+          // Peaks accepted in the meantime may have blacklisted some of the satellites. In that case, we filter the peak once more.
+          if (!checkBlacklist_(candidate.peak))
           {
-            continue;
+            const MultiplexFilteredPeak& peak = candidate.peak;
+            FilteredCandidate_ refiltered(candidate.mz_idx, MultiplexFilteredPeak(peak.getMZ(), peak.getRT(), peak.getMZidx(), peak.getRTidx()));
+            if (!filterPeak_(pattern, idx_rt, refiltered))
+            {
+              continue;
+            }
+            candidate = refiltered;
           }
 
-          if (!(filterPeptideCorrelation_(pattern, peak)))
+          if (!candidate.passed)
           {
             continue;
           }
@@ -121,8 +153,8 @@ namespace OpenMS
            * All filters passed.
            */
 
-          result.addPeak(peak);
-          blacklistPeak_(peak, pattern_idx);
+          result.addPeak(candidate.peak);
+          blacklistPeak_(candidate.peak, pattern_idx);
         }
       }
       
@@ -147,4 +179,22 @@ namespace OpenMS
     return filter_results;
   }
   
+  bool MultiplexFilteringCentroided::filterPeak_(const MultiplexIsotopicPeakPattern& pattern, size_t idx_rt, FilteredCandidate_& candidate) const
+  {
+    MSExperiment::ConstIterator it_rt = exp_centroided_white_.begin() + idx_rt;
+    MSSpectrum::ConstIterator it_mz = it_rt->begin() + candidate.mz_idx;
+    double rt = it_rt->getRT();
+    
+    MSExperiment::ConstIterator it_rt_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
+    MSExperiment::ConstIterator it_rt_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
+    
+    if (!(filterPeakPositions_(it_mz, exp_centroided_white_.begin(), it_rt_band_begin, it_rt_band_end, pattern, candidate.peak)))
+    {
+      return false;
+    }
+    
+    candidate.passed = filterAveragineModel_(pattern, candidate.peak) && filterPeptideCorrelation_(pattern, candidate.peak);
+    return true;
+  }
+  
 }
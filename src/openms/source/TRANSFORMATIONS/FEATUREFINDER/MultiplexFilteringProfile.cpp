@@ -39,6 +39,11 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFilteringProfile.h>
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 //#define DEBUG
 
@@ -139,6 +144,7 @@ namespace OpenMS
     }
     
     // loop over all patterns
+    // (The patterns are searched in order, since peaks found for a pattern are blacklisted for all subsequent ones.)
     for (unsigned pattern_idx = 0; pattern_idx < patterns_.size(); ++pattern_idx)
     {
       // current pattern
@@ -150,108 +156,81 @@ namespace OpenMS
       // update white experiment
       updateWhiteMSExperiment_();
       
-      // loop over spectra
-      // loop simultaneously over RT in the spline interpolated profile and (white) centroided experiment (including peak boundaries)
-      for (const auto &it_rt : exp_centroided_white_)
+      // filter (white) experiment
+      // The spectra are filtered in parallel against the blacklist as it is now, i.e. at the start of the pattern.
+      // Peaks failing filterPeakPositions_() would fail it as well after further blacklisting. All other peaks are collected as candidates.
+      std::vector<std::vector<FilteredCandidate_> > candidates(exp_centroided_white_.size());
+      ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
       {
-        // retention time
-        double rt = it_rt.getRT();
-        // spectral index in exp_centroided_white_, boundaries_ and exp_spline_profile_
-        size_t idx_rt = &it_rt - &exp_centroided_white_[0];
-        
-        // skip empty spectra
-        if (it_rt.size() == 0 || boundaries_[idx_rt].size() == 0 || exp_spline_profile_[idx_rt].size() == 0)
-        {
-          continue;
-        }
-        
-        setProgress(++progress);
-        
-        MSExperiment::ConstIterator it_rt_picked_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
-        MSExperiment::ConstIterator it_rt_picked_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
-        
-        // loop over mz
-        for (MSSpectrum::ConstIterator it_mz = it_rt.begin(); it_mz != it_rt.end(); ++it_mz)
+        // thread-local navigators
+        std::vector<SplineInterpolatedPeaks::Navigator> navigators_thread(navigators);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize idx_rt = 0; idx_rt < (SignedSize) exp_centroided_white_.size(); ++idx_rt)
         {
-          double mz = it_mz->getMZ();
-          MultiplexFilteredPeak peak(mz, rt, exp_centroided_mapping_[idx_rt][it_mz - it_rt.begin()], idx_rt);
+          const MSSpectrum& spectrum = exp_centroided_white_[idx_rt];
           
-          if (!(filterPeakPositions_(it_mz, exp_centroided_white_.begin(), it_rt_picked_band_begin, it_rt_picked_band_end, pattern, peak)))
+          // skip empty spectra
+          if (spectrum.size() == 0 || boundaries_[idx_rt].size() == 0 || exp_spline_profile_[idx_rt].size() == 0)
           {
             continue;
           }
           
-          size_t mz_idx = exp_centroided_mapping_[idx_rt][it_mz - it_rt.begin()];
-          double peak_min = boundaries_[idx_rt][mz_idx].mz_min;
-          double peak_max = boundaries_[idx_rt][mz_idx].mz_max;
-          
-          //double rt_peak = peak.getRT();
-          double mz_peak = peak.getMZ();
-
-          std::multimap<size_t, MultiplexSatelliteCentroided > satellites = peak.getSatellites();
-          
-          // Arrangement of peaks looks promising. Now scan through the spline fitted profile data around the peak i.e. from peak boundary to peak boundary.
-          for (double mz_profile = peak_min; mz_profile < peak_max; mz_profile = navigators[idx_rt].getNextPos(mz_profile))
+          try
           {
-            // determine m/z shift relative to the centroided peak at which the profile data will be sampled
-            double mz_shift = mz_profile - mz_peak;
-
-            std::multimap<size_t, MultiplexSatelliteProfile > satellites_profile;
-
-            // construct the set of spline-interpolated satellites for this specific mz_profile
-            for (const auto &satellite_it : satellites)
-            {
-              // find indices of the peak
-              size_t rt_idx = (satellite_it.second).getRTidx();
-              size_t mz_idx = (satellite_it.second).getMZidx();
-              
-              // find peak itself
-              MSExperiment::ConstIterator it_rt = exp_centroided_.begin();
-              std::advance(it_rt, rt_idx);
-              MSSpectrum::ConstIterator it_mz = it_rt->begin();
-              std::advance(it_mz, mz_idx);
-              
-              double rt_satellite = it_rt->getRT();
-              double mz_satellite = it_mz->getMZ();
-              
-              // determine m/z and corresponding intensity
-              double mz = mz_satellite + mz_shift;
-              double intensity = navigators[rt_idx].eval(mz);
-              
-              satellites_profile.insert(std::make_pair(satellite_it.first, MultiplexSatelliteProfile(rt_satellite, mz, intensity)));
-            }
-            
-            if (!(filterAveragineModel_(pattern, peak, satellites_profile)))
+            // loop over mz
+            for (size_t idx_mz = 0; idx_mz < spectrum.size(); ++idx_mz)
             {
-              continue;
+              FilteredCandidate_ candidate(idx_mz, MultiplexFilteredPeak(spectrum[idx_mz].getMZ(), spectrum.getRT(), exp_centroided_mapping_[idx_rt].at(idx_mz), idx_rt));
+              if (filterPeak_(pattern, idx_rt, navigators_thread, candidate))
+              {
+                candidates[idx_rt].push_back(candidate);
+              }
             }
-            
-            if (!(filterPeptideCorrelation_(pattern, satellites_profile)))
+          }
+          catch (...)
+          {
+            exceptions.capture();
+          }
+
+          IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          ++progress;
+        }
+      }
+      exceptions.rethrow();
+      
+      // accept the candidates in the original order of spectra and peaks
+      for (size_t idx_rt = 0; idx_rt < candidates.size(); ++idx_rt)
+      {
+        for (auto &candidate : candidates[idx_rt])
+        {
+          // Peaks accepted in the meantime may have blacklisted some of the satellites. In that case, we filter the peak once more.
+          if (!checkBlacklist_(candidate.peak))
+          {
+            const MultiplexFilteredPeak& peak = candidate.peak;
+            FilteredCandidate_ refiltered(candidate.mz_idx, MultiplexFilteredPeak(peak.getMZ(), peak.getRT(), peak.getMZidx(), peak.getRTidx()));
+            if (!filterPeak_(pattern, idx_rt, navigators, refiltered))
             {
               continue;
             }
-            
-            /**
-             * All filters passed.
-             */
-            
-            // add the satellite data points to the peak
-            for (const auto &it : satellites_profile)
-            {
-              peak.addSatelliteProfile(it.second, it.first);
-            }
-            
+            candidate = refiltered;
           }
           
           // If some satellite data points passed all filters, we can add the peak to the filter result.
-          if (peak.sizeProfile() > 0)
+          if (candidate.passed)
           {
-            result.addPeak(peak);
-            blacklistPeak_(peak, pattern_idx);
+            result.addPeak(candidate.peak);
+            blacklistPeak_(candidate.peak, pattern_idx);
           }
-          
         }
-        
       }
  
 #ifdef DEBUG
@@ -275,6 +254,87 @@ namespace OpenMS
     return filter_results;
   }
   
+  bool MultiplexFilteringProfile::filterPeak_(const MultiplexIsotopicPeakPattern& pattern, size_t idx_rt, std::vector<SplineInterpolatedPeaks::Navigator>& navigators, FilteredCandidate_& candidate) const
+  {
+    MSExperiment::ConstIterator it_rt = exp_centroided_white_.begin() + idx_rt;
+    MSSpectrum::ConstIterator it_mz = it_rt->begin() + candidate.mz_idx;
+    double rt = it_rt->getRT();
+    MultiplexFilteredPeak& peak = candidate.peak;
+    
+    MSExperiment::ConstIterator it_rt_picked_band_begin = exp_centroided_white_.RTBegin(rt - rt_band_/2);
+    MSExperiment::ConstIterator it_rt_picked_band_end = exp_centroided_white_.RTEnd(rt + rt_band_/2);
+    
+    if (!(filterPeakPositions_(it_mz, exp_centroided_white_.begin(), it_rt_picked_band_begin, it_rt_picked_band_end, pattern, peak)))
+    {
+      return false;
+    }
+    
+    size_t mz_idx = peak.getMZidx();
+    double peak_min = boundaries_[idx_rt][mz_idx].mz_min;
+    double peak_max = boundaries_[idx_rt][mz_idx].mz_max;
+    
+    //double rt_peak = peak.getRT();
+    double mz_peak = peak.getMZ();
+
+    std::multimap<size_t, MultiplexSatelliteCentroided > satellites = peak.getSatellites();
+    
+    // Arrangement of peaks looks promising. Now scan through the spline fitted profile data around the peak i.e. from peak boundary to peak boundary.
+    for (double mz_profile = peak_min; mz_profile < peak_max; mz_profile = navigators[idx_rt].getNextPos(mz_profile))
+    {
+      // determine m/z shift relative to the centroided peak at which the profile data will be sampled
+      double mz_shift = mz_profile - mz_peak;
+
+      std::multimap<size_t, MultiplexSatelliteProfile > satellites_profile;
+
+      // construct the set of spline-interpolated satellites for this specific mz_profile
+      for (const auto &satellite_it : satellites)
+      {
+        // find indices of the peak
+        size_t rt_idx = (satellite_it.second).getRTidx();
+        size_t mz_idx = (satellite_it.second).getMZidx();
+        
+        // find peak itself
+        MSExperiment::ConstIterator it_rt = exp_centroided_.begin();
+        std::advance(it_rt, rt_idx);
+        MSSpectrum::ConstIterator it_mz = it_rt->begin();
+        std::advance(it_mz, mz_idx);
+        
+        double rt_satellite = it_rt->getRT();
+        double mz_satellite = it_mz->getMZ();
+        
+        // determine m/z and corresponding intensity
+        double mz = mz_satellite + mz_shift;
+        double intensity = navigators[rt_idx].eval(mz);
+        
+        satellites_profile.insert(std::make_pair(satellite_it.first, MultiplexSatelliteProfile(rt_satellite, mz, intensity)));
+      }
+      
+      if (!(filterAveragineModel_(pattern, peak, satellites_profile)))
+      {
+        continue;
+      }
+      
+      if (!(filterPeptideCorrelation_(pattern, satellites_profile)))
+      {
+        continue;
+      }
+      
+      /**
+       * All filters passed.
+       */
+      
+      // add the satellite data points to the peak
+      for (const auto &it : satellites_profile)
+      {
+        peak.addSatelliteProfile(it.second, it.first);
+      }
+      
+    }
+    
+    candidate.passed = (peak.sizeProfile() > 0);
+    return true;
+  }
+  
   std::vector<std::vector<PeakPickerHiRes::PeakBoundary> >& MultiplexFilteringProfile::getPeakBoundaries()
   {
     return boundaries_;
@@ -44,6 +44,7 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/VISUAL/MultiGradient.h>
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
 #include <OpenMS/VISUAL/ANNOTATION/Annotations1DContainer.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/DataFilters.h>
 
@@ -166,6 +167,7 @@ public:
       param(),
       gradient(),
       filters(),
+      lod_cache(),
       annotations_1d(),
       peak_colors_1d(),
       modifiable(false),
@@ -236,6 +238,7 @@ public:
     void setPeakData(ExperimentSharedPtrType p)
     {
       peaks = p;
+      lod_cache.reset(); // built from the old data
       updateCache_();
     }
 
@@ -427,6 +430,9 @@ public:
     /// Filters to apply before painting
     DataFilters filters;
 
+    /// Level-of-detail cache of the peak data used for painting zoomed-out 2D views (null if not available)
+    boost::shared_ptr<const MaxIntensityPyramid> lod_cache;
+
     /// Annotations of all spectra of the experiment (1D view)
     std::vector<Annotations1DContainer> annotations_1d;
 
@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+// OpenMS_GUI config
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/KERNEL/StandardTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Multi-resolution RT x m/z maximum intensity pyramid of a peak map.
+
+    Used by Spectrum2DCanvas as a level-of-detail cache: when a zoomed-out view
+    contains many more peaks than pixels, the maximum intensity per pixel is
+    read from a coarse level of the pyramid instead of iterating all visible peaks.
+
+    Only MS1 spectra contribute. Level 0 is a regular grid of
+    @em rt_bins x @em mz_bins cells spanning the RT and m/z range of the data.
+    By default its resolution follows the data density: one row per MS1 spectrum
+    and (on average) CELLS_PER_PEAK cells per peak, up to MAX_CELLS cells. Views
+    zoomed in so far that level 0 is too coarse then contain only about as many
+    peaks as pixels, so painting the raw peaks is cheap again.
+    Each further level halves the resolution in both dimensions (every cell is
+    the maximum of up to 2x2 cells of the level below), down to a single cell.
+
+    The pyramid does not reference the peak map it was built from, so it can be
+    built in a background thread and handed to the GUI thread afterwards.
+    It can also be stored to and loaded from a binary file (see store() and load()),
+    which records the size and modification time of the data file it belongs to.
+
+    @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI MaxIntensityPyramid
+  {
+public:
+    /// Maximum number of cells of level 0 chosen automatically by build() (64 MB)
+    static const Size MAX_CELLS = Size(1) << 24;
+
+    /// Number of cells of level 0 per MS1 peak chosen automatically by build() (peaks are not evenly distributed)
+    static const Size CELLS_PER_PEAK = 4;
+
+    /// Default constructor (empty pyramid)
+    MaxIntensityPyramid();
+
+    /**
+      @brief Builds the pyramid from the MS1 spectra of @p map
+
+      If @p rt_bins or @p mz_bins is 0, the resolution of level 0 is derived from the data density (see class description).
+      The number of RT bins of level 0 is limited to the number of MS1 spectra.
+      Spectra and peaks are expected to be sorted (as in any valid PeakMap).
+    */
+    void build(const PeakMap& map, Size rt_bins = 0, Size mz_bins = 0);
+
+    /// Removes all levels
+    void clear();
+
+    /// Returns if the pyramid contains no data
+    bool empty() const;
+
+    /// Returns if the pyramid was built from @p map (same number of MS1 spectra and peaks, same RT range)
+    bool matches(const PeakMap& map) const;
+
+    /// Returns the number of levels (0 if empty)
+    Size getLevelCount() const;
+
+    /// Returns the number of RT bins of @p level
+    Size getRTBins(Size level) const;
+
+    /// Returns the number of m/z bins of @p level
+    Size getMZBins(Size level) const;
+
+    /**
+      @brief Returns the coarsest level whose cells are not larger than @p rt_extent x @p mz_extent
+
+      Returns getLevelCount() if even level 0 is too coarse, i.e. the raw peaks should be used.
+    */
+    Size selectLevel(double rt_extent, double mz_extent) const;
+
+    /// Returns the maximum intensity of cell (@p rt_bin, @p mz_bin) of @p level (negative if the cell contains no peaks)
+    float getCell(Size level, Size rt_bin, Size mz_bin) const;
+
+    /// Returns the maximum intensity of all cells of @p level overlapping [rt_start, rt_end) x [mz_start, mz_end) (negative if none contains peaks)
+    float getMaxIntensity(Size level, double rt_start, double rt_end, double mz_start, double mz_end) const;
+
+    /**
+      @brief Stores the pyramid in a binary file
+
+      If @p data_file is given, its size and modification time are stored as well (see load()).
+
+      @return false if the file could not be written
+    */
+    bool store(const String& filename, const String& data_file = "") const;
+
+    /**
+      @brief Loads a pyramid written by store()
+
+      If @p data_file is given, the pyramid is only loaded if it was stored for a data file of the same size and
+      modification time, and if @p filename is not older than @p data_file. A data file that was rewritten with
+      the same number of spectra and peaks (e.g. with normalized intensities) is thus not shown with outdated intensities.
+
+      @return false (leaving the pyramid empty) if the file cannot be read, has the wrong format or is outdated
+    */
+    bool load(const String& filename, const String& data_file = "");
+
+protected:
+    /// One resolution level
+    struct Level
+    {
+      Size rt_bins;
+      Size mz_bins;
+      double rt_step; ///< RT extent of one cell
+      double mz_step; ///< m/z extent of one cell
+      std::vector<float> cells; ///< row-major (RT rows), negative for empty cells
+    };
+
+    /// Determines size and modification time (ms since epoch) of @p data_file (0 if empty or not existing)
+    static void getFileStamp_(const String& data_file, UInt64& size, Int64& modification_time);
+
+    /// Counts MS1 spectra and peaks and determines the RT range of the MS1 spectra
+    static void summarize_(const PeakMap& map, Size& ms1_spectra, Size& ms1_peaks, double& rt_min, double& rt_max);
+
+    /// Resolution levels, finest first
+    std::vector<Level> levels_;
+
+    double rt_min_;
+    double mz_min_;
+    Size ms1_spectra_;
+    Size ms1_peaks_;
+    double ms1_rt_max_;
+  };
+
+} // namespace OpenMS
@@ -47,6 +47,7 @@ class QPainter;
 class QMouseEvent;
 class QAction;
 class QMenu;
+class QFutureWatcherBase;
 
 namespace OpenMS
 {
@@ -120,6 +121,8 @@ public slots:
     //docu in base class
     void updateLayer(Size i) override;
     // Docu in base class
+    void finishBackgroundTasks(Size i) override;
+    // Docu in base class
     void horizontalScrollBarChange(int value) override;
     // Docu in base class
     void verticalScrollBarChange(int value) override;
@@ -140,6 +143,9 @@ protected slots:
     /// Reacts on changed layer parameters
     void currentLayerParametersChanged_();
 
+    /// Assigns a level-of-detail cache built in the background to its layer
+    void lodCacheBuilt_();
+
 protected:
     // Docu in base class
     bool finishAdding_() override;
@@ -192,6 +198,16 @@ protected:
     */
     void paintMaximumIntensities_(Size layer_index, Size rt_pixel_count, Size mz_pixel_count, QPainter& p);
 
+    /**
+      @brief Starts building the level-of-detail cache of a peak layer in the background
+
+      Depending on the 'lod_cache' parameter, nothing is done, the cache is built in memory,
+      or it is additionally stored next to the data file (and loaded from there if up to date).
+      paintMaximumIntensities_() uses the cache once it is available and falls back to the raw
+      peaks when zoomed in further than its finest resolution.
+    */
+    void buildLODCache_(Size layer_index);
+
     /**
       @brief Paints the precursor peaks.
 
@@ -392,6 +408,9 @@ protected:
     double pen_size_max_; ///< maximum number of pixels for one data point
     double canvas_coverage_min_; ///< minimum coverage of the canvas required; if lower, points are upscaled in size
 
+    /// level-of-detail cache builds running in the background (see buildLODCache_()), by the peak data they read
+    std::map<const ExperimentType*, QFutureWatcherBase*> lod_builds_;
+
   private:
     /// Default C'tor hidden
     Spectrum2DCanvas();
@@ -610,6 +610,15 @@ public slots:
     ///Updates layer @p i when the data in the corresponding file changes
     virtual void updateLayer(Size i) = 0;
 
+    /**
+      @brief Blocks until background tasks reading the data of layer @p i have finished
+
+      Call this before the data of the layer is modified in place (e.g. reloaded from its file), and updateLayer() afterwards.
+    */
+    virtual void finishBackgroundTasks(Size /* i */)
+    {
+    }
+
 signals:
 
     /// Signal emitted whenever the modification status of a layer changes (editing and storing)
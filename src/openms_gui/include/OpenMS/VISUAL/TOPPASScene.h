@@ -43,6 +43,7 @@
 
 #include <QtWidgets/QGraphicsScene>
 #include <QtCore/QProcess>
+#include <QtCore/QHash>
 
 namespace OpenMS
 {
@@ -242,6 +243,14 @@ public:
     void setDescription(const QString & desc);
     /// sets the maximum number of jobs
     void setAllowedThreads(int num_threads);
+    /// sets the total number of CPU cores available to running tools (0 = no limit, each tool uses its own '-threads' setting)
+    void setCPUBudget(int num_cpus);
+    /// returns the total number of CPU cores available to running tools (0 = no limit)
+    int getCPUBudget() const;
+    /// sets the directory in which tool outputs are cached across pipeline runs (empty = no caching)
+    void setCacheDir(const QString & dir);
+    /// returns the directory in which tool outputs are cached across pipeline runs (empty = no caching)
+    const QString & getCacheDir() const;
     /// returns the hovering edge
     TOPPASEdge* getHoveringEdge();
     /// Checks whether all output vertices are finished, and if yes, emits entirePipelineFinished() (called by finished output vertices)
@@ -275,8 +284,8 @@ public slots:
     void changedParameter(const bool invalidates_running_pipeline);
     /// Invoked by OutfilelistVertex of user changed the folder name
     void changedOutputFolder();
-    /// Called by a finished QProcess to indicate that we are free to start a new one
-    void processFinished();
+    /// Called by a finished QProcess to indicate that we are free to start a new one (and its CPU cores are available again)
+    void processFinished(QProcess * process = nullptr);
     /// dirty solution: when using ExecutePipeline this slot is called when the pipeline crashes. This will quit the app
     void quitWithError();
 
@@ -361,6 +370,16 @@ protected:
     QString description_text_;
     /// maximum number of allowed threads
     int allowed_threads_;
+    /// total number of CPU cores available to running tools (0 = no limit)
+    int cpu_budget_;
+    /// number of CPU cores assigned to the currently running processes
+    int cpus_active_;
+    /// number of CPU cores assigned to each running process
+    QHash<QProcess *, int> process_cpus_;
+    /// length of the longest path of tool vertices starting at a vertex (see getCriticalPathLength_())
+    QHash<const TOPPASVertex *, int> critical_path_lengths_;
+    /// directory in which tool outputs are cached across pipeline runs (empty = no caching)
+    QString cache_dir_;
     /// last node where 'resume' was started
     TOPPASToolVertex* resume_source_;
 
@@ -370,6 +389,8 @@ protected:
     bool isEdgeAllowed_(TOPPASVertex * u, TOPPASVertex * v);
     /// DFS helper method. Returns true, if a back edge has been discovered
     bool dfsVisit_(TOPPASVertex * vertex);
+    /// Returns the number of tool vertices on the longest path starting at @p vertex, i.e. the number of tools which still have to run one after another (used to prioritize queued processes)
+    int getCriticalPathLength_(const TOPPASVertex * vertex);
     /// Performs a sanity check of the pipeline and notifies user when it finds something strange. Returns if pipeline OK.
     /// if 'allowUserOverride' is true, some dialogs are shown which allow the user to ignore some warnings (e.g. disconnected nodes)
     bool sanityCheck_(bool allowUserOverride);
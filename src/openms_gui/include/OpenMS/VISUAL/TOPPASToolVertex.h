@@ -254,6 +254,12 @@ protected:
     void getParameters_(QVector<IOInfo>& io_infos, bool input_params) const;
     /// Writes @p param to the @p ini_file
     void writeParam_(const Param& param, const QString& ini_file);
+    /// Computes the key under which the outputs of round @p round are cached, i.e. a hash of the tool, its INI file @p ini_file and the contents of all input files in @p inputs. Returns an empty string if an input file cannot be read.
+    QString computeCacheKey_(const RoundPackage& inputs, int round, const QVector<IOInfo>& in_params, const QVector<IOInfo>& out_params, const QString& ini_file) const;
+    /// Copies the outputs cached under @p key to the output files of round @p round. Returns false if the cache does not contain a complete entry for @p key.
+    bool restoreCachedOutput_(const QString& key, int round) const;
+    /// Stores the output files of round @p round in the cache under @p key
+    void storeCachedOutput_(const QString& key, int round) const;
     /// Helper method for finding good boundaries for wrapping the tool name. Returns a string with whitespaces at the preferred boundaries.
     QString toolnameWithWhitespacesForFancyWordWrapping_(QPainter* painter, const QString& str);
 
@@ -272,6 +278,8 @@ protected:
 
     /// Breakpoint set?
     bool breakpoint_set_;
+    /// Cache keys of the rounds whose outputs are stored in the cache once all rounds finished (empty for rounds which are not cached)
+    QStringList cache_keys_;
 
     /// smart naming of round-based filenames
     /// when basename is not unique we take the preceding directory name
@@ -14,6 +14,7 @@ GUIProgressLoggerImpl.h
 HistogramWidget.h
 LayerData.h
 ListEditor.h
+MaxIntensityPyramid.h
 MetaDataBrowser.h
 MultiGradient.h
 MultiGradientSelector.h
@@ -3174,6 +3174,7 @@ namespace OpenMS
       p.setValue("rt_tolerance", 30.0);
       im.setParameters(p);
       showLogMessage_(LS_NOTICE, "Note", "Mapping matches with 30 sec tolerance and no m/z limit to spectra...");
+      getActiveCanvas()->finishBackgroundTasks(getActiveCanvas()->activeLayerIndex());
       im.annotate((*layer.getPeakDataMuteable()), identifications, true, true);
     }
     else
@@ -3250,6 +3251,7 @@ namespace OpenMS
         p.setValue("mz_tolerance", 1.0, "m/z tolerance (in ppm or Da) for the matching");
         p.setValue("mz_measure", "Da", "unit of 'mz_tolerance' (ppm or Da)");
         mapper.setParameters(p);
+        getActiveCanvas()->finishBackgroundTasks(getActiveCanvas()->activeLayerIndex());
         mapper.annotate(*layer.getPeakDataMuteable(), identifications, protein_identifications, true);
         views_tabwidget_->setTabEnabled(1, true); // enable identification view
         views_tabwidget_->setCurrentIndex(1); // switch to identification view
@@ -3286,6 +3288,7 @@ namespace OpenMS
         p.setValue("mz_tolerance", 1.0, "m/z tolerance (in ppm or Da) for the matching");
         p.setValue("mz_measure", "Da", "unit of 'mz_tolerance' (ppm or Da)");
         mapper.setParameters(p);
+        getActiveCanvas()->finishBackgroundTasks(getActiveCanvas()->activeLayerIndex());
         mapper.annotate(*layer.getPeakDataMuteable(), identifications, protein_identifications, true);
         views_tabwidget_->setTabEnabled(1, true); // enable identification view
       }
@@ -4244,6 +4247,7 @@ namespace OpenMS
       else //if (user_wants_update == true)
       {
         LayerData& layer = const_cast<LayerData&>(sw->canvas()->getLayer(layer_index));
+        sw->canvas()->finishBackgroundTasks(layer_index); // the data is modified in place
         // reload data
         if (layer.type == LayerData::DT_PEAK) //peak data
         {
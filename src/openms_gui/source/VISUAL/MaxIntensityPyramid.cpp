@@ -0,0 +1,373 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    // file format identifier and version of store()/load()
+    const char LOD_MAGIC[8] = {'O', 'M', 'S', 'L', 'O', 'D', '0', '2'};
+
+    template <typename T>
+    void writeValue(ofstream& os, const T& value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(ifstream& is, T& value)
+    {
+      is.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return bool(is);
+    }
+
+    // index of the cell containing @p pos (values beyond the last cell are clamped to it)
+    inline Size cellIndex(double pos, double min, double step, Size bins)
+    {
+      double idx = (pos - min) / step;
+      if (idx <= 0.0) return 0;
+      return std::min(bins - 1, Size(idx));
+    }
+
+    // index of the last cell overlapping the half-open interval ending at @p pos (clamped like cellIndex())
+    inline Size lastCellIndex(double pos, double min, double step, Size bins)
+    {
+      double idx = std::ceil((pos - min) / step) - 1.0;
+      if (idx <= 0.0) return 0;
+      return std::min(bins - 1, Size(idx));
+    }
+  }
+
+  const Size MaxIntensityPyramid::MAX_CELLS;
+  const Size MaxIntensityPyramid::CELLS_PER_PEAK;
+
+  MaxIntensityPyramid::MaxIntensityPyramid() :
+    levels_(),
+    rt_min_(0.0),
+    mz_min_(0.0),
+    ms1_spectra_(0),
+    ms1_peaks_(0),
+    ms1_rt_max_(0.0)
+  {
+  }
+
+  void MaxIntensityPyramid::getFileStamp_(const String& data_file, UInt64& size, Int64& modification_time)
+  {
+    size = 0;
+    modification_time = 0;
+    if (data_file.empty()) return;
+    QFileInfo info(data_file.toQString());
+    if (!info.exists()) return;
+    size = info.size();
+    modification_time = info.lastModified().toMSecsSinceEpoch();
+  }
+
+  void MaxIntensityPyramid::summarize_(const PeakMap& map, Size& ms1_spectra, Size& ms1_peaks, double& rt_min, double& rt_max)
+  {
+    ms1_spectra = 0;
+    ms1_peaks = 0;
+    rt_min = numeric_limits<double>::max();
+    rt_max = -numeric_limits<double>::max();
+    for (PeakMap::ConstIterator it = map.begin(); it != map.end(); ++it)
+    {
+      if (it->getMSLevel() != 1 || it->empty()) continue;
+      ++ms1_spectra;
+      ms1_peaks += it->size();
+      rt_min = std::min(rt_min, it->getRT());
+      rt_max = std::max(rt_max, it->getRT());
+    }
+  }
+
+  void MaxIntensityPyramid::build(const PeakMap& map, Size rt_bins, Size mz_bins)
+  {
+    clear();
+    summarize_(map, ms1_spectra_, ms1_peaks_, rt_min_, ms1_rt_max_);
+    if (ms1_peaks_ == 0)
+    {
+      clear();
+      return;
+    }
+
+    double mz_max = -numeric_limits<double>::max();
+    mz_min_ = numeric_limits<double>::max();
+    for (PeakMap::ConstIterator it = map.begin(); it != map.end(); ++it)
+    {
+      if (it->getMSLevel() != 1 || it->empty()) continue;
+      mz_min_ = std::min(mz_min_, it->front().getMZ());
+      mz_max = std::max(mz_max, it->back().getMZ());
+    }
+
+    // level 0 (by default: one row per spectrum and CELLS_PER_PEAK cells per peak)
+    if (rt_bins == 0)
+    {
+      rt_bins = std::min(ms1_spectra_, MAX_CELLS);
+    }
+    rt_bins = std::max(Size(1), std::min(rt_bins, ms1_spectra_));
+    if (mz_bins == 0)
+    {
+      mz_bins = std::min(ms1_peaks_ * CELLS_PER_PEAK, MAX_CELLS) / rt_bins;
+    }
+    Level level;
+    level.rt_bins = rt_bins;
+    level.mz_bins = std::max(Size(1), std::min(mz_bins, Size(1) << 24));
+    level.rt_step = ms1_rt_max_ > rt_min_ ? (ms1_rt_max_ - rt_min_) / level.rt_bins : 1.0;
+    level.mz_step = mz_max > mz_min_ ? (mz_max - mz_min_) / level.mz_bins : 1.0;
+    level.cells.assign(level.rt_bins * level.mz_bins, -1.0f);
+
+    for (PeakMap::ConstIterator it = map.begin(); it != map.end(); ++it)
+    {
+      if (it->getMSLevel() != 1 || it->empty()) continue;
+      float* row = &level.cells[cellIndex(it->getRT(), rt_min_, level.rt_step, level.rt_bins) * level.mz_bins];
+      for (PeakMap::SpectrumType::ConstIterator p = it->begin(); p != it->end(); ++p)
+      {
+        float& cell = row[cellIndex(p->getMZ(), mz_min_, level.mz_step, level.mz_bins)];
+        cell = std::max(cell, p->getIntensity());
+      }
+    }
+    levels_.push_back(level);
+
+    // coarser levels: each cell is the maximum of (up to) 2x2 cells of the previous level
+    while (levels_.back().rt_bins > 1 || levels_.back().mz_bins > 1)
+    {
+      const Level& fine = levels_.back();
+      Level coarse;
+      coarse.rt_bins = (fine.rt_bins + 1) / 2;
+      coarse.mz_bins = (fine.mz_bins + 1) / 2;
+      coarse.rt_step = fine.rt_step * 2.0;
+      coarse.mz_step = fine.mz_step * 2.0;
+      coarse.cells.assign(coarse.rt_bins * coarse.mz_bins, -1.0f);
+      for (Size r = 0; r < fine.rt_bins; ++r)
+      {
+        const float* fine_row = &fine.cells[r * fine.mz_bins];
+        float* coarse_row = &coarse.cells[(r / 2) * coarse.mz_bins];
+        for (Size m = 0; m < fine.mz_bins; ++m)
+        {
+          coarse_row[m / 2] = std::max(coarse_row[m / 2], fine_row[m]);
+        }
+      }
+      levels_.push_back(coarse);
+    }
+  }
+
+  void MaxIntensityPyramid::clear()
+  {
+    levels_.clear();
+    rt_min_ = 0.0;
+    mz_min_ = 0.0;
+    ms1_spectra_ = 0;
+    ms1_peaks_ = 0;
+    ms1_rt_max_ = 0.0;
+  }
+
+  bool MaxIntensityPyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  bool MaxIntensityPyramid::matches(const PeakMap& map) const
+  {
+    if (empty()) return false;
+    Size ms1_spectra, ms1_peaks;
+    double rt_min, rt_max;
+    summarize_(map, ms1_spectra, ms1_peaks, rt_min, rt_max);
+    return ms1_spectra == ms1_spectra_ && ms1_peaks == ms1_peaks_ && rt_min == rt_min_ && rt_max == ms1_rt_max_;
+  }
+
+  Size MaxIntensityPyramid::getLevelCount() const
+  {
+    return levels_.size();
+  }
+
+  Size MaxIntensityPyramid::getRTBins(Size level) const
+  {
+    return levels_[level].rt_bins;
+  }
+
+  Size MaxIntensityPyramid::getMZBins(Size level) const
+  {
+    return levels_[level].mz_bins;
+  }
+
+  Size MaxIntensityPyramid::selectLevel(double rt_extent, double mz_extent) const
+  {
+    // coarsest first
+    for (Size i = levels_.size(); i > 0; --i)
+    {
+      const Level& level = levels_[i - 1];
+      if (level.rt_step <= rt_extent && level.mz_step <= mz_extent)
+      {
+        return i - 1;
+      }
+    }
+    return levels_.size();
+  }
+
+  float MaxIntensityPyramid::getCell(Size level, Size rt_bin, Size mz_bin) const
+  {
+    const Level& l = levels_[level];
+    return l.cells[rt_bin * l.mz_bins + mz_bin];
+  }
+
+  float MaxIntensityPyramid::getMaxIntensity(Size level, double rt_start, double rt_end, double mz_start, double mz_end) const
+  {
+    const Level& l = levels_[level];
+    // the maximum RT/m/z lies on the upper border of the last cell, so it is still inside
+    const double rt_last = rt_min_ + l.rt_bins * l.rt_step;
+    const double mz_last = mz_min_ + l.mz_bins * l.mz_step;
+    if (rt_end <= rt_min_ || mz_end <= mz_min_ || rt_start > rt_last || mz_start > mz_last || rt_end <= rt_start || mz_end <= mz_start)
+    {
+      return -1.0f;
+    }
+
+    const Size rt_lo = cellIndex(rt_start, rt_min_, l.rt_step, l.rt_bins);
+    const Size mz_lo = cellIndex(mz_start, mz_min_, l.mz_step, l.mz_bins);
+    const Size rt_hi = std::max(rt_lo, lastCellIndex(rt_end, rt_min_, l.rt_step, l.rt_bins));
+    const Size mz_hi = std::max(mz_lo, lastCellIndex(mz_end, mz_min_, l.mz_step, l.mz_bins));
+
+    float max = -1.0f;
+    for (Size r = rt_lo; r <= rt_hi; ++r)
+    {
+      const float* row = &l.cells[r * l.mz_bins];
+      for (Size m = mz_lo; m <= mz_hi; ++m)
+      {
+        max = std::max(max, row[m]);
+      }
+    }
+    return max;
+  }
+
+  bool MaxIntensityPyramid::store(const String& filename, const String& data_file) const
+  {
+    UInt64 data_size;
+    Int64 data_time;
+    getFileStamp_(data_file, data_size, data_time);
+
+    ofstream os(filename.c_str(), ios::out | ios::binary);
+    if (!os) return false;
+
+    os.write(LOD_MAGIC, sizeof(LOD_MAGIC));
+    writeValue(os, data_size);
+    writeValue(os, data_time);
+    writeValue(os, UInt64(ms1_spectra_));
+    writeValue(os, UInt64(ms1_peaks_));
+    writeValue(os, rt_min_);
+    writeValue(os, ms1_rt_max_);
+    writeValue(os, mz_min_);
+    writeValue(os, UInt64(levels_.size()));
+    for (vector<Level>::const_iterator it = levels_.begin(); it != levels_.end(); ++it)
+    {
+      writeValue(os, UInt64(it->rt_bins));
+      writeValue(os, UInt64(it->mz_bins));
+      writeValue(os, it->rt_step);
+      writeValue(os, it->mz_step);
+      os.write(reinterpret_cast<const char*>(it->cells.data()), it->cells.size() * sizeof(float));
+    }
+    return bool(os);
+  }
+
+  bool MaxIntensityPyramid::load(const String& filename, const String& data_file)
+  {
+    clear();
+    UInt64 data_size = 0;
+    Int64 data_time = 0;
+    if (!data_file.empty())
+    {
+      getFileStamp_(data_file, data_size, data_time);
+      UInt64 cache_size;
+      Int64 cache_time;
+      getFileStamp_(filename, cache_size, cache_time);
+      if (cache_time < data_time) return false; // the data file was written after the cache
+    }
+
+    ifstream is(filename.c_str(), ios::in | ios::binary);
+    if (!is) return false;
+
+    char magic[sizeof(LOD_MAGIC)];
+    is.read(magic, sizeof(magic));
+    UInt64 stored_size, ms1_spectra, ms1_peaks, level_count;
+    Int64 stored_time;
+    if (!is || memcmp(magic, LOD_MAGIC, sizeof(magic)) != 0 ||
+        !readValue(is, stored_size) || !readValue(is, stored_time) ||
+        (!data_file.empty() && (stored_size != data_size || stored_time != data_time)) ||
+        !readValue(is, ms1_spectra) || !readValue(is, ms1_peaks) ||
+        !readValue(is, rt_min_) || !readValue(is, ms1_rt_max_) || !readValue(is, mz_min_) ||
+        !readValue(is, level_count))
+    {
+      clear();
+      return false;
+    }
+    ms1_spectra_ = ms1_spectra;
+    ms1_peaks_ = ms1_peaks;
+
+    for (UInt64 i = 0; i < level_count; ++i)
+    {
+      Level level;
+      UInt64 rt_bins, mz_bins;
+      if (!readValue(is, rt_bins) || !readValue(is, mz_bins) || !readValue(is, level.rt_step) || !readValue(is, level.mz_step) ||
+          rt_bins == 0 || mz_bins == 0 || rt_bins > ms1_spectra_ || mz_bins > (UInt64(1) << 24))
+      {
+        clear();
+        return false;
+      }
+      level.rt_bins = rt_bins;
+      level.mz_bins = mz_bins;
+      level.cells.resize(level.rt_bins * level.mz_bins);
+      is.read(reinterpret_cast<char*>(level.cells.data()), level.cells.size() * sizeof(float));
+      if (!is)
+      {
+        clear();
+        return false;
+      }
+      levels_.push_back(level);
+    }
+    return !levels_.empty();
+  }
+
+} // namespace OpenMS
@@ -45,6 +45,7 @@
 #include <OpenMS/VISUAL/ColorSelector.h>
 #include <OpenMS/VISUAL/MultiGradientSelector.h>
 #include <OpenMS/VISUAL/DIALOGS/FeatureEditDialog.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/SYSTEM/FileWatcher.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 //STL
@@ -60,6 +61,8 @@
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
+#include <QtCore/QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
 
 //boost
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -80,6 +83,34 @@ namespace OpenMS
 {
   using namespace Internal;
 
+  namespace
+  {
+    /// result of a background level-of-detail cache build
+    struct LODBuildResult
+    {
+      LayerData::ConstExperimentSharedPtrType data;
+      boost::shared_ptr<MaxIntensityPyramid> pyramid;
+    };
+
+    /// builds (or loads from @p cache_file, if given and up to date with @p data_file) the level-of-detail cache of @p data
+    LODBuildResult buildLODCache(LayerData::ConstExperimentSharedPtrType data, String cache_file, String data_file)
+    {
+      LODBuildResult result;
+      result.data = data;
+      result.pyramid.reset(new MaxIntensityPyramid());
+      if (!cache_file.empty() && File::exists(cache_file) && result.pyramid->load(cache_file, data_file) && result.pyramid->matches(*data))
+      {
+        return result;
+      }
+      result.pyramid->build(*data);
+      if (!cache_file.empty() && !result.pyramid->empty())
+      {
+        result.pyramid->store(cache_file, data_file); // not being able to write next to the data is not an error
+      }
+      return result;
+    }
+  }
+
   Spectrum2DCanvas::Spectrum2DCanvas(const Param & preferences, QWidget * parent) :
     SpectrumCanvas(preferences, parent),
     projection_mz_(),
@@ -88,7 +119,8 @@ namespace OpenMS
     measurement_start_(),
     pen_size_min_(1),
     pen_size_max_(20),
-    canvas_coverage_min_(0.2)
+    canvas_coverage_min_(0.2),
+    lod_builds_()
   {
     //Parameter handling
     defaults_.setValue("background_color", "#ffffff", "Background color.");
@@ -103,6 +135,8 @@ namespace OpenMS
     defaults_.setMaxInt("dot:feature_icon_size", 999);
     defaults_.setValue("mapping_of_mz_to", "y_axis", "Determines which axis is the m/z axis.");
     defaults_.setValidStrings("mapping_of_mz_to", ListUtils::create<String>("x_axis,y_axis"));
+    defaults_.setValue("lod_cache", "memory", "Level-of-detail cache for painting zoomed-out peak maps: 'none', 'memory' (built in the background when a peak map is shown) or 'disk' (additionally stored as '<file>.lod' next to the data file and reused when the unchanged file is opened again).");
+    defaults_.setValidStrings("lod_cache", ListUtils::create<String>("none,memory,disk"));
     defaultsToParam_();
     setName("Spectrum2DCanvas");
     setParameters(preferences);
@@ -586,6 +620,83 @@ namespace OpenMS
     }
   }
 
+  void Spectrum2DCanvas::buildLODCache_(Size layer_index)
+  {
+    const LayerData & layer = getLayer(layer_index);
+    const String mode = String(param_.getValue("lod_cache"));
+    if (mode == "none" || layer.type != LayerData::DT_PEAK)
+    {
+      return;
+    }
+    String cache_file;
+    if (mode == "disk" && !layer.filename.empty() && !layer.modified) // the cache file has to match the data file
+    {
+      cache_file = layer.filename + ".lod";
+    }
+
+    // the build reads the data while the GUI keeps running: in-place changes must call finishBackgroundTasks() first;
+    // the result is assigned in lodCacheBuilt_()
+    const ExperimentType * data = layer.getPeakData().get();
+    std::map<const ExperimentType *, QFutureWatcherBase *>::iterator it = lod_builds_.find(data);
+    if (it != lod_builds_.end())
+    { // a build from before the last change of the data is still running: its result is outdated
+      it->second->disconnect(this);
+      it->second->waitForFinished();
+      it->second->deleteLater();
+      lod_builds_.erase(it);
+    }
+    QFutureWatcher<LODBuildResult> * watcher = new QFutureWatcher<LODBuildResult>(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(lodCacheBuilt_()));
+    watcher->setFuture(QtConcurrent::run(buildLODCache, layer.getPeakData(), cache_file, layer.filename));
+    lod_builds_[data] = watcher;
+  }
+
+  void Spectrum2DCanvas::finishBackgroundTasks(Size i)
+  {
+    if (getLayer(i).type != LayerData::DT_PEAK)
+    {
+      return;
+    }
+    std::map<const ExperimentType *, QFutureWatcherBase *>::iterator it = lod_builds_.find(getLayer(i).getPeakData().get());
+    if (it != lod_builds_.end())
+    {
+      it->second->waitForFinished();
+    }
+  }
+
+  void Spectrum2DCanvas::lodCacheBuilt_()
+  {
+    QFutureWatcher<LODBuildResult> * watcher = static_cast<QFutureWatcher<LODBuildResult> *>(sender());
+    LODBuildResult result = watcher->result();
+    watcher->deleteLater();
+    std::map<const ExperimentType *, QFutureWatcherBase *>::iterator it = lod_builds_.find(result.data.get());
+    if (it != lod_builds_.end() && it->second == watcher)
+    {
+      lod_builds_.erase(it);
+    }
+    if (result.pyramid->empty())
+    {
+      return;
+    }
+
+    // the layer might have been removed or its data replaced in the meantime
+    bool assigned = false;
+    for (Size i = 0; i < getLayerCount(); ++i)
+    {
+      LayerData & layer = getLayer_(i);
+      if (layer.type == LayerData::DT_PEAK && layer.getPeakData().get() == result.data.get())
+      {
+        layer.lod_cache = result.pyramid;
+        assigned = true;
+      }
+    }
+    if (assigned)
+    {
+      update_buffer_ = true;
+      update_(OPENMS_PRETTY_FUNCTION);
+    }
+  }
+
   void Spectrum2DCanvas::paintAllIntensities_(Size layer_index, double pen_width, QPainter & painter)
   {
     const LayerData & layer = getLayer(layer_index);
@@ -655,6 +766,36 @@ namespace OpenMS
     double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
     double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
 
+    // read the maxima from the level-of-detail cache if it has cells of at most one pixel
+    // (the cache ignores data filters, so it can only be used without them)
+    if (layer.lod_cache && !layer.filters.isActive() && layer.lod_cache->matches(map))
+    {
+      const MaxIntensityPyramid & lod = *layer.lod_cache;
+      Size level = lod.selectLevel(rt_step_size, mz_step_size);
+      if (level < lod.getLevelCount())
+      {
+        for (Size rt = 0; rt < rt_pixel_count; ++rt)
+        {
+          double rt_start = rt_min + rt_step_size * rt;
+          for (Size mz = 0; mz < mz_pixel_count; ++mz)
+          {
+            double mz_start = mz_min + mz_step_size * mz;
+            float max = lod.getMaxIntensity(level, rt_start, rt_start + rt_step_size, mz_start, mz_start + mz_step_size);
+            if (max >= 0.0)
+            {
+              QPoint pos;
+              dataToWidget_(mz_start + 0.5 * mz_step_size, rt_start + 0.5 * rt_step_size, pos);
+              if (pos.y() < image_height && pos.x() < image_width)
+              {
+                buffer_.setPixel(pos.x(), pos.y(), heightColor_(max, layer.gradient, snap_factor).rgb());
+              }
+            }
+          }
+        }
+        return;
+      }
+    }
+
     // start at first visible RT scan
     Size scan_index = std::distance(map.begin(), map.RTBegin(rt_min));
     //iterate over all pixels (RT dimension)
@@ -1253,6 +1394,7 @@ namespace OpenMS
       {
         setLayerFlag(LayerData::P_PRECURSORS, true); // show precursors if no MS1 data is contained
       }
+      buildLODCache_(current_layer_);
     }
     else if (layers_.back().type == LayerData::DT_FEATURE)  // feature data
     {
@@ -2836,6 +2978,13 @@ namespace OpenMS
 
   void Spectrum2DCanvas::updateLayer(Size i)
   {
+    // the data might have changed in place: rebuild the level-of-detail cache (dropping the result of a build still running)
+    if (getLayer(i).type == LayerData::DT_PEAK)
+    {
+      getLayer_(i).lod_cache.reset();
+      buildLODCache_(i);
+    }
+
     //update nearest peak
     selected_peak_.clear();
     recalculateRanges_(0, 1, 2);
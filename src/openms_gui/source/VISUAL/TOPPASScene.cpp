@@ -88,6 +88,11 @@ namespace OpenMS
     dry_run_(true),
     threads_active_(0),
     allowed_threads_(1),
+    cpu_budget_(0),
+    cpus_active_(0),
+    process_cpus_(),
+    critical_path_lengths_(),
+    cache_dir_(),
     resume_source_(nullptr)
   {
     /*	ATTENTION!
@@ -673,6 +678,7 @@ namespace OpenMS
 
       // reset processes
       topp_processes_queue_.clear();
+      critical_path_lengths_.clear();
 
       // start at input nodes
       for (VertexIterator it = verticesBegin(); it != verticesEnd(); ++it)
@@ -1664,9 +1670,10 @@ namespace OpenMS
     }
   }
 
-  void TOPPASScene::processFinished()
+  void TOPPASScene::processFinished(QProcess* process)
   {
     --threads_active_;
+    cpus_active_ -= process_cpus_.take(process);
     // try to run next in line
     runNextProcess();
   }
@@ -1993,7 +2000,43 @@ namespace OpenMS
 
   void TOPPASScene::enqueueProcess(const TOPPProcess& process)
   {
-    topp_processes_queue_ << process;
+    // keep the queue sorted by decreasing critical path length: tools with the most work depending on them are started first
+    // (processes with equal priority, e.g. the rounds of a tool, keep their order)
+    int priority = getCriticalPathLength_(process.tv);
+    QList<TOPPProcess>::iterator it = topp_processes_queue_.begin();
+    while (it != topp_processes_queue_.end() && getCriticalPathLength_(it->tv) >= priority)
+    {
+      ++it;
+    }
+    topp_processes_queue_.insert(it, process);
+  }
+
+  int TOPPASScene::getCriticalPathLength_(const TOPPASVertex* vertex)
+  {
+    if (vertex == nullptr)
+    {
+      return 0;
+    }
+
+    QHash<const TOPPASVertex*, int>::const_iterator cached = critical_path_lengths_.find(vertex);
+    if (cached != critical_path_lengths_.end())
+    {
+      return cached.value();
+    }
+
+    // the workflow is a DAG, so the recursion terminates
+    int length = 0;
+    for (TOPPASVertex::ConstEdgeIterator it = vertex->outEdgesBegin(); it != vertex->outEdgesEnd(); ++it)
+    {
+      length = std::max(length, getCriticalPathLength_((*it)->getTargetVertex()));
+    }
+    if (qobject_cast<const TOPPASToolVertex*>(vertex))
+    {
+      ++length;
+    }
+
+    critical_path_lengths_[vertex] = length;
+    return length;
   }
 
   void TOPPASScene::runNextProcess()
@@ -2006,10 +2049,32 @@ namespace OpenMS
 
     while (!topp_processes_queue_.empty() && threads_active_ < allowed_threads_)
     {
-      ++threads_active_; // will be decreased, once the tool finishes
       TOPPProcess tp = topp_processes_queue_.first();
-      topp_processes_queue_.pop_front();
       FakeProcess* p = qobject_cast<FakeProcess*>(tp.proc);
+
+      // assign CPU cores (fake processes do not need any)
+      int cpus = 0;
+      if (!p && cpu_budget_ > 0)
+      {
+        int cpus_free = cpu_budget_ - cpus_active_;
+        if (cpus_free <= 0)
+        {
+          break; // wait for a running tool to finish
+        }
+        cpus = 1;
+        if (tp.tv->getParam().exists("threads"))
+        {
+          // share the free cores evenly among all processes which can be started right now
+          int startable = std::min(topp_processes_queue_.size(), allowed_threads_ - threads_active_);
+          cpus = std::max(1, cpus_free / startable);
+          tp.args << "-threads" << QString::number(cpus); // overrides the value in the INI file
+        }
+      }
+
+      topp_processes_queue_.pop_front();
+      ++threads_active_; // will be decreased, once the tool finishes
+      cpus_active_ += cpus;
+      process_cpus_[tp.proc] = cpus;
       if (p)
       {
         p->start(tp.command, tp.args);
@@ -2349,6 +2414,29 @@ namespace OpenMS
     allowed_threads_ = num_jobs;
   }
 
+  void TOPPASScene::setCPUBudget(int num_cpus)
+  {
+    if (num_cpus < 0)
+      return;
+
+    cpu_budget_ = num_cpus;
+  }
+
+  int TOPPASScene::getCPUBudget() const
+  {
+    return cpu_budget_;
+  }
+
+  void TOPPASScene::setCacheDir(const QString& dir)
+  {
+    cache_dir_ = dir;
+  }
+
+  const QString& TOPPASScene::getCacheDir() const
+  {
+    return cache_dir_;
+  }
+
   bool TOPPASScene::isGUIMode() const
   {
     return gui_;
@@ -45,6 +45,7 @@
 
 #include <QtWidgets/QGraphicsScene>
 #include <QtWidgets/QMessageBox>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QDir>
@@ -86,7 +87,8 @@ namespace OpenMS
     param_(),
     status_(TOOL_READY),
     tool_ready_(true),
-    breakpoint_set_(false)
+    breakpoint_set_(false),
+    cache_keys_()
   {
     pen_color_ = Qt::black;
     brush_color_ = QColor(245, 245, 245);
@@ -103,7 +105,8 @@ namespace OpenMS
     type_(type),
     param_(),
     tool_ready_(true),
-    breakpoint_set_(false)
+    breakpoint_set_(false),
+    cache_keys_()
   {
     pen_color_ = Qt::black;
     brush_color_ = QColor(245, 245, 245);
@@ -121,7 +124,8 @@ namespace OpenMS
     param_(rhs.param_),
     status_(rhs.status_),
     tool_ready_(rhs.tool_ready_),
-    breakpoint_set_(false)
+    breakpoint_set_(false),
+    cache_keys_()
   {
     pen_color_ = Qt::black;
     brush_color_ = QColor(245, 245, 245);
@@ -578,6 +582,7 @@ namespace OpenMS
     /// update round status
     round_total_ = (int) pkg.size(); // take number of rounds from previous tool(s) - should all be equal
     round_counter_ = 0; // once round_counter_ reaches round_total_, we are done
+    cache_keys_.clear();
 
     QStringList shared_args;
     if (type_ != "")
@@ -701,9 +706,24 @@ namespace OpenMS
       writeParam_(param_tmp, ini_file_iteration);
       args << "-ini" << ini_file_iteration;
 
+      // reuse the outputs of a previous run if the tool, its parameters and the contents of its input files are unchanged
+      bool cached = false;
+      QString cache_key;
+      if (!ts->isDryRun() && !ts->getCacheDir().isEmpty())
+      {
+        cache_key = computeCacheKey_(pkg[round], round, in_params, out_params, ini_file_iteration);
+        if (!cache_key.isEmpty() && restoreCachedOutput_(cache_key, round))
+        {
+          cached = true;
+          cache_key.clear(); // nothing to store once finished
+          ts->logTOPPOutput((String("\nReusing cached output of '") + name_ + "' (round " + (round + 1) + "/" + round_total_ + ")\n").toQString());
+        }
+      }
+      cache_keys_ << cache_key;
+
       // create process
       QProcess* p;
-      if (!ts->isDryRun())
+      if (!ts->isDryRun() && !cached)
       {
         p = new QProcess();
       }
@@ -777,6 +797,14 @@ namespace OpenMS
         }
         if (!ts->isDryRun())
         {
+          // store the outputs in the cache before they are renamed
+          for (int round = 0; round < cache_keys_.size(); ++round)
+          {
+            if (!cache_keys_[round].isEmpty())
+            {
+              storeCachedOutput_(cache_keys_[round], round);
+            }
+          }
           renameOutput_(); // rename generated files by content
           emit toolFinished();
         }
@@ -798,16 +826,126 @@ namespace OpenMS
 
     //clean up
     QProcess* p = qobject_cast<QProcess*>(QObject::sender());
+
+    ts->processFinished(p);
+
     if (p)
     {
       delete p;
     }
 
-    ts->processFinished();
-
     __DEBUG_END_METHOD__
   }
 
+  QString TOPPASToolVertex::computeCacheKey_(const RoundPackage& inputs, int round, const QVector<IOInfo>& in_params, const QVector<IOInfo>& out_params, const QString& ini_file) const
+  {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(name_.toQString().toUtf8());
+    hash.addData(type_.toQString().toUtf8());
+
+    // parameters (the INI file also contains the version of the tool)
+    QFile ini(ini_file);
+    if (!ini.open(QIODevice::ReadOnly) || !hash.addData(&ini))
+    {
+      return QString();
+    }
+
+    // contents of the input files (their names differ between runs, since they are located in the temporary directory)
+    for (RoundPackageConstIt it = inputs.begin(); it != inputs.end(); ++it)
+    {
+      int param_index = it->second.edge->getTargetInParam();
+      hash.addData(in_params[param_index].param_name.toQString().toUtf8());
+      const QStringList& files = it->second.filenames.get();
+      foreach(const QString& file, files)
+      {
+        QFile in(file);
+        if (!in.open(QIODevice::ReadOnly) || !hash.addData(&in))
+        {
+          return QString();
+        }
+      }
+    }
+
+    // expected outputs
+    for (RoundPackageConstIt it = output_files_[round].begin(); it != output_files_[round].end(); ++it)
+    {
+      hash.addData(out_params[it->first].param_name.toQString().toUtf8());
+      hash.addData(QByteArray::number(it->second.filenames.size()));
+    }
+
+    return QString(hash.result().toHex());
+  }
+
+  bool TOPPASToolVertex::restoreCachedOutput_(const QString& key, int round) const
+  {
+    QDir cache_dir(getScene_()->getCacheDir() + QDir::separator() + key);
+    if (!cache_dir.exists())
+    {
+      return false;
+    }
+
+    // all outputs need to be present
+    for (RoundPackageConstIt it = output_files_[round].begin(); it != output_files_[round].end(); ++it)
+    {
+      for (int fi = 0; fi < it->second.filenames.size(); ++fi)
+      {
+        if (!cache_dir.exists(QString("%1_%2").arg(it->first).arg(fi)))
+        {
+          return false;
+        }
+      }
+    }
+
+    for (RoundPackageConstIt it = output_files_[round].begin(); it != output_files_[round].end(); ++it)
+    {
+      for (int fi = 0; fi < it->second.filenames.size(); ++fi)
+      {
+        const QString& target = it->second.filenames[fi];
+        if (File::exists(target))
+        {
+          File::remove(target);
+        }
+        if (!QFile::copy(cache_dir.filePath(QString("%1_%2").arg(it->first).arg(fi)), target))
+        {
+          LOG_WARN << "Could not restore cached output '" << String(target) << "'. Running the tool instead.\n";
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  void TOPPASToolVertex::storeCachedOutput_(const QString& key, int round) const
+  {
+    // write to a temporary directory first, s.t. an interrupted copy never leaves an incomplete entry behind
+    QString entry_dir = getScene_()->getCacheDir() + QDir::separator() + key;
+    QString tmp_dir = entry_dir + ".part";
+    if (File::exists(tmp_dir))
+    {
+      File::removeDirRecursively(tmp_dir);
+    }
+    QDir().mkpath(tmp_dir);
+
+    for (RoundPackageConstIt it = output_files_[round].begin(); it != output_files_[round].end(); ++it)
+    {
+      for (int fi = 0; fi < it->second.filenames.size(); ++fi)
+      {
+        if (!QFile::copy(it->second.filenames[fi], tmp_dir + QDir::separator() + QString("%1_%2").arg(it->first).arg(fi)))
+        {
+          LOG_WARN << "Could not cache output '" << String(it->second.filenames[fi]) << "'.\n";
+          File::removeDirRecursively(tmp_dir);
+          return;
+        }
+      }
+    }
+
+    if (File::exists(entry_dir))
+    {
+      File::removeDirRecursively(entry_dir);
+    }
+    QDir().rename(tmp_dir, entry_dir);
+  }
+
   bool TOPPASToolVertex::renameOutput_()
   {
     // get all output names
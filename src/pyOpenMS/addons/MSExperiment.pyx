@@ -14,3 +14,87 @@
 
 
 
+
+    def get_all_peaks(self):
+        """Cython signature: tuple get_all_peaks()
+
+        Returns the peaks of all spectra as concatenated numpy arrays in a
+        single call: (mz, intensity, rt, offsets). The peaks of spectrum i are
+        mz[offsets[i]:offsets[i+1]] (and likewise for intensity), rt[i] is the
+        retention time of spectrum i and offsets has size() + 1 entries.
+        """
+        cdef _MSExperiment * exp_ = self.inst.get()
+        cdef size_t nspec = exp_.size()
+        cdef size_t npeaks = 0
+        cdef libcpp_vector[_MSSpectrum].iterator it = exp_.begin()
+        while it != exp_.end():
+            npeaks += deref(it).size()
+            inc(it)
+
+        cdef np.ndarray[np.float64_t, ndim=1] mzs = np.empty( (npeaks,), dtype=np.float64)
+        cdef np.ndarray[np.float32_t, ndim=1] intensities = np.empty( (npeaks,), dtype=np.float32)
+        cdef np.ndarray[np.float64_t, ndim=1] rts = np.empty( (nspec,), dtype=np.float64)
+        cdef np.ndarray[np.uint64_t, ndim=1] offsets = np.empty( (nspec + 1,), dtype=np.uint64)
+
+        cdef libcpp_vector[_Peak1D].iterator pit
+        cdef size_t i = 0
+        cdef size_t k = 0
+        it = exp_.begin()
+        while it != exp_.end():
+            rts[i] = deref(it).getRT()
+            offsets[i] = k
+            pit = deref(it).begin()
+            while pit != deref(it).end():
+                mzs[k] = deref(pit).getMZ()
+                intensities[k] = deref(pit).getIntensity()
+                inc(pit)
+                k += 1
+            inc(it)
+            i += 1
+        offsets[nspec] = k
+
+        return mzs, intensities, rts, offsets
+
+    def set_all_peaks(self, peaks):
+        """Cython signature: set_all_peaks(tuple peaks)
+
+        Bulk setter matching get_all_peaks(): takes (mz, intensity, rt, offsets)
+        and replaces the peaks and retention times of all spectra in one call
+        (spectrum meta data is kept). If the experiment is empty, new spectra
+        are created; otherwise len(offsets) - 1 must equal size().
+        """
+        assert isinstance(peaks, (tuple, list)) and len(peaks) == 4, "Input for set_all_peaks needs to be a tuple or a list of size 4 (mz, intensity, rt and offset vector)"
+
+        cdef np.ndarray[np.float64_t, ndim=1, mode="c"] mzs = np.ascontiguousarray(peaks[0], dtype=np.float64)
+        cdef np.ndarray[np.float32_t, ndim=1, mode="c"] intensities = np.ascontiguousarray(peaks[1], dtype=np.float32)
+        cdef np.ndarray[np.float64_t, ndim=1, mode="c"] rts = np.ascontiguousarray(peaks[2], dtype=np.float64)
+        cdef np.ndarray[np.uint64_t, ndim=1, mode="c"] offsets = np.ascontiguousarray(peaks[3], dtype=np.uint64)
+
+        assert len(mzs) == len(intensities), "Input vectors for set_all_peaks need to have the same length (mz and intensity vector)"
+        assert len(offsets) == len(rts) + 1, "Input for set_all_peaks needs one more offset than retention times"
+        assert offsets[0] == 0 and offsets[len(offsets) - 1] == len(mzs), "Offsets for set_all_peaks need to start at 0 and end at the number of peaks"
+        assert np.all(np.diff(offsets.astype(np.int64)) >= 0), "Offsets for set_all_peaks need to be non-decreasing"
+
+        cdef _MSExperiment * exp_ = self.inst.get()
+        cdef size_t nspec = len(rts)
+        if exp_.size() == 0:
+            exp_.resize(nspec)
+        assert <size_t>exp_.size() == nspec, "Number of spectra for set_all_peaks does not match the experiment"
+
+        cdef libcpp_vector[_MSSpectrum].iterator it = exp_.begin()
+        cdef _Peak1D p = _Peak1D()
+        cdef size_t i = 0
+        cdef size_t k
+        while it != exp_.end():
+            deref(it).clear(0) # empty vector , keep meta data
+            deref(it).reserve(offsets[i + 1] - offsets[i])
+            deref(it).setRT(rts[i])
+            for k in range(offsets[i], offsets[i + 1]):
+                p.setMZ(mzs[k])
+                p.setIntensity(intensities[k])
+                deref(it).push_back(p)
+            deref(it).updateRanges()
+            inc(it)
+            i += 1
+
+        exp_.updateRanges()
@@ -1,6 +1,36 @@
 
 
 
+    def load(self, filename, MSExperiment exp):
+        """Cython signature: void load(String filename, MSExperiment exp)
+
+        Loads a file into an MSExperiment. The GIL is released while the file
+        is parsed, so other Python threads can run in the meantime.
+        """
+        assert (isinstance(filename, str) or isinstance(filename, unicode) or isinstance(filename, bytes) or isinstance(filename, String)), 'arg filename wrong type'
+        assert isinstance(exp, MSExperiment), 'arg exp wrong type'
+
+        cdef shared_ptr[_String] filename_ = convString(filename)
+        cdef _MzMLFile * file_ = self.inst.get()
+        cdef _MSExperiment * exp_ = exp.inst.get()
+        with nogil:
+            file_.load(deref(filename_.get()), deref(exp_))
+
+    def store(self, filename, MSExperiment exp):
+        """Cython signature: void store(String filename, MSExperiment exp)
+
+        Stores an MSExperiment in a file. The GIL is released while the file
+        is written, so other Python threads can run in the meantime.
+        """
+        assert (isinstance(filename, str) or isinstance(filename, unicode) or isinstance(filename, bytes) or isinstance(filename, String)), 'arg filename wrong type'
+        assert isinstance(exp, MSExperiment), 'arg exp wrong type'
+
+        cdef shared_ptr[_String] filename_ = convString(filename)
+        cdef _MzMLFile * file_ = self.inst.get()
+        cdef _MSExperiment * exp_ = exp.inst.get()
+        with nogil:
+            file_.store(deref(filename_.get()), deref(exp_))
+
     def transform(self, *args):
         if (len(args)==2):
              self._transform_1(*args)
@@ -0,0 +1,49 @@
+from libc.string cimport memcpy
+cimport numpy as np
+import numpy as np
+
+
+
+
+    def get_all_peaks(self):
+        """Cython signature: tuple get_all_peaks()
+
+        Reads the peaks of all spectra from disk and returns them as
+        concatenated numpy arrays in a single call: (mz, intensity, rt, offsets).
+        The peaks of spectrum i are mz[offsets[i]:offsets[i+1]] (and likewise
+        for intensity), rt[i] is the retention time of spectrum i and offsets
+        has getNrSpectra() + 1 entries. The file is read with the GIL released.
+        """
+        cdef _OnDiscMSExperiment * exp_ = self.inst.get()
+        cdef size_t nspec = exp_.getNrSpectra()
+        cdef libcpp_vector[double] mz_buffer
+        cdef libcpp_vector[float] int_buffer
+
+        cdef np.ndarray[np.float64_t, ndim=1] rts = np.empty( (nspec,), dtype=np.float64)
+        cdef np.ndarray[np.uint64_t, ndim=1] offsets = np.empty( (nspec + 1,), dtype=np.uint64)
+        cdef double * rts_ = <double *> rts.data
+        cdef np.uint64_t * offsets_ = <np.uint64_t *> offsets.data
+
+        cdef _MSSpectrum spec
+        cdef libcpp_vector[_Peak1D].iterator pit
+        cdef size_t i
+        with nogil:
+            for i in range(nspec):
+                spec = exp_.getSpectrum(i)
+                rts_[i] = spec.getRT()
+                offsets_[i] = mz_buffer.size()
+                pit = spec.begin()
+                while pit != spec.end():
+                    mz_buffer.push_back(deref(pit).getMZ())
+                    int_buffer.push_back(deref(pit).getIntensity())
+                    inc(pit)
+            offsets_[nspec] = mz_buffer.size()
+
+        cdef size_t npeaks = mz_buffer.size()
+        cdef np.ndarray[np.float64_t, ndim=1] mzs = np.empty( (npeaks,), dtype=np.float64)
+        cdef np.ndarray[np.float32_t, ndim=1] intensities = np.empty( (npeaks,), dtype=np.float32)
+        if npeaks > 0:
+            memcpy(mzs.data, &mz_buffer[0], npeaks * sizeof(double))
+            memcpy(intensities.data, &int_buffer[0], npeaks * sizeof(float))
+
+        return mzs, intensities, rts, offsets
@@ -0,0 +1,17 @@
+
+
+
+    def pickExperiment(self, MSExperiment input, MSExperiment output):
+        """Cython signature: void pickExperiment(MSExperiment & input, MSExperiment & output)
+
+        Picks all spectra and chromatograms of an experiment. The GIL is
+        released while picking, so other Python threads can run in the meantime.
+        """
+        assert isinstance(input, MSExperiment), 'arg input wrong type'
+        assert isinstance(output, MSExperiment), 'arg output wrong type'
+
+        cdef _PeakPickerHiRes * picker_ = self.inst.get()
+        cdef _MSExperiment * input_ = input.inst.get()
+        cdef _MSExperiment * output_ = output.inst.get()
+        with nogil:
+            picker_.pickExperiment(deref(input_), deref(output_))
@@ -14,8 +14,9 @@ cdef extern from "<OpenMS/FORMAT/MzMLFile.h>" namespace "OpenMS":
 
         MzMLFile() nogil except +
 
-        void load(const String& filename, MSExperiment &) nogil except+
-        void store(const String& filename, MSExperiment &) nogil except+
+        # COMMENT: load/store release the GIL, see ../addons/MzMLFile.pyx
+        void load(const String& filename, MSExperiment &) nogil except+ # wrap-ignore
+        void store(const String& filename, MSExperiment &) nogil except+ # wrap-ignore
 
         # COMMENT: store/load XML structure to/from a string
         void storeBuffer(String & output, MSExperiment exp) nogil except +
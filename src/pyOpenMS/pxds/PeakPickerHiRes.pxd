@@ -20,9 +20,10 @@ cdef extern from "<OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>" namespace
                   MSSpectrum & output
                  ) nogil except +
 
+        # COMMENT: pickExperiment releases the GIL, see ../addons/PeakPickerHiRes.pyx
         void pickExperiment(MSExperiment & input,
                             MSExperiment & output
-                           ) nogil except +
+                           ) nogil except + # wrap-ignore
 
 cdef extern from "<OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>" namespace "OpenMS::PeakPickerHiRes":
     
@@ -2806,6 +2806,8 @@ def testMSExperiment():
      MSExperiment.removeMetaValue
      MSExperiment.getSize
      MSExperiment.isSorted
+     MSExperiment.get_all_peaks
+     MSExperiment.set_all_peaks
     """
     mse = pyopenms.MSExperiment()
     mse_ = copy.copy(mse)
@@ -2855,6 +2857,31 @@ def testMSExperiment():
     assert mse.getSize() == mse2.getSize()
     assert mse2 == mse
 
+    # bulk access to all peaks
+    mzs, intensities, rts, offsets = mse.get_all_peaks()
+    assert len(mzs) == 0
+    assert len(rts) == 1
+    assert list(offsets) == [0, 0]
+
+    bulk = pyopenms.MSExperiment()
+    bulk.set_all_peaks((np.array([100.0, 200.0, 300.0]), np.array([1.0, 2.0, 3.0]),
+                        np.array([10.0, 20.0]), np.array([0, 2, 3])))
+    assert bulk.size() == 2
+    assert bulk[0].size() == 2
+    assert bulk[1].size() == 1
+    assert abs(bulk[1].getRT() - 20.0) < 1e-6
+    mzs, intensities, rts, offsets = bulk.get_all_peaks()
+    assert mzs.dtype == np.float64
+    assert intensities.dtype == np.float32
+    assert list(mzs) == [100.0, 200.0, 300.0]
+    assert list(intensities) == [1.0, 2.0, 3.0]
+    assert list(rts) == [10.0, 20.0]
+    assert list(offsets) == [0, 2, 3]
+
+    # matches the per-spectrum accessor
+    spec_mzs, spec_intensities = bulk[0].get_peaks()
+    assert list(spec_mzs) == list(mzs[offsets[0]:offsets[1]])
+
 
 @report
 def testMSQuantifications():
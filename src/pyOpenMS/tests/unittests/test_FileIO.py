@@ -78,6 +78,14 @@ class TestIndexedMzMLFileLoader(unittest.TestCase):
         self.assertEqual( len(e.getChromatogram(0).get_peaks()[0]), 48)
         self.assertEqual( len(e.getChromatogram(0).get_peaks()[1]), 48)
 
+        # all spectra in one call
+        mzs, intensities, rts, offsets = e.get_all_peaks()
+        self.assertEqual( len(mzs), 19914 + 19800)
+        self.assertEqual( len(intensities), 19914 + 19800)
+        self.assertEqual( len(rts), 2)
+        self.assertEqual( list(offsets), [0, 19914, 19914 + 19800])
+        self.assertEqual( list(mzs[:19914]), list(data_mz))
+
         if False:
             # Currently we don't deal with exceptions properly
             raised = False
@@ -11,6 +11,7 @@ set(concept_executables_list
   LogConfigHandler_test
   LogStream_test
   Multithreading_test
+  ParallelExceptionCollector_test
   UniqueIdGenerator_test
   UniqueIdIndexer_test
   UniqueIdInterface_test
@@ -318,6 +319,7 @@ set(filtering_executables_list
   NeutralLossDiffFilter_test
   NeutralLossMarker_test
   Normalizer_test
+  ParallelSpectrumFilter_test
   ParentPeakMower_test
   PeakMarker_test
   PrecursorCorrection_test
@@ -333,6 +333,58 @@ START_SECTION(Size getHitProteinPosition())
   NOT_TESTABLE // tested above
 END_SECTION
 
+START_SECTION(static UInt64 computeChecksum(const PeptideDB& pep_db))
+  AhoCorasickAmbiguous::PeptideDB db1, db2;
+  setDB(ListUtils::create<String>("acd,adc", ','), db1);
+  setDB(ListUtils::create<String>("acd,adc", ','), db2);
+  TEST_EQUAL(AhoCorasickAmbiguous::computeChecksum(db1), AhoCorasickAmbiguous::computeChecksum(db2))
+  setDB(ListUtils::create<String>("acda,dc", ','), db2); // same characters, different peptides
+  TEST_NOT_EQUAL(AhoCorasickAmbiguous::computeChecksum(db1), AhoCorasickAmbiguous::computeChecksum(db2))
+END_SECTION
+
+START_SECTION(static bool storePattern(const FuzzyACPattern& pattern, const PeptideDB& pep_db, const String& filename))
+  NOT_TESTABLE // tested below
+END_SECTION
+
+START_SECTION(static bool loadPattern(const String& filename, const PeptideDB& pep_db, const int aaa_max, const int mm_max, FuzzyACPattern& pattern))
+  String trie_file;
+  NEW_TMP_FILE(trie_file)
+  setDB(ListUtils::create<String>("acd,adc,cad,cda,dac,dca,dcaa", ','), pep_db);
+  AhoCorasickAmbiguous::initPattern(pep_db, 2, 1, pattern);
+  TEST_EQUAL(AhoCorasickAmbiguous::storePattern(pattern, pep_db, trie_file), true)
+
+  AhoCorasickAmbiguous::FuzzyACPattern loaded;
+  TEST_EQUAL(AhoCorasickAmbiguous::loadPattern(trie_file, pep_db, 2, 1, loaded), true)
+  TEST_EQUAL((UInt)loaded.max_ambAA, 2)
+  TEST_EQUAL((UInt)loaded.max_mmAA, 1)
+  TEST_EQUAL(seqan::numVertices(loaded.data_graph), seqan::numVertices(pattern.data_graph))
+
+  // the loaded trie must find exactly the same hits (with ambiguities and mismatches)
+  String prot = "acdIBdcIcXdIcdaIdBcIdcaaKmcd";
+  AhoCorasickAmbiguous fuzzyAC;
+  std::vector<String> observed, expected;
+  fuzzyAC.setProtein(prot);
+  while (fuzzyAC.findNext(pattern))
+  {
+    expected.push_back(String(pep_db[fuzzyAC.getHitDBIndex()].data_begin, pep_db[fuzzyAC.getHitDBIndex()].data_end) + "@" + fuzzyAC.getHitProteinPosition());
+  }
+  fuzzyAC.setProtein(prot);
+  while (fuzzyAC.findNext(loaded))
+  {
+    observed.push_back(String(pep_db[fuzzyAC.getHitDBIndex()].data_begin, pep_db[fuzzyAC.getHitDBIndex()].data_end) + "@" + fuzzyAC.getHitProteinPosition());
+  }
+  TEST_EQUAL(expected.empty(), false)
+  compareHits(__LINE__, prot, ListUtils::concatenate(expected, ","), observed);
+
+  // different settings or peptides: not usable
+  TEST_EQUAL(AhoCorasickAmbiguous::loadPattern(trie_file, pep_db, 3, 1, loaded), false)
+  TEST_EQUAL(AhoCorasickAmbiguous::loadPattern(trie_file, pep_db, 2, 0, loaded), false)
+  AhoCorasickAmbiguous::PeptideDB other_db;
+  setDB(ListUtils::create<String>("acd,adc,cad,cda,dac,dca,dcad", ','), other_db);
+  TEST_EQUAL(AhoCorasickAmbiguous::loadPattern(trie_file, other_db, 2, 1, loaded), false)
+  TEST_EQUAL(AhoCorasickAmbiguous::loadPattern(trie_file + "_nonexisting", pep_db, 2, 1, loaded), false)
+END_SECTION
+
 START_SECTION([EXTRA]template<typename T> inline void _getSpawnRange(const AAcid c, T& idxFirst, T& idxLast))
 {
   // test that our AAcid translation table is correct
@@ -37,6 +37,7 @@
 
 ///////////////////////////
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrumCompareFunctor.h>
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectralContrastAngle.h>
 #include <OpenMS/CONCEPT/Factory.h>
 
 using namespace OpenMS;
@@ -85,6 +86,53 @@ START_SECTION((virtual double operator()(const BinnedSpectrum &spec) const =0))
 }
 END_SECTION
 
+START_SECTION((void getTopNeighbors(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& targets, Size k, std::vector<std::vector<Neighbor> >& neighbors, Size block_size = 1000) const))
+{
+  // A: 100, 200, 300; B: 100, 200; C: 300; D: 500
+  vector<vector<double> > positions = { {100, 200, 300}, {100, 200}, {300}, {500} };
+  vector<BinnedSpectrum> spectra;
+  for (const vector<double>& mzs : positions)
+  {
+    PeakSpectrum s;
+    for (double mz : mzs)
+    {
+      Peak1D p;
+      p.setMZ(mz);
+      p.setIntensity(1.0);
+      s.push_back(p);
+    }
+    spectra.push_back(BinnedSpectrum(s, 1.0, false, 0, 0.0));
+  }
+
+  BinnedSpectralContrastAngle sca;
+  vector<vector<BinnedSpectrumCompareFunctor::Neighbor> > neighbors;
+  // all vs. all, small blocks to cross block boundaries
+  sca.getTopNeighbors(spectra, spectra, 2, neighbors, 3);
+  TEST_EQUAL(neighbors.size(), 4)
+  ABORT_IF(neighbors.size() != 4)
+  TEST_EQUAL(neighbors[0].size(), 2)
+  TEST_EQUAL(neighbors[0][0].first, 1)
+  TEST_REAL_SIMILAR(neighbors[0][0].second, 2.0 / sqrt(6.0))
+  TEST_EQUAL(neighbors[0][1].first, 2)
+  TEST_REAL_SIMILAR(neighbors[0][1].second, 1.0 / sqrt(3.0))
+  TEST_EQUAL(neighbors[1].size(), 1)
+  TEST_EQUAL(neighbors[1][0].first, 0)
+  TEST_EQUAL(neighbors[2].size(), 1)
+  TEST_EQUAL(neighbors[2][0].first, 0)
+  TEST_EQUAL(neighbors[3].size(), 0)
+
+  // k = 1, separate query set (self matches are kept)
+  vector<BinnedSpectrum> queries(spectra.begin(), spectra.begin() + 2);
+  sca.getTopNeighbors(queries, spectra, 1, neighbors, 2);
+  TEST_EQUAL(neighbors.size(), 2)
+  ABORT_IF(neighbors.size() != 2)
+  TEST_EQUAL(neighbors[0].size(), 1)
+  TEST_EQUAL(neighbors[0][0].first, 0)
+  TEST_REAL_SIMILAR(neighbors[0][0].second, 1.0)
+  TEST_EQUAL(neighbors[1][0].first, 1)
+}
+END_SECTION
+
 START_SECTION((static void registerChildren()))
 {
   BinnedSpectrumCompareFunctor* c1 = Factory<BinnedSpectrumCompareFunctor>::create("BinnedSharedPeakCount");
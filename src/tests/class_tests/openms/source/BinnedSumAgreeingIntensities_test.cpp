@@ -110,6 +110,35 @@ START_SECTION((double operator()(const BinnedSpectrum &spec) const ))
 }
 END_SECTION
 
+START_SECTION((void compareBlock(const std::vector<BinnedSpectrum>& queries, const std::vector<BinnedSpectrum>& targets, SimilarityMatrix& scores) const))
+{
+  PeakSpectrum s1, s2, s3;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s1);
+  s2 = s1;
+  s2.pop_back();
+  s3 = s1;
+  s3.erase(s3.begin(), s3.begin() + s3.size() / 2);
+  vector<BinnedSpectrum> queries, targets;
+  queries.push_back(BinnedSpectrum(s1, 1.5, false, 2, 0));
+  queries.push_back(BinnedSpectrum(s3, 1.5, false, 2, 0));
+  targets.push_back(BinnedSpectrum(s2, 1.5, false, 2, 0));
+  targets.push_back(BinnedSpectrum(s1, 1.5, false, 2, 0));
+  targets.push_back(BinnedSpectrum(s3, 1.5, false, 2, 0));
+
+  BinnedSpectrumCompareFunctor::SimilarityMatrix scores;
+  ptr->compareBlock(queries, targets, scores);
+  TEST_EQUAL(scores.rows(), 2)
+  TEST_EQUAL(scores.cols(), 3)
+  for (Size i = 0; i < queries.size(); ++i)
+  {
+    for (Size j = 0; j < targets.size(); ++j)
+    {
+      TEST_REAL_SIMILAR(scores(i, j), (*ptr)(queries[i], targets[j]))
+    }
+  }
+}
+END_SECTION
+
 START_SECTION((static BinnedSpectrumCompareFunctor* create()))
 {
   BinnedSpectrumCompareFunctor* bsf = BinnedSumAgreeingIntensities::create();
@@ -136,6 +136,55 @@ START_SECTION(void extractChromatograms(const OpenSwath::SpectrumAccessPtr input
 }
 END_SECTION
 
+START_SECTION([EXTRA] RT-limited extraction from a non-owning spectrum access)
+{
+  double extract_window = 0.05;
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), exp);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtrNoCopy(exp);
+  TEST_EQUAL(expptr->getNrSpectra(), exp.size());
+
+  ChromatogramExtractorAlgorithm extractor;
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  std::vector< OpenSwath::ChromatogramPtr > out_exp;
+  for (int i = 0; i < 2; i++)
+  {
+    OpenSwath::ChromatogramPtr s(new OpenSwath::Chromatogram);
+    out_exp.push_back(s);
+  }
+
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 618.31; coord.rt_start = 3050; coord.rt_end = 3125; coord.id = "tr1";
+    coordinates.push_back(coord);
+    coord.mz = 628.45; coord.rt_start = 3100; coord.rt_end = 3130; coord.id = "tr2";
+    coordinates.push_back(coord);
+  }
+  extractor.extractChromatograms(expptr, out_exp, coordinates, extract_window, false, -1, "tophat");
+
+  // only spectra within the RT range of each coordinate are used
+  for (Size k = 0; k < coordinates.size(); ++k)
+  {
+    TEST_EQUAL(out_exp[k]->getTimeArray()->data.empty(), false)
+    for (Size i = 0; i < out_exp[k]->getTimeArray()->data.size(); ++i)
+    {
+      TEST_EQUAL(out_exp[k]->getTimeArray()->data[i] >= coordinates[k].rt_start, true)
+      TEST_EQUAL(out_exp[k]->getTimeArray()->data[i] <= coordinates[k].rt_end, true)
+    }
+  }
+
+  // same maxima as in the unrestricted extraction
+  double max_value = -1; double foundat = -1;
+  find_max_helper(out_exp[0], max_value, foundat);
+  TEST_REAL_SIMILAR(max_value, 35.593);
+  TEST_REAL_SIMILAR(foundat, 3055.16);
+
+  find_max_helper(out_exp[1], max_value, foundat);
+  TEST_REAL_SIMILAR(max_value, 169.792);
+  TEST_REAL_SIMILAR(foundat, 3120.26);
+}
+END_SECTION
+
 START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter))
 {
   typedef OpenMS::DataArrays::FloatDataArray FloatDataArray;
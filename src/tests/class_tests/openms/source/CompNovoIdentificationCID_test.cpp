@@ -122,6 +122,24 @@ START_SECTION((void getIdentifications(std::vector<PeptideIdentification>& ids,
   TEST_EQUAL(ids.size(), 1)
   TEST_EQUAL(ids.begin()->getHits().size() > 0, true)
   TEST_STRING_EQUAL(ids.begin()->getHits().begin()->getSequence().toString(), "DFPLANGER")
+
+  // several spectra (possibly processed in parallel) are reported in input order,
+  // and the shared decomposition cache does not change the results
+  PeakMap exp2;
+  for (Size i = 0; i != 3; ++i)
+  {
+    spec.setRT(10.0 * (i + 1));
+    exp2.addSpectrum(spec);
+  }
+  vector<PeptideIdentification> ids2;
+  cni.getIdentifications(ids2, exp2);
+  TEST_EQUAL(ids2.size(), 3)
+  for (Size i = 0; i != ids2.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(ids2[i].getRT(), 10.0 * (i + 1))
+    TEST_EQUAL(ids2[i].getHits().size(), ids.begin()->getHits().size())
+    TEST_STRING_EQUAL(ids2[i].getHits().begin()->getSequence().toString(), "DFPLANGER")
+  }
 END_SECTION
 
 START_SECTION((void getIdentification(PeptideIdentification& id, const PeakSpectrum& CID_spec)))
@@ -428,6 +428,30 @@ START_SECTION((void insert(const FeatureHandle &handle)))
   TEST_EQUAL(it->getIntensity(),200)
   ++it;
   TEST_EQUAL(it==cons.end(), true)
+
+  // out-of-order insertion keeps the handles sorted by IndexLess
+  FeatureHandle h3(1,tmp_feature);
+  h3.setUniqueId(7);
+  FeatureHandle h4(4,tmp_feature);
+  h4.setUniqueId(1);
+  cons.insert(h3);
+  cons.insert(h4);
+  TEST_EQUAL(cons.size(), 4)
+  it = cons.begin();
+  TEST_EQUAL(it->getMapIndex(),1)
+  ++it;
+  TEST_EQUAL(it->getMapIndex(),2)
+  ++it;
+  TEST_EQUAL(it->getMapIndex(),4)
+  TEST_EQUAL(it->getUniqueId(),1)
+  ++it;
+  TEST_EQUAL(it->getMapIndex(),4)
+  TEST_EQUAL(it->getUniqueId(),5)
+
+  // duplicates are rejected, both at the end and in the middle
+  TEST_EXCEPTION(Exception::InvalidValue, cons.insert(h2))
+  TEST_EXCEPTION(Exception::InvalidValue, cons.insert(h1))
+  TEST_EQUAL(cons.size(), 4)
 END_SECTION
 
 START_SECTION((void insert(UInt64 map_index, const BaseFeature &element)))
@@ -239,7 +239,20 @@ START_SECTION((bool addPoint(const PointType& point)))
 	TEST_EQUAL(tmp.addPoint(DPosition<2>(3.0,1.5)),true)
 	TEST_EQUAL(tmp.addPoint(DPosition<2>(3.0,2.5)),false)
 	TEST_EQUAL(tmp.addPoint(DPosition<2>(3.0,2.0)),false)
-	TEST_EQUAL(tmp.addPoint(DPosition<2>(0.5,0.5)),true)	
+	TEST_EQUAL(tmp.addPoint(DPosition<2>(0.5,0.5)),true)
+
+	// insertion order does not matter (scans are kept sorted by RT)
+	ConvexHull2D sorted;
+	sorted.addPoint(DPosition<2>(0.5,0.5));
+	sorted.addPoint(DPosition<2>(1.0,1.0));
+	sorted.addPoint(DPosition<2>(1.0,1.5));
+	sorted.addPoint(DPosition<2>(1.5,1.5));
+	sorted.addPoint(DPosition<2>(3.0,1.5));
+	sorted.addPoint(DPosition<2>(3.0,2.5));
+	TEST_EQUAL(sorted.getHullPoints().size(), 7)
+	// outer points are only a lazily computed view: equality is unaffected
+	TEST_EQUAL(tmp==sorted, true)
+	TEST_EQUAL(tmp.getHullPoints()==sorted.getHullPoints(), true)
 END_SECTION
 
 START_SECTION((Size compress()))
@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/CHEMISTRY/AASequence.h>
 
 ///////////////////////////
 #include <OpenMS/ANALYSIS/ID/FalseDiscoveryRate.h>
@@ -174,6 +175,40 @@ START_SECTION((void apply(std::vector<PeptideIdentification> &id)))
     pep_id = pep_ids[9];
     TEST_EQUAL(pep_id.getHits().size(), 0)
   }
+
+  // charge variants treated separately, one of them without decoys
+  FalseDiscoveryRate fdr_split;
+  Param p = fdr_split.getParameters();
+  p.setValue("split_charge_variants", "true");
+  p.setValue("add_decoy_peptides", "true");
+  fdr_split.setParameters(p);
+
+  vector<PeptideIdentification> split_ids(4);
+  const double scores[] = {10.0, 9.0, 8.0, 5.0};
+  const Int charges[] = {2, 2, 2, 3};
+  const char* target_decoy[] = {"target", "decoy", "target", "target"};
+  for (Size i = 0; i < split_ids.size(); ++i)
+  {
+    PeptideHit hit(scores[i], 1, charges[i], AASequence::fromString("PEPTIDE"));
+    hit.setMetaValue("target_decoy", target_decoy[i]);
+    split_ids[i].setScoreType("score");
+    split_ids[i].setHigherScoreBetter(true);
+    split_ids[i].insertHit(hit);
+  }
+  fdr_split.apply(split_ids);
+
+  TEST_EQUAL(split_ids[0].getScoreType(), "q-value")
+  TEST_EQUAL(split_ids[0].isHigherScoreBetter(), false)
+  TEST_REAL_SIMILAR(split_ids[0].getHits()[0].getScore(), 0.0)
+  TEST_REAL_SIMILAR((double)split_ids[0].getHits()[0].getMetaValue("score_score"), 10.0)
+  TEST_REAL_SIMILAR(split_ids[1].getHits()[0].getScore(), 0.5) // decoy: q-value of closest target
+  TEST_REAL_SIMILAR(split_ids[2].getHits()[0].getScore(), 0.5)
+  TEST_REAL_SIMILAR(split_ids[3].getHits()[0].getScore(), 0.0) // no decoys for charge 3
+  TEST_REAL_SIMILAR((double)split_ids[3].getHits()[0].getMetaValue("score_score"), 5.0)
+
+  // missing target/decoy annotation
+  split_ids[0].getHits()[0].removeMetaValue("target_decoy");
+  TEST_EXCEPTION(Exception::MissingInformation, fdr_split.apply(split_ids))
 }
 END_SECTION
 
@@ -45,6 +45,8 @@
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/CHEMISTRY/Residue.h>
 
+#include <sstream>
+
 using namespace OpenMS;
 using namespace ims;
 using namespace std;
@@ -97,6 +99,45 @@ START_SECTION(~IntegerMassDecomposer())
 }
 END_SECTION
 
+START_SECTION((void store(std::ostream &os) const))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION((IntegerMassDecomposer(const Weights &alphabet, std::istream &is)))
+{
+  typedef IntegerMassDecomposer<> Decomposer;
+  Weights weights(createWeights());
+  Decomposer decomposer(weights);
+  std::stringstream ss;
+  decomposer.store(ss);
+  const std::string table = ss.str();
+
+  std::istringstream in(table);
+  Decomposer loaded(weights, in);
+  for (Decomposer::value_type mass = 5000; mass < 20000; mass += 1234)
+  {
+    TEST_EQUAL(loaded.getNumberOfDecompositions(mass), decomposer.getNumberOfDecompositions(mass))
+  }
+
+  // truncated tables
+  std::istringstream truncated(table.substr(0, table.size() - 1));
+  TEST_EXCEPTION(Exception::ParseError, Decomposer(weights, truncated))
+  std::istringstream half(table.substr(0, table.size() / 2));
+  TEST_EXCEPTION(Exception::ParseError, Decomposer(weights, half))
+
+  // a table without rows (the residue table is the last part: row count, then the rows)
+  const Size row_bytes = sizeof(Decomposer::size_type) + weights.getWeight(0) * sizeof(Decomposer::value_type);
+  const Size rows_offset = table.size() - weights.size() * row_bytes - sizeof(Decomposer::size_type);
+  std::string no_rows = table.substr(0, rows_offset + sizeof(Decomposer::size_type));
+  Decomposer::size_type zero(0);
+  no_rows.replace(rows_offset, sizeof(zero), reinterpret_cast<const char*>(&zero), sizeof(zero));
+  std::istringstream no_rows_in(no_rows);
+  TEST_EXCEPTION(Exception::ParseError, Decomposer(weights, no_rows_in))
+}
+END_SECTION
+
 START_SECTION((bool exist(value_type mass)))
 {
   // TODO
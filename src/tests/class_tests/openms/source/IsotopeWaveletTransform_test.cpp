@@ -155,6 +155,25 @@ START_SECTION(void getTransform(MSSpectrum &c_trans, const MSSpectrum &c_ref, co
 	TEST_EQUAL (*spec!= map[0], true)
 END_SECTION
 
+START_SECTION((static void computeTransform(std::vector<double>& trans, const std::vector<double>& mz, const std::vector<double>& intens, const UInt c, const Int from_max_to_left, const double min_spacing, const bool hr_data)))
+	std::vector<double> mz, intens, trans;
+	for (Size k = 0; k < map[0].size(); ++k)
+	{
+		mz.push_back(map[0][k].getMZ());
+		intens.push_back(map[0][k].getIntensity());
+	}
+	Int from_max_to_left = (UInt) (Constants::IW_QUARTER_NEUTRON_MASS / iw->getMinSpacing());
+	IsotopeWaveletTransform<Peak1D>::computeTransform (trans, mz, intens, 0, from_max_to_left, iw->getMinSpacing(), false);
+	TEST_EQUAL (trans.size(), spec->size())
+	for (Size k = 0; k < trans.size(); k += 50)
+	{
+		TEST_REAL_SIMILAR ((float)trans[k], (*spec)[k].getIntensity())
+	}
+	trans.push_back(1);
+	IsotopeWaveletTransform<Peak1D>::computeTransform (trans, std::vector<double>(), std::vector<double>(), 0, from_max_to_left, iw->getMinSpacing(), false);
+	TEST_EQUAL (trans.empty(), true)
+END_SECTION
+
 START_SECTION(void setSigma (const double sigma))
 	iw->setSigma (1);
 	NOT_TESTABLE
@@ -45,6 +45,7 @@
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
 #include <OpenMS/SIMULATION/SimTypes.h>
 
 #include <algorithm>
@@ -468,6 +469,50 @@ START_SECTION((void getMS2Identifications(vector<ProteinIdentification>& protein
 }
 END_SECTION
 
+START_SECTION((void consumePeakMap(Interfaces::IMSDataConsumer& consumer)))
+{
+  SimTypes::MSSimExperiment peak_map = mssim.getPeakMap();
+  MSDataStoringConsumer consumer;
+  mssim.consumePeakMap(consumer);
+
+  TEST_EQUAL(consumer.getData().size(), peak_map.size())
+  ABORT_IF(consumer.getData().size() != peak_map.size())
+  for (Size i = 0; i < peak_map.size(); ++i)
+  {
+    TEST_EQUAL(consumer.getData()[i] == peak_map[i], true)
+    // peaks are released, meta data is kept
+    TEST_EQUAL(mssim.getPeakMap()[i].empty(), true)
+    TEST_EQUAL(mssim.getPeakMap()[i].getRT(), peak_map[i].getRT())
+  }
+}
+END_SECTION
+
+START_SECTION((void consumeExperiment(Interfaces::IMSDataConsumer& consumer)))
+{
+  vector<ProteinIdentification> proteins_before, proteins_after;
+  vector<PeptideIdentification> peptides_before, peptides_after;
+  mssim.getMS2Identifications(proteins_before, peptides_before);
+
+  SimTypes::MSSimExperiment experiment = mssim.getExperiment();
+  MSDataStoringConsumer consumer;
+  mssim.consumeExperiment(consumer);
+
+  TEST_EQUAL(consumer.getData().size(), experiment.size())
+  ABORT_IF(consumer.getData().size() != experiment.size())
+  Size released(0);
+  for (Size i = 0; i < experiment.size(); ++i)
+  {
+    TEST_EQUAL(consumer.getData()[i] == experiment[i], true)
+    if (mssim.getExperiment()[i].empty()) ++released;
+  }
+  TEST_EQUAL(released, experiment.size())
+
+  // identifications only rely on the spectrum meta data
+  mssim.getMS2Identifications(proteins_after, peptides_after);
+  TEST_EQUAL(peptides_after.size(), peptides_before.size())
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -40,6 +40,10 @@
 
 #include <OpenMS/FORMAT/MzMLFile.h>
 
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 using namespace OpenMS;
 
 START_TEST(MultiplexFilteringCentroided, "$Id$")
@@ -116,6 +120,34 @@ START_SECTION(std::vector<MultiplexFilterResult> filter())
     TEST_EQUAL(results[5].size(), 4);
     TEST_EQUAL(results[6].size(), 4);
     TEST_EQUAL(results[7].size(), 0);
+
+    // the results must not depend on the number of threads
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    // the blacklist is not reset between filter() calls
+    MultiplexFilteringCentroided filtering_single(exp_picked, patterns, isotopes_per_peptide_min, isotopes_per_peptide_max, intensity_cutoff, rt_band, mz_tolerance, mz_tolerance_unit, peptide_similarity, averagine_similarity, averagine_similarity_scaling, averagine_type);
+    std::vector<MultiplexFilteredMSExperiment> results_single = filtering_single.filter();
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    MultiplexFilteringCentroided filtering_multi(exp_picked, patterns, isotopes_per_peptide_min, isotopes_per_peptide_max, intensity_cutoff, rt_band, mz_tolerance, mz_tolerance_unit, peptide_similarity, averagine_similarity, averagine_similarity_scaling, averagine_type);
+    std::vector<MultiplexFilteredMSExperiment> results_multi = filtering_multi.filter();
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+    TEST_EQUAL(results_single.size(), results_multi.size())
+    for (size_t p = 0; p < std::min(results_single.size(), results_multi.size()); ++p)
+    {
+      TEST_EQUAL(results_single[p].size(), results_multi[p].size())
+      for (size_t i = 0; i < std::min(results_single[p].size(), results_multi[p].size()); ++i)
+      {
+        TEST_EQUAL(results_single[p].getPeak(i).getRTidx(), results_multi[p].getPeak(i).getRTidx())
+        TEST_EQUAL(results_single[p].getPeak(i).getMZidx(), results_multi[p].getPeak(i).getMZidx())
+        TEST_EQUAL(results_single[p].getPeak(i).size(), results_multi[p].getPeak(i).size())
+      }
+    }
 END_SECTION
 
 END_TEST
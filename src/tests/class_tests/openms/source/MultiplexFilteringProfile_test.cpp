@@ -39,6 +39,10 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/MultiplexFilteredMSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 using namespace OpenMS;
 
 START_TEST(MultiplexFilteringProfile, "$Id$")
@@ -114,6 +118,36 @@ START_SECTION(std::vector<MultiplexFilterResult> filter())
     TEST_EQUAL(results[5].size(), 5);
     TEST_EQUAL(results[6].size(), 4);
     TEST_EQUAL(results[7].size(), 0);
+
+    // the results must not depend on the number of threads
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    // the blacklist is not reset between filter() calls, and the constructor may modify the profile data
+    MSExperiment exp_profile = exp;
+    MultiplexFilteringProfile filtering_single(exp_profile, exp_picked, boundaries_exp_s, patterns, isotopes_per_peptide_min, isotopes_per_peptide_max, intensity_cutoff, rt_band, mz_tolerance, mz_tolerance_unit, peptide_similarity, averagine_similarity, averagine_similarity_scaling, averagine_type);
+    std::vector<MultiplexFilteredMSExperiment> results_single = filtering_single.filter();
+#ifdef _OPENMP
+    omp_set_num_threads(4);
+#endif
+    MSExperiment exp_profile_multi = exp;
+    MultiplexFilteringProfile filtering_multi(exp_profile_multi, exp_picked, boundaries_exp_s, patterns, isotopes_per_peptide_min, isotopes_per_peptide_max, intensity_cutoff, rt_band, mz_tolerance, mz_tolerance_unit, peptide_similarity, averagine_similarity, averagine_similarity_scaling, averagine_type);
+    std::vector<MultiplexFilteredMSExperiment> results_multi = filtering_multi.filter();
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+    TEST_EQUAL(results_single.size(), results_multi.size())
+    for (size_t p = 0; p < std::min(results_single.size(), results_multi.size()); ++p)
+    {
+      TEST_EQUAL(results_single[p].size(), results_multi[p].size())
+      for (size_t i = 0; i < std::min(results_single[p].size(), results_multi[p].size()); ++i)
+      {
+        TEST_EQUAL(results_single[p].getPeak(i).getRTidx(), results_multi[p].getPeak(i).getRTidx())
+        TEST_EQUAL(results_single[p].getPeak(i).getMZidx(), results_multi[p].getPeak(i).getMZidx())
+        TEST_EQUAL(results_single[p].getPeak(i).sizeProfile(), results_multi[p].getPeak(i).sizeProfile())
+      }
+    }
 END_SECTION
 
 END_TEST
@@ -100,7 +100,7 @@ StringList cross_link_residue2 = StringListUtils::fromQStringList(q_str_list4);
 
 Size max_variable_mods_per_peptide = 5;
 
-START_SECTION(static std::vector<OPXLDataStructs::AASeqWithMass> digestDatabase(std::vector<FASTAFile::FASTAEntry> fasta_db, EnzymaticDigestion digestor, Size min_peptide_length, StringList cross_link_residue1, StringList cross_link_residue2, std::vector<ResidueModification> fixed_modifications, std::vector<ResidueModification> variable_modifications, Size max_variable_mods_per_peptide))
+START_SECTION(static std::vector<OPXLDataStructs::AASeqWithMass> digestDatabase(const std::vector<FASTAFile::FASTAEntry>& fasta_db, const EnzymaticDigestion& digestor, Size min_peptide_length, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const std::vector<ResidueModification>& fixed_modifications, const std::vector<ResidueModification>& variable_modifications, Size max_variable_mods_per_peptide))
 
   std::vector<OPXLDataStructs::AASeqWithMass> peptides = OPXLHelper::digestDatabase(fasta_db, digestor, min_peptide_length, cross_link_residue1, cross_link_residue2, fixed_modifications, variable_modifications, max_variable_mods_per_peptide);
 
@@ -161,6 +161,41 @@ START_SECTION(static std::vector<OPXLDataStructs::XLPrecursor> enumerateCrossLin
     }
   }
 
+  // candidates are ordered by the first peptide, independent of the number of threads
+  bool ordered_by_alpha = true;
+  for (Size i = 1; i < precursors.size(); ++i)
+  {
+    if (precursors[i].alpha_index < precursors[i - 1].alpha_index) ordered_by_alpha = false;
+  }
+  TEST_EQUAL(ordered_by_alpha, true)
+
+  // same cross-links as a brute force search over all peptide pairs
+  std::vector< double > sorted_precursors(spectrum_precursors);
+  std::sort(sorted_precursors.begin(), sorted_precursors.end());
+  std::vector< int > sorted_correction_positions;
+  std::vector<OPXLDataStructs::XLPrecursor> sorted_candidates = OPXLHelper::enumerateCrossLinksAndMasses(peptides, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, sorted_precursors, sorted_correction_positions, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
+  Size n_cross_links = 0;
+  for (Size i = 0; i < sorted_candidates.size(); ++i)
+  {
+    if (sorted_candidates[i].beta_index < peptides.size()) ++n_cross_links;
+  }
+  Size n_cross_links_brute_force = 0;
+  for (Size p1 = 0; p1 < peptides.size(); ++p1)
+  {
+    for (Size p2 = p1; p2 < peptides.size(); ++p2)
+    {
+      OPXLDataStructs::XLPrecursor precursor;
+      precursor.precursor_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
+      double allowed_error = precursor.precursor_mass * precursor_mass_tolerance * 1e-6;
+      if (std::lower_bound(sorted_precursors.begin(), sorted_precursors.end(), precursor.precursor_mass - allowed_error) !=
+          std::upper_bound(sorted_precursors.begin(), sorted_precursors.end(), precursor.precursor_mass + allowed_error))
+      {
+        ++n_cross_links_brute_force;
+      }
+    }
+  }
+  TEST_EQUAL(n_cross_links, n_cross_links_brute_force)
+
 END_SECTION
 
 // building more data structures required in the following test
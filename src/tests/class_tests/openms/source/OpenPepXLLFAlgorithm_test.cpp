@@ -38,6 +38,10 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 ///////////////////////////
 #include <OpenMS/ANALYSIS/XLMS/OpenPepXLLFAlgorithm.h>
 ///////////////////////////
@@ -115,6 +119,41 @@ for (Size i = 0; i < peptide_ids.size(); i += 20)
   }
 }
 
+// the parallel search has to give exactly the same CSMs as a single-threaded one
+#ifdef _OPENMP
+{
+  PeakMap unprocessed_spectra_serial;
+  f.load(OPENMS_GET_TEST_DATA_PATH("OpenPepXLLF_input.mzML"), unprocessed_spectra_serial);
+  vector<ProteinIdentification> protein_ids_serial(1);
+  vector<PeptideIdentification> peptide_ids_serial;
+  vector< vector< OPXLDataStructs::CrossLinkSpectrumMatch > > all_top_csms_serial;
+  PeakMap spectra_serial;
+
+  int max_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  search_algorithm.run(unprocessed_spectra_serial, fasta_db, protein_ids_serial, peptide_ids_serial, all_top_csms_serial, spectra_serial);
+  omp_set_num_threads(max_threads);
+
+  TEST_EQUAL(all_top_csms_serial.size(), all_top_csms.size())
+  for (Size i = 0; i < std::min(all_top_csms.size(), all_top_csms_serial.size()); ++i)
+  {
+    TEST_EQUAL(all_top_csms_serial[i].size(), all_top_csms[i].size())
+    for (Size j = 0; j < std::min(all_top_csms[i].size(), all_top_csms_serial[i].size()); ++j)
+    {
+      TEST_REAL_SIMILAR(all_top_csms_serial[i][j].score, all_top_csms[i][j].score)
+      TEST_EQUAL(all_top_csms_serial[i][j].rank, all_top_csms[i][j].rank)
+      TEST_EQUAL(all_top_csms_serial[i][j].peptide_id_index, all_top_csms[i][j].peptide_id_index)
+    }
+  }
+  TEST_EQUAL(peptide_ids_serial.size(), peptide_ids.size())
+  for (Size i = 0; i < std::min(peptide_ids.size(), peptide_ids_serial.size()); ++i)
+  {
+    TEST_EQUAL(peptide_ids_serial[i].getMetaValue("spectrum_reference"), peptide_ids[i].getMetaValue("spectrum_reference"))
+    TEST_EQUAL(peptide_ids_serial[i].getHits()[0].getSequence().toString(), peptide_ids[i].getHits()[0].getSequence().toString())
+  }
+}
+#endif
+
 END_SECTION
 
 
@@ -0,0 +1,99 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
+///////////////////////////
+
+#include <OpenMS/FILTERING/TRANSFORMERS/NLargest.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ParallelSpectrumFilter, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap exp;
+for (Size s = 0; s < 100; ++s)
+{
+  MSSpectrum spec;
+  spec.setRT(double(s));
+  for (Size p = 0; p < 20; ++p)
+  {
+    Peak1D peak;
+    peak.setMZ(100.0 + p);
+    peak.setIntensity(float((p * 7 + s) % 20));
+    spec.push_back(peak);
+  }
+  exp.addSpectrum(spec);
+}
+
+START_SECTION((template <typename ContainerType, typename FilterType, typename OperationType> static void apply(ContainerType& data, const FilterType& filter, OperationType operation, const ProgressLogger* progress_logger = nullptr, Size progress_offset = 0)))
+{
+  NLargest filter(5);
+
+  // serial reference
+  PeakMap serial = exp;
+  for (Size i = 0; i < serial.size(); ++i)
+  {
+    filter.filterSpectrum(serial[i]);
+  }
+
+  PeakMap parallel = exp;
+  ParallelSpectrumFilter::apply(parallel.getSpectra(), filter,
+                                [](NLargest& f, MSSpectrum& s) { f.filterSpectrum(s); });
+  TEST_EQUAL(parallel.size(), serial.size())
+  for (Size i = 0; i < serial.size(); ++i)
+  {
+    TEST_EQUAL(parallel[i] == serial[i], true)
+  }
+
+  // exceptions are propagated to the caller
+  TEST_EXCEPTION(Exception::InvalidValue, ParallelSpectrumFilter::apply(parallel.getSpectra(), filter,
+                 [](NLargest&, MSSpectrum& s)
+                 {
+                   if (s.getRT() == 42.0) throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", "42");
+                 }))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -35,6 +35,9 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 
+#include <fstream>
+
+#include <QtCore/QDir>
 #include <QtCore/QStringList>
 
 ///////////////////////////
@@ -272,6 +275,68 @@ START_SECTION((ExitCodes run(std::vector<FASTAFile::FASTAEntry>& proteins, std::
   std::vector<FASTAFile::FASTAEntry> proteins_7 = toFASTAVec(QStringList() << "PEPTIDEXXX" << "PEPTLDEXXX", QStringList() << "rev_Protein1" << "reverse_Protein");
   PeptideIndexing::ExitCodes r_7 = pi_7.run(proteins_7, prot_ids_2, pep_ids_2);
   TEST_EQUAL(r_7, PeptideIndexing::DECOYSTRING_EMPTY);
+
+  // trie cache: the second run loads the trie built by the first one and must give the same result
+  {
+    String cache_dir = File::getTempDirectory() + "/PeptideIndexing_test_" + File::getUniqueName(false);
+    QDir().mkpath(cache_dir.toQString());
+    PeptideIndexing pi_cache;
+    Param p_cache = pi_cache.getParameters();
+    p_cache.setValue("automaton_cache", cache_dir);
+    p_cache.setValue("aaa_max", 1);
+    p_cache.setValue("decoy_string", "DECOY_");
+    pi_cache.setParameters(p_cache);
+    std::vector<FASTAFile::FASTAEntry> proteins_cache = toFASTAVec(QStringList() << "*MLT*EAXK" << "MLTEAEKSSSSK", QStringList() << "Protein1" << "DECOY_Protein2");
+    std::vector<ProteinIdentification> prot_ids_cache;
+    std::vector<PeptideIdentification> pep_ids_cache = toPepVec(QStringList() << "MLTEAEK" << "SSSSK");
+    TEST_EQUAL(pi_cache.run(proteins_cache, prot_ids_cache, pep_ids_cache), PeptideIndexing::EXECUTION_OK)
+    TEST_EQUAL(QDir(cache_dir.toQString()).entryList(QDir::Files).size(), 1)
+    std::set<String> acc_first = pep_ids_cache[0].getHits()[0].extractProteinAccessionsSet();
+    TEST_EQUAL(acc_first.size(), 2)
+
+    pep_ids_cache = toPepVec(QStringList() << "MLTEAEK" << "SSSSK");
+    TEST_EQUAL(pi_cache.run(proteins_cache, prot_ids_cache, pep_ids_cache), PeptideIndexing::EXECUTION_OK)
+    TEST_EQUAL(QDir(cache_dir.toQString()).entryList(QDir::Files).size(), 1) // re-used, not rebuilt
+    TEST_EQUAL(pep_ids_cache[0].getHits()[0].extractProteinAccessionsSet() == acc_first, true)
+    TEST_EQUAL(String(pep_ids_cache[1].getHits()[0].getMetaValue("target_decoy")), "decoy")
+    File::removeDirRecursively(cache_dir);
+  }
+}
+END_SECTION
+
+START_SECTION((template <typename T> ExitCodes run(FASTAContainer<T>& proteins, std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids)))
+{
+  PeptideIndexing pi;
+  Param p = pi.getParameters();
+  p.setValue("decoy_string", "DECOY_");
+  pi.setParameters(p);
+  std::vector<ProteinIdentification> prot_ids;
+  std::vector<PeptideIdentification> pep_ids = toPepVec(QStringList() << "PEPTIDEK");
+
+  // the first protein is already invalid
+  String invalid_file;
+  NEW_TMP_FILE(invalid_file)
+  {
+    std::ofstream out(invalid_file.c_str());
+    out << "PEPTIDEK\n";
+  }
+  FASTAContainer<TFI_File> invalid_proteins(invalid_file);
+  TEST_EXCEPTION(Exception::ParseError, pi.run(invalid_proteins, prot_ids, pep_ids))
+
+  // truncated after the first chunk of 400k proteins, i.e. the error occurs while reading the next chunk in the background
+  String truncated_file;
+  NEW_TMP_FILE(truncated_file)
+  {
+    std::ofstream out(truncated_file.c_str());
+    for (Size i = 0; i < 400000; ++i)
+    {
+      out << ">P" << i << "\nPEPTIDEK\n";
+    }
+    out << ">";
+  }
+  FASTAContainer<TFI_File> truncated_proteins(truncated_file);
+  pep_ids = toPepVec(QStringList() << "PEPTIDEK");
+  TEST_EXCEPTION(Exception::ParseError, pi.run(truncated_proteins, prot_ids, pep_ids))
 }
 END_SECTION
 
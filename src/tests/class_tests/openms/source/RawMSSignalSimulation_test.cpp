@@ -39,9 +39,68 @@
 #include <OpenMS/SIMULATION/RawMSSignalSimulation.h>
 ///////////////////////////
 
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CONCEPT/Constants.h>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
+/// runs generateRawSignals() with a fixed seed on a small LC/MS run (with noise and m/z and intensity variation enabled)
+void simulateRun(SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+{
+  experiment = SimTypes::MSSimExperiment();
+  experiment.resize(120);
+  ScanWindow sw;
+  sw.begin = 300;
+  sw.end = 1200;
+  for (Size i = 0; i < experiment.size(); ++i)
+  {
+    experiment[i].setRT(100.0 + i * 2.0);
+    experiment[i].setMetaValue("distortion", 1.0);
+    experiment[i].getInstrumentSettings().getScanWindows().push_back(sw);
+  }
+  experiment.updateRanges();
+  experiment_ct = experiment;
+
+  const char* sequences[] = {"PEPTIDEK", "ELVISLIVESK", "SAMPLERK", "LIGANDR", "DFPIANGER", "TVAAPSVFIFPPSDEQLK", "AEFVEVTK", "HLVDEPQNLIK"};
+  SimTypes::FeatureMapSim features;
+  for (Size i = 0; i < 40; ++i)
+  {
+    const AASequence seq = AASequence::fromString(sequences[i % 8]);
+    const Int charge = 2 + Int(i % 2);
+    PeptideHit hit;
+    hit.setSequence(seq);
+    PeptideIdentification id;
+    id.insertHit(hit);
+    Feature f;
+    f.getPeptideIdentifications().push_back(id);
+    f.setCharge(charge);
+    f.setMZ((seq.getMonoWeight() + charge * Constants::PROTON_MASS_U) / charge);
+    f.setRT(120.0 + i * 4.5);
+    f.setIntensity(1000.0 + 100.0 * i);
+    f.setMetaValue("charge_adducts", "H" + String(charge));
+    f.setMetaValue("RT_egh_variance", 20.0);
+    f.setMetaValue("RT_egh_tau", 0.0);
+    features.push_back(f);
+  }
+
+  SimTypes::MutableSimRandomNumberGeneratorPtr rnd_gen(new SimTypes::SimRandomNumberGenerator);
+  rnd_gen->initialize(false, false); // fixed seeds
+  RawMSSignalSimulation raw_sim(rnd_gen);
+  Param p = raw_sim.getParameters();
+  p.setValue("variation:mz:error_stddev", 0.001);
+  p.setValue("variation:intensity:scale_stddev", 0.1);
+  p.setValue("noise:shot:rate", 0.1);
+  p.setValue("noise:white:stddev", 1.0);
+  raw_sim.setParameters(p);
+  SimTypes::FeatureMapSim contaminants;
+  raw_sim.generateRawSignals(features, experiment, experiment_ct, contaminants);
+}
+
 START_TEST(RawMSSignalSimulation, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -95,7 +154,33 @@ END_SECTION
 
 START_SECTION((void generateRawSignals(SimTypes::FeatureMapSim &features, SimTypes::MSSimExperiment &experiment, SimTypes::MSSimExperiment &experiment_ct, SimTypes::FeatureMapSim &contaminants)))
 {
-  // TODO
+  // the simulated data must not depend on the number of threads
+#ifdef _OPENMP
+  const int max_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  SimTypes::MSSimExperiment exp_single, exp_ct_single;
+  simulateRun(exp_single, exp_ct_single);
+#ifdef _OPENMP
+  omp_set_num_threads(4);
+#endif
+  SimTypes::MSSimExperiment exp_multi, exp_ct_multi;
+  simulateRun(exp_multi, exp_ct_multi);
+#ifdef _OPENMP
+  omp_set_num_threads(max_threads);
+#endif
+
+  TEST_NOT_EQUAL(exp_single.getSize(), 0)
+  TEST_NOT_EQUAL(exp_ct_single.getSize(), 0)
+  TEST_EQUAL(exp_single.size(), exp_multi.size())
+  TEST_EQUAL(exp_single.getSize(), exp_multi.getSize())
+  TEST_EQUAL(exp_ct_single.getSize(), exp_ct_multi.getSize())
+  bool identical = true;
+  for (Size i = 0; i < exp_single.size(); ++i)
+  {
+    identical = identical && (exp_single[i] == exp_multi[i]) && (exp_ct_single[i] == exp_ct_multi[i]);
+  }
+  TEST_EQUAL(identical, true)
 }
 END_SECTION
 
@@ -117,6 +117,59 @@ START_SECTION((number_of_decompositions_type getNumberOfDecompositions(double ma
 }
 END_SECTION
 
+START_SECTION((std::vector<decompositions_type> getDecompositions(const std::vector<double> &masses, double error) const))
+{
+  const RealMassDecomposer decomposer(createWeights());
+  vector<double> masses;
+  masses.push_back(57.02146);  // G
+  masses.push_back(114.04293); // GG or N
+  masses.push_back(300.0);
+  masses.push_back(1.0);       // nothing
+  vector<RealMassDecomposer::decompositions_type> batch = decomposer.getDecompositions(masses, 0.05);
+  TEST_EQUAL(batch.size(), masses.size())
+  for (Size i = 0; i != masses.size(); ++i)
+  {
+    TEST_EQUAL(batch[i] == decomposer.getDecompositions(masses[i], 0.05), true)
+  }
+  TEST_EQUAL(batch[0].size(), 1)
+  TEST_EQUAL(batch[1].size(), 2)
+  TEST_EQUAL(batch[3].empty(), true)
+
+  // copies share the table and give the same results
+  RealMassDecomposer copy(decomposer);
+  TEST_EQUAL(copy.getDecompositions(masses[2], 0.05) == batch[2], true)
+}
+END_SECTION
+
+START_SECTION((void storeTable(const std::string &table_file) const))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION((RealMassDecomposer(const Weights &weights, const std::string &table_file)))
+{
+  Weights weights(createWeights());
+  RealMassDecomposer decomposer(weights);
+  String table_file;
+  NEW_TMP_FILE(table_file)
+  decomposer.storeTable(table_file);
+
+  RealMassDecomposer loaded(weights, table_file);
+  for (double mass = 57.0; mass < 600.0; mass += 13.7)
+  {
+    TEST_EQUAL(loaded.getDecompositions(mass, 0.1) == decomposer.getDecompositions(mass, 0.1), true)
+    TEST_EQUAL(loaded.getNumberOfDecompositions(mass, 0.1), decomposer.getNumberOfDecompositions(mass, 0.1))
+  }
+
+  // the table belongs to a specific set of weights
+  Weights other_weights(weights);
+  other_weights.setPrecision(0.001);
+  TEST_EXCEPTION(Exception::ParseError, RealMassDecomposer(other_weights, table_file))
+  TEST_EXCEPTION(Exception::FileNotFound, RealMassDecomposer(weights, table_file + ".missing"))
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
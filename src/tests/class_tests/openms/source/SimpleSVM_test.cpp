@@ -191,6 +191,71 @@ START_SECTION((void writeXvalResults(const String& path) const))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] void setup(PredictorMap& predictors, const map<Size, Int>& labels) with successive halving))
+{
+  SimpleSVM halving_svm;
+  Param params = halving_svm.getParameters();
+  params.setValue("successive_halving", "true");
+  halving_svm.setParameters(params);
+  halving_svm.setup(predictors, labels);
+
+  vector<SimpleSVM::Prediction> predictions;
+  halving_svm.predict(predictions);
+  TEST_EQUAL(predictions.size(), predictors.begin()->second.size());
+  // most training observations should be classified correctly:
+  Size n_correct = 0;
+  for (map<Size, Int>::const_iterator it = labels.begin(); it != labels.end();
+       ++it)
+  {
+    if (predictions[it->first].label == it->second) n_correct++;
+  }
+  TEST_EQUAL(n_correct > labels.size() / 2, true);
+
+  // the cross-validation partitions are the same as for the full grid search
+  // ('svm'), so all combinations that were not discarded have the same
+  // performance, and the best combination is not discarded on these data:
+  string full_file, halving_file;
+  NEW_TMP_FILE(full_file);
+  NEW_TMP_FILE(halving_file);
+  svm.writeXvalResults(full_file);
+  halving_svm.writeXvalResults(halving_file);
+  ifstream full_in(full_file.c_str()), halving_in(halving_file.c_str());
+  string full_line, halving_line;
+  Size n_lines = 0, n_kept = 0;
+  while (getline(full_in, full_line) && getline(halving_in, halving_line))
+  {
+    ++n_lines;
+    if (n_lines == 1) continue; // header
+    vector<String> full_parts, halving_parts;
+    String(full_line).split('\t', full_parts);
+    String(halving_line).split('\t', halving_parts);
+    TEST_EQUAL(halving_parts.size(), 3);
+    TEST_EQUAL(full_parts.size(), 3);
+    TEST_EQUAL(halving_parts[0], full_parts[0]);
+    TEST_EQUAL(halving_parts[1], full_parts[1]);
+    if (halving_parts[2].toDouble() == 0.0) continue; // discarded
+    ++n_kept;
+    TEST_EQUAL(halving_parts[2], full_parts[2]);
+  }
+  TEST_EQUAL(n_lines > 2, true);
+  TEST_EQUAL(n_kept > 0, true);
+  TEST_EQUAL(n_kept < n_lines - 1, true);
+
+  // same parameters chosen => same model => same feature weights:
+  TOLERANCE_ABSOLUTE(1e-5);
+  TOLERANCE_RELATIVE(1.00001);
+  map<String, double> full_weights, halving_weights;
+  svm.getFeatureWeights(full_weights);
+  halving_svm.getFeatureWeights(halving_weights);
+  TEST_EQUAL(halving_weights.size(), full_weights.size());
+  for (map<String, double>::const_iterator it = full_weights.begin();
+       it != full_weights.end(); ++it)
+  {
+    TEST_REAL_SIMILAR(halving_weights[it->first], it->second);
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -144,6 +144,39 @@ START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType
     TEST_EQUAL(exp[i].getMSLevel (), exp2[i].getMSLevel ())
   }
 
+  // chain of three precursors: neighbours are within tolerance, the outer two are not
+  PeakMap chain;
+  for (Size i = 0; i < 3; ++i)
+  {
+    MSSpectrum s;
+    s.setMSLevel(2);
+    s.setRT(4.0 * i);
+    std::vector<Precursor> pcs(1);
+    pcs[0].setMZ(500.0);
+    s.setPrecursors(pcs);
+    Peak1D peak;
+    peak.setMZ(100.0 + i);
+    peak.setIntensity(10.0);
+    s.push_back(peak);
+    chain.addSpectrum(s);
+  }
+  p = merger.getParameters();
+  p.setValue("precursor_method:mz_tolerance", 0.01);
+  p.setValue("precursor_method:rt_tolerance", 5.0);
+
+  PeakMap chain_single = chain;
+  p.setValue("precursor_method:linkage", "single");
+  merger.setParameters(p);
+  merger.mergeSpectraPrecursors(chain_single);
+  TEST_EQUAL(chain_single.size(), 1)
+  TEST_EQUAL(chain_single[0].size(), 3)
+
+  PeakMap chain_complete = chain;
+  p.setValue("precursor_method:linkage", "complete");
+  merger.setParameters(p);
+  merger.mergeSpectraPrecursors(chain_complete);
+  TEST_EQUAL(chain_complete.size(), 2)
+
 END_SECTION
 
 START_SECTION((template < typename MapType > void averageGaussian(MapType &exp)))
@@ -38,6 +38,12 @@
 #include <OpenMS/DATASTRUCTURES/StringUtils.h>
 ///////////////////////////
 
+#include <clocale>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -263,6 +269,105 @@ START_SECTION((static double toDouble(const String &this_s)))
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble(" 1234.45 911.0"))     // '911.0' is not explained...
   // incorrect type
   TEST_EXCEPTION(Exception::ConversionError, StringUtils::toDouble(" abc "))
+  TEST_EQUAL(StringUtils::toDouble(" 1608.6192408112111 ") == 1608.6192408112111, true) // correctly rounded
+}
+END_SECTION
+
+START_SECTION((static bool toInt(const char* begin, const char* end, Int& target)))
+{
+  const char* s = " -123 ";
+  Int i(0);
+  TEST_EQUAL(StringUtils::toInt(s, s + strlen(s), i), true)
+  TEST_EQUAL(i, -123)
+  s = "12 3";
+  TEST_EQUAL(StringUtils::toInt(s, s + strlen(s), i), false)
+  // only the given range is parsed
+  s = "4567";
+  TEST_EQUAL(StringUtils::toInt(s, s + 2, i), true)
+  TEST_EQUAL(i, 45)
+}
+END_SECTION
+
+START_SECTION((static bool toFloat(const char* begin, const char* end, float& target)))
+{
+  const char* s = "1234.45 ";
+  float f(0);
+  TEST_EQUAL(StringUtils::toFloat(s, s + strlen(s), f), true)
+  TEST_REAL_SIMILAR(f, 1234.45)
+  s = "abc";
+  TEST_EQUAL(StringUtils::toFloat(s, s + strlen(s), f), false)
+}
+END_SECTION
+
+START_SECTION((static bool toDouble(const char* begin, const char* end, double& target)))
+{
+  const char* s = "   1234.45  ";
+  double d(0);
+  TEST_EQUAL(StringUtils::toDouble(s, s + strlen(s), d), true)
+  TEST_REAL_SIMILAR(d, 1234.45)
+  s = "1.5e3";
+  TEST_EQUAL(StringUtils::toDouble(s, s + strlen(s), d), true)
+  TEST_REAL_SIMILAR(d, 1500.0)
+  s = " 1234.45 911.0";
+  TEST_EQUAL(StringUtils::toDouble(s, s + strlen(s), d), false)
+  s = "";
+  TEST_EQUAL(StringUtils::toDouble(s, s, d), false)
+  // long numbers are correctly rounded
+  s = "1608.6192408112111";
+  TEST_EQUAL(StringUtils::toDouble(s, s + strlen(s), d), true)
+  TEST_EQUAL(d == 1608.6192408112111, true)
+}
+END_SECTION
+
+START_SECTION((template <typename T> String StringConversions::floatToString(T f)))
+{
+  // same output as a stream with precision writtenDigits()
+  TEST_EQUAL(StringConversions::floatToString(17.012345), "17.012345")
+  TEST_EQUAL(StringConversions::floatToString(float(17.0123)), "17.0123")
+  TEST_EQUAL(StringConversions::floatToString(1.0 / 3.0), "0.333333333333333")
+  TEST_EQUAL(StringConversions::floatToString(1.5e-20), "1.5e-20")
+  TEST_EQUAL(StringConversions::floatToString(-250000.0), "-250000")
+  TEST_EQUAL(StringConversions::floatToString(std::numeric_limits<double>::infinity()), "inf")
+
+  // the decimal separator does not depend on the C locale
+  String current_locale = std::setlocale(LC_NUMERIC, nullptr);
+  if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") != nullptr)
+  {
+    TEST_EQUAL(StringConversions::floatToString(1234.5), "1234.5")
+    TEST_EQUAL(StringConversions::floatToShortestString(0.1 + 0.2), "0.30000000000000004")
+    std::setlocale(LC_NUMERIC, current_locale.c_str());
+  }
+}
+END_SECTION
+
+START_SECTION((template <typename T> String StringConversions::floatToShortestString(T f)))
+{
+  TEST_EQUAL(StringConversions::floatToShortestString(88.99), "88.99")
+  TEST_EQUAL(StringConversions::floatToShortestString(0.1 + 0.2), "0.30000000000000004")
+  TEST_EQUAL(StringConversions::floatToShortestString(1.0 / 3.0), "0.3333333333333333")
+  TEST_EQUAL(StringConversions::floatToShortestString(float(0.1)), "0.1")
+  TEST_EQUAL(StringConversions::floatToShortestString(std::numeric_limits<double>::infinity()), "inf")
+
+  // round trip
+  double values[] = {1.0 / 7.0, 445.12345678901234, 1.0e-300, std::numeric_limits<double>::max(), -2.2250738585072014e-308, 1608.6192408112111};
+  for (double d : values)
+  {
+    TEST_EQUAL(StringUtils::toDouble(StringConversions::floatToShortestString(d)) == d, true)
+  }
+
+  // randomized round trip (fixed seed) through toDouble() and toFloat()
+  std::mt19937_64 rng(4711);
+  std::uniform_real_distribution<double> exponent(-20.0, 20.0);
+  Size failed_double(0), failed_float(0);
+  for (Size i = 0; i < 100000; ++i)
+  {
+    double d = std::pow(10.0, exponent(rng)) * ((rng() & 1) ? -1.0 : 1.0);
+    if (StringUtils::toDouble(StringConversions::floatToShortestString(d)) != d) ++failed_double;
+    float f = float(d);
+    if (StringUtils::toFloat(StringConversions::floatToShortestString(f)) != f) ++failed_float;
+  }
+  TEST_EQUAL(failed_double, 0)
+  TEST_EQUAL(failed_float, 0)
 }
 END_SECTION
 
@@ -0,0 +1,226 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2018.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/MaxIntensityPyramid.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <fstream>
+///////////////////////////
+
+using namespace OpenMS;
+
+START_TEST(MaxIntensityPyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+// 4 MS1 spectra (RT 10, 20, 30, 40) with peaks at m/z 100, 200, 300, 400;
+// the intensity of peak j in spectrum i is (i + 1) * 10 + j
+PeakMap exp;
+for (Size i = 0; i < 4; ++i)
+{
+  MSSpectrum spec;
+  spec.setRT(10.0 * (i + 1));
+  spec.setMSLevel(1);
+  for (Size j = 0; j < 4; ++j)
+  {
+    Peak1D p;
+    p.setMZ(100.0 * (j + 1));
+    p.setIntensity((i + 1) * 10.0 + j);
+    spec.push_back(p);
+  }
+  exp.addSpectrum(spec);
+}
+// MS2 spectra are ignored
+MSSpectrum ms2;
+ms2.setRT(25.0);
+ms2.setMSLevel(2);
+Peak1D high;
+high.setMZ(250.0);
+high.setIntensity(1000.0);
+ms2.push_back(high);
+exp.addSpectrum(ms2);
+
+MaxIntensityPyramid* ptr = nullptr;
+MaxIntensityPyramid* null_ptr = nullptr;
+START_SECTION((MaxIntensityPyramid()))
+  ptr = new MaxIntensityPyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getLevelCount(), 0)
+END_SECTION
+
+START_SECTION(([EXTRA] ~MaxIntensityPyramid()))
+  delete ptr;
+END_SECTION
+
+START_SECTION((void build(const PeakMap& map, Size rt_bins = 0, Size mz_bins = 0)))
+  MaxIntensityPyramid lod;
+  lod.build(exp, 4, 4);
+  TEST_EQUAL(lod.empty(), false)
+  // 4x4, 2x2, 1x1
+  TEST_EQUAL(lod.getLevelCount(), 3)
+  TEST_EQUAL(lod.getRTBins(0), 4)
+  TEST_EQUAL(lod.getMZBins(0), 4)
+  TEST_EQUAL(lod.getRTBins(1), 2)
+  TEST_EQUAL(lod.getMZBins(2), 1)
+
+  // RT bins are limited by the number of MS1 spectra
+  MaxIntensityPyramid lod2;
+  lod2.build(exp, 100, 4);
+  TEST_EQUAL(lod2.getRTBins(0), 4)
+
+  // resolution from the data density: one row per spectrum, CELLS_PER_PEAK cells per peak
+  MaxIntensityPyramid lod4;
+  lod4.build(exp);
+  TEST_EQUAL(lod4.getRTBins(0), 4)
+  TEST_EQUAL(lod4.getMZBins(0), 4 * MaxIntensityPyramid::CELLS_PER_PEAK)
+
+  // no MS1 peaks
+  MaxIntensityPyramid lod3;
+  lod3.build(PeakMap());
+  TEST_EQUAL(lod3.empty(), true)
+END_SECTION
+
+MaxIntensityPyramid lod;
+lod.build(exp, 4, 4);
+
+START_SECTION((float getCell(Size level, Size rt_bin, Size mz_bin) const))
+  TEST_REAL_SIMILAR(lod.getCell(0, 0, 0), 10.0)
+  TEST_REAL_SIMILAR(lod.getCell(0, 3, 3), 43.0)
+  TEST_REAL_SIMILAR(lod.getCell(0, 1, 2), 22.0)
+  TEST_REAL_SIMILAR(lod.getCell(1, 0, 0), 21.0)
+  TEST_REAL_SIMILAR(lod.getCell(1, 1, 1), 43.0)
+  TEST_REAL_SIMILAR(lod.getCell(1, 0, 1), 23.0)
+  TEST_REAL_SIMILAR(lod.getCell(2, 0, 0), 43.0)
+END_SECTION
+
+START_SECTION((float getMaxIntensity(Size level, double rt_start, double rt_end, double mz_start, double mz_end) const))
+  // everything
+  TEST_REAL_SIMILAR(lod.getMaxIntensity(0, 0.0, 1000.0, 0.0, 1000.0), 43.0)
+  TEST_REAL_SIMILAR(lod.getMaxIntensity(2, 0.0, 1000.0, 0.0, 1000.0), 43.0)
+  // a single peak
+  TEST_REAL_SIMILAR(lod.getMaxIntensity(0, 9.0, 11.0, 99.0, 101.0), 10.0)
+  // cells overlapping the interval
+  TEST_REAL_SIMILAR(lod.getMaxIntensity(0, 15.0, 25.0, 150.0, 250.0), 21.0)
+  // outside of the data
+  TEST_EQUAL(lod.getMaxIntensity(0, 50.0, 60.0, 0.0, 1000.0) < 0.0, true)
+  TEST_EQUAL(lod.getMaxIntensity(0, 0.0, 5.0, 0.0, 1000.0) < 0.0, true)
+  TEST_EQUAL(lod.getMaxIntensity(0, 0.0, 1000.0, 500.0, 600.0) < 0.0, true)
+END_SECTION
+
+START_SECTION((Size selectLevel(double rt_extent, double mz_extent) const))
+  // cell size of level 0 is 7.5 (RT) x 75 (m/z)
+  TEST_EQUAL(lod.selectLevel(7.5, 75.0), 0)
+  TEST_EQUAL(lod.selectLevel(20.0, 200.0), 1)
+  TEST_EQUAL(lod.selectLevel(100.0, 1000.0), 2)
+  // finer than the finest level: use raw peaks
+  TEST_EQUAL(lod.selectLevel(1.0, 1.0), lod.getLevelCount())
+END_SECTION
+
+START_SECTION((bool matches(const PeakMap& map) const))
+  TEST_EQUAL(lod.matches(exp), true)
+  PeakMap changed = exp;
+  changed[0].pop_back();
+  TEST_EQUAL(lod.matches(changed), false)
+  TEST_EQUAL(MaxIntensityPyramid().matches(exp), false)
+END_SECTION
+
+START_SECTION((void clear()))
+  MaxIntensityPyramid tmp = lod;
+  tmp.clear();
+  TEST_EQUAL(tmp.empty(), true)
+  TEST_EQUAL(tmp.matches(exp), false)
+END_SECTION
+
+START_SECTION((bool store(const String& filename, const String& data_file = "") const))
+  NOT_TESTABLE // tested with load()
+END_SECTION
+
+START_SECTION((bool load(const String& filename, const String& data_file = "")))
+  String filename;
+  NEW_TMP_FILE(filename)
+  TEST_EQUAL(lod.store(filename), true)
+  MaxIntensityPyramid loaded;
+  TEST_EQUAL(loaded.load(filename), true)
+  TEST_EQUAL(loaded.getLevelCount(), lod.getLevelCount())
+  TEST_EQUAL(loaded.matches(exp), true)
+  for (Size level = 0; level < lod.getLevelCount(); ++level)
+  {
+    for (Size r = 0; r < lod.getRTBins(level); ++r)
+    {
+      for (Size m = 0; m < lod.getMZBins(level); ++m)
+      {
+        TEST_EQUAL(loaded.getCell(level, r, m), lod.getCell(level, r, m))
+      }
+    }
+  }
+
+  // not a level-of-detail cache file
+  String other;
+  NEW_TMP_FILE(other)
+  {
+    std::ofstream os(other.c_str());
+    os << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n";
+  }
+  TEST_EQUAL(loaded.load(other), false)
+  TEST_EQUAL(loaded.empty(), true)
+  TEST_EQUAL(loaded.load("this_file_does_not_exist.lod"), false)
+
+  // cache of a data file: outdated once the data file is rewritten
+  String data_file, cache_file;
+  NEW_TMP_FILE(data_file)
+  NEW_TMP_FILE(cache_file)
+  {
+    std::ofstream os(data_file.c_str());
+    os << "data";
+  }
+  TEST_EQUAL(lod.store(cache_file, data_file), true)
+  TEST_EQUAL(loaded.load(cache_file, data_file), true)
+  TEST_EQUAL(loaded.getLevelCount(), lod.getLevelCount())
+  TEST_EQUAL(loaded.load(cache_file), true) // no data file given: not checked
+  {
+    std::ofstream os(data_file.c_str());
+    os << "rewritten data";
+  }
+  TEST_EQUAL(loaded.load(cache_file, data_file), false)
+  TEST_EQUAL(loaded.empty(), true)
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -48,6 +48,11 @@
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace OpenMS;
 using namespace std;
@@ -141,6 +146,8 @@ protected:
 
   String algorithm_; // algorithm for consensus calculation (input parameter)
 
+  Param algo_params_; // parameters for the consensus algorithm
+
   void registerOptionsAndFlags_() override
   {
     registerInputFile_("in", "<file>", "", "input file");
@@ -231,9 +238,75 @@ protected:
   }
 
 
+  /// creates a (new) instance of the consensus algorithm; one is needed per thread
+  ConsensusIDAlgorithm* createAlgorithm_() const
+  {
+    ConsensusIDAlgorithm* consensus;
+    if (algorithm_ == "PEPMatrix")
+    {
+      consensus = new ConsensusIDAlgorithmPEPMatrix();
+    }
+    else if (algorithm_ == "PEPIons")
+    {
+      consensus = new ConsensusIDAlgorithmPEPIons();
+    }
+    else if (algorithm_ == "best")
+    {
+      consensus = new ConsensusIDAlgorithmBest();
+    }
+    else if (algorithm_ == "worst")
+    {
+      consensus = new ConsensusIDAlgorithmWorst();
+    }
+    else if (algorithm_ == "average")
+    {
+      consensus = new ConsensusIDAlgorithmAverage();
+    }
+    else // algorithm_ == "ranks"
+    {
+      consensus = new ConsensusIDAlgorithmRanks();
+    }
+    consensus->setParameters(algo_params_);
+    return consensus;
+  }
+
+
+  /**
+    @brief Computes the consensus for each group of peptide IDs in parallel
+
+    Groups are independent, so each thread uses its own algorithm instance (with its own similarity cache).
+    Results are written back in place, so the output order does not depend on the number of threads.
+  */
+  void applyConsensus_(vector<vector<PeptideIdentification>*>& groups, const vector<Size>& number_of_runs)
+  {
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      ConsensusIDAlgorithm* consensus = createAlgorithm_();
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 100)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)groups.size(); ++i)
+      {
+        try
+        {
+          consensus->apply(*groups[i], number_of_runs[i]);
+        }
+        catch (...)
+        {
+          exceptions.capture();
+        }
+      }
+      delete consensus;
+    }
+    exceptions.rethrow();
+  }
+
+
   template <typename MapType>
-  void processFeatureOrConsensusMap_(MapType& input_map,
-                                     ConsensusIDAlgorithm* consensus)
+  void processFeatureOrConsensusMap_(MapType& input_map)
   {
     // Problem with feature data: IDs from multiple spectra may be attached to
     // a (consensus) feature, so we may have multiple IDs from the same search
@@ -251,6 +324,10 @@ protected:
     }
 
     // compute consensus:
+    vector<vector<PeptideIdentification>*> groups;
+    vector<Size> runs_per_group;
+    groups.reserve(input_map.size());
+    runs_per_group.reserve(input_map.size());
     for (typename MapType::Iterator map_it = input_map.begin();
          map_it != input_map.end(); ++map_it)
     {
@@ -263,8 +340,10 @@ protected:
       }
       Size n_repeats = *max_element(times_seen.begin(), times_seen.end());
 
-      consensus->apply(ids, number_of_runs * n_repeats);
+      groups.push_back(&ids);
+      runs_per_group.push_back(number_of_runs * n_repeats);
     }
+    applyConsensus_(groups, runs_per_group);
 
     // create new identification run:
     setProteinIdentifications_(input_map.getProteinIdentifications());
@@ -284,40 +363,15 @@ protected:
     //----------------------------------------------------------------
     // set up ConsensusID
     //----------------------------------------------------------------
-    ConsensusIDAlgorithm* consensus;
     // general algorithm parameters:
-    Param algo_params = ConsensusIDAlgorithmBest().getDefaults();
     algorithm_ = getStringOption_("algorithm");
-    if (algorithm_ == "PEPMatrix")
+    algo_params_ = ConsensusIDAlgorithmBest().getDefaults();
+    if (algorithm_ == "PEPMatrix" || algorithm_ == "PEPIons")
     {
-      consensus = new ConsensusIDAlgorithmPEPMatrix();
       // add algorithm-specific parameters:
-      algo_params.merge(getParam_().copy("PEPMatrix:", true));
-    }
-    else if (algorithm_ == "PEPIons")
-    {
-      consensus = new ConsensusIDAlgorithmPEPIons();
-      // add algorithm-specific parameters:
-      algo_params.merge(getParam_().copy("PEPIons:", true));
-    }
-    else if (algorithm_ == "best")
-    {
-      consensus = new ConsensusIDAlgorithmBest();
+      algo_params_.merge(getParam_().copy(algorithm_ + ":", true));
     }
-    else if (algorithm_ == "worst")
-    {
-      consensus = new ConsensusIDAlgorithmWorst();
-    }
-    else if (algorithm_ == "average")
-    {
-      consensus = new ConsensusIDAlgorithmAverage();
-    }
-    else // algorithm_ == "ranks"
-    {
-      consensus = new ConsensusIDAlgorithmRanks();
-    }
-    algo_params.update(getParam_(), false, Log_debug); // update general params.
-    consensus->setParameters(algo_params);
+    algo_params_.update(getParam_(), false, Log_debug); // update general params.
 
     //----------------------------------------------------------------
     // idXML
@@ -376,11 +430,19 @@ protected:
       linker.group(maps, grouping);
 
       // compute consensus
+      vector<vector<PeptideIdentification>*> groups;
+      groups.reserve(grouping.size());
+      for (ConsensusMap::Iterator it = grouping.begin(); it != grouping.end();
+           ++it)
+      {
+        groups.push_back(&(it->getPeptideIdentifications()));
+      }
+      applyConsensus_(groups, vector<Size>(groups.size(), prot_ids.size()));
+
       pep_ids.clear();
       for (ConsensusMap::Iterator it = grouping.begin(); it != grouping.end();
            ++it)
       {
-        consensus->apply(it->getPeptideIdentifications(), prot_ids.size());
         if (!it->getPeptideIdentifications().empty())
         {
           PeptideIdentification& pep_id = it->getPeptideIdentifications()[0];
@@ -411,7 +473,7 @@ protected:
       FeatureMap map;
       FeatureXMLFile().load(in, map);
 
-      processFeatureOrConsensusMap_(map, consensus);
+      processFeatureOrConsensusMap_(map);
 
       FeatureXMLFile().store(out, map);
     }
@@ -424,13 +486,11 @@ protected:
       ConsensusMap map;
       ConsensusXMLFile().load(in, map);
 
-      processFeatureOrConsensusMap_(map, consensus);
+      processFeatureOrConsensusMap_(map);
 
       ConsensusXMLFile().store(out, map);
     }
 
-    delete consensus;
-
     return EXECUTION_OK;
   }
 
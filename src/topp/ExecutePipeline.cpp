@@ -58,6 +58,17 @@ using namespace std;
   In order to really use this tool in batch-mode, you can provide a TOPPAS resource file (.trf) which specifies the
   input files for the input nodes in your pipeline.
 
+  <B> Scheduling and caching </B>
+
+  By default, up to @p num_jobs tools run in parallel, each with its own @p -threads setting. When a total number of CPU cores
+  is given via @p cpus, the free cores are shared among the tools which are started, by passing an appropriate @p -threads value
+  to each of them. Queued tools are started in the order of their critical path length, i.e. tools on which the longest chain of
+  subsequent tools depends are started first.
+
+  With @p cache_dir, the outputs of every tool are additionally stored in a cache, keyed by the tool, its parameters and the contents
+  of its input files. In subsequent runs, tools whose key is found in the cache are not executed again; their cached outputs are used
+  instead. Note that the cache is never cleaned up automatically.
+
   <B> *.trf files </B>
 
  A TOPPAS resource file (<TT>*.trf</TT>) specifies the locations of input files for a pipeline.
@@ -110,6 +121,9 @@ protected:
     registerStringOption_("resource_file", "<file>", "", "A TOPPAS resource file (*.trf) specifying the files this workflow is to be applied to", false);
     registerIntOption_("num_jobs", "<integer>", 1, "Maximum number of jobs running in parallel", false, false);
     setMinInt_("num_jobs", 1);
+    registerIntOption_("cpus", "<integer>", 0, "Total number of CPU cores available to the workflow. Each started tool is assigned a share of the free cores via its '-threads' parameter; tools are started in the order of their critical path length. (0 = no limit, tools use their own '-threads' value)", false, true);
+    setMinInt_("cpus", 0);
+    registerStringOption_("cache_dir", "<directory>", "", "Directory for caching tool outputs across runs. Tools whose parameters and input file contents are unchanged reuse the cached outputs of a previous run instead of being executed again. (empty = no caching)", false, true);
   }
 
   ExitCodes main_(int argc, const char ** argv) override
@@ -118,6 +132,8 @@ protected:
     QString out_dir_name = getStringOption_("out_dir").toQString();
     QString resource_file = getStringOption_("resource_file").toQString();
     int num_jobs = getIntOption_("num_jobs");
+    int cpus = getIntOption_("cpus");
+    QString cache_dir_name = getStringOption_("cache_dir").toQString();
 
     QApplication a(argc, const_cast<char **>(argv), false);
 
@@ -137,6 +153,19 @@ protected:
 
     ts.load(toppas_file);
     ts.setAllowedThreads(num_jobs);
+    ts.setCPUBudget(cpus);
+
+    if (cache_dir_name != "")
+    {
+      cache_dir_name = QDir::cleanPath(QDir(cache_dir_name).absolutePath());
+      QDir qd_cache;
+      if (!(qd_cache.exists(cache_dir_name) || qd_cache.mkpath(cache_dir_name)))
+      {
+        cerr << "Cannot create the cache directory " << cache_dir_name.toStdString() << endl;
+        return CANNOT_WRITE_OUTPUT_FILE;
+      }
+      ts.setCacheDir(cache_dir_name);
+    }
 
     if (resource_file != "")
     {
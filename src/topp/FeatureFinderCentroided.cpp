@@ -35,6 +35,7 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/KERNEL/RangeUtils.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinder.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/FeatureFinderAlgorithmPicked.h>
@@ -43,6 +44,9 @@
 #include <OpenMS/METADATA/MSQuantifications.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -129,6 +133,17 @@ using namespace std;
  </table>
 
  For the @em centroided algorithm centroided data is needed. In order to create centroided data from profile data use the @ref TOPP_PeakPickerWavelet.
+
+ <b>Bounded-memory mode</b>:
+ For long runs the memory needed to hold the complete map can be limited by setting @p rt_window.
+ The input (which must be an indexed mzML file) is then read from disk in RT tiles of that width,
+ each extended by @p rt_overlap seconds on both sides. A feature is normally reported by the tile whose
+ core region (without the overlap) contains its RT, so features in the overlaps are not duplicated.
+ Because every tile fits its features independently, a feature close to the border between two cores
+ may get a slightly different RT in the two tiles. Features of adjacent tiles with the same charge are
+ therefore treated as duplicates if the mass traces of one enclose the position of the other. Of such
+ a pair, only the one fitted further away from the cut borders of its tile is reported, no matter
+ which core it falls into. @p rt_overlap should be at least half the width of the widest expected feature.
 */
 
 // We do not want this class to show up in the docu:
@@ -156,6 +171,11 @@ protected:
     registerOutputFile_("out_mzq", "<file>", "", "Optional output file of MzQuantML.", false, true);
     setValidFormats_("out_mzq", ListUtils::create<String>("mzq"));
 
+    registerDoubleOption_("rt_window", "<value>", 0.0, "If larger than 0, process the (indexed mzML) input in RT tiles of this width (in seconds) to bound memory usage.", false, true);
+    setMinFloat_("rt_window", 0.0);
+    registerDoubleOption_("rt_overlap", "<value>", 60.0, "Overlap (in seconds) added on both sides of each RT tile (only used if 'rt_window' is set).", false, true);
+    setMinFloat_("rt_overlap", 0.0);
+
     addEmptyLine_();
 
     registerSubsection_("algorithm", "Algorithm section");
@@ -166,26 +186,9 @@ protected:
     return FeatureFinder().getParameters(FeatureFinderAlgorithmPicked::getProductName());
   }
 
-  ExitCodes main_(int, const char**) override
+  /// Checks that @p exp contains MS1 spectra and that these are centroided (unless forced)
+  void checkInput_(const PeakMap& exp)
   {
-    //input file names
-    String in = getStringOption_("in");
-    String out = getStringOption_("out");
-    String out_mzq = getStringOption_("out_mzq");
-
-    //prevent loading of fragment spectra
-    PeakFileOptions options;
-    options.setMSLevels(vector<Int>(1, 1));
-
-    //reading input data
-    MzMLFile f;
-    f.getOptions() = options;
-    f.setLogType(log_type_);
-
-    PeakMap exp;
-    f.load(in, exp);
-    exp.updateRanges();
-
     if (exp.getSpectra().empty())
     {
       throw OpenMS::Exception::FileEmpty(__FILE__, __LINE__, __FUNCTION__, "Error: No MS1 spectra in input file.");
@@ -201,6 +204,155 @@ protected:
         throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Profile data provided but centroided spectra expected. To enforce processing of the data set the -force flag.");
       }
     }
+  }
+
+  /// A feature found in one RT tile
+  struct TileFeature_
+  {
+    Feature feature;
+    Size tile;
+    /// Does the core region of the tile contain the RT of the feature?
+    bool in_core;
+    /// RT distance to the nearest border where the tile was cut off from the rest of the run
+    double margin;
+  };
+
+  /// Are @p a and @p b (found in adjacent tiles) the same feature?
+  static bool isSameFeature_(const Feature& a, const Feature& b)
+  {
+    return (a.getCharge() == b.getCharge()) && (a.encloses(b.getRT(), b.getMZ()) || b.encloses(a.getRT(), a.getMZ()));
+  }
+
+  /**
+    @brief Runs the feature finder on overlapping RT tiles of an indexed mzML file
+
+    Only MS1 spectra are loaded, one tile at a time. Features are kept by the tile whose core region
+    contains their RT, unless the same feature was also found in an adjacent tile (see isSameFeature_()).
+    In that case only the copy with the larger distance to the cut borders of its tile is kept.
+    The meta data "spectrum_index" is translated to the position in @p meta.
+
+    @param meta Filled with the MS1 spectra of @p in (meta data only, no peaks)
+
+    @return false if @p in is not an indexed mzML file
+  */
+  bool runTiled_(const String& in, double rt_window, double rt_overlap, const Param& feafi_param, const FeatureMap& seeds, PeakMap& meta, FeatureMap& features)
+  {
+    OnDiscPeakMap on_disc;
+    if (!on_disc.openFile(in)) return false;
+
+    // collect MS1 spectra (meta data only) sorted by RT
+    boost::shared_ptr<PeakMap> all_meta = on_disc.getMetaData();
+    vector<Size> ms1;
+    for (Size i = 0; i < all_meta->size(); ++i)
+    {
+      if ((*all_meta)[i].getMSLevel() == 1) ms1.push_back(i);
+    }
+    std::stable_sort(ms1.begin(), ms1.end(), [&all_meta](Size a, Size b) { return (*all_meta)[a].getRT() < (*all_meta)[b].getRT(); });
+
+    meta.clear(true);
+    meta.getExperimentalSettings() = all_meta->getExperimentalSettings();
+    for (Size i = 0; i < ms1.size(); ++i)
+    {
+      meta.addSpectrum((*all_meta)[ms1[i]]);
+    }
+    all_meta.reset();
+    checkInput_(meta);
+
+    double rt_min = meta[0].getRT(), rt_max = meta[meta.size() - 1].getRT();
+    Size n_tiles = Size((rt_max - rt_min) / rt_window) + 1;
+    ProgressLogger progresslogger;
+    progresslogger.setLogType(log_type_);
+    progresslogger.startProgress(0, n_tiles, "processing RT tiles");
+    Size first = 0; // first MS1 spectrum of the current tile (incl. overlap)
+    vector<TileFeature_> candidates; // features of all tiles, in tile order
+    vector<Size> tile_start(1, 0); // index of the first candidate of each tile
+    for (Size t = 0; t < n_tiles; ++t)
+    {
+      progresslogger.setProgress(t);
+      double core_begin = rt_min + t * rt_window, core_end = core_begin + rt_window;
+      bool last_tile = (t + 1 == n_tiles);
+      while (first < meta.size() && meta[first].getRT() < core_begin - rt_overlap) ++first;
+      Size last = first;
+      while (last < meta.size() && meta[last].getRT() <= core_end + rt_overlap) ++last;
+
+      // load peaks of the tile
+      PeakMap tile;
+      tile.getExperimentalSettings() = meta.getExperimentalSettings();
+      tile.reserveSpaceSpectra(last - first);
+      for (Size s = first; s < last; ++s)
+      {
+        tile.addSpectrum(on_disc.getSpectrum(ms1[s]));
+      }
+      tile.updateRanges();
+      if (tile.getSize() == 0) // no peaks in this tile
+      {
+        tile_start.push_back(candidates.size());
+        continue;
+      }
+
+      FeatureMap tile_seeds;
+      for (FeatureMap::ConstIterator it = seeds.begin(); it != seeds.end(); ++it)
+      {
+        if (it->getRT() >= tile.getMinRT() && it->getRT() <= tile.getMaxRT()) tile_seeds.push_back(*it);
+      }
+
+      FeatureFinder ff;
+      ff.setLogType(ProgressLogger::NONE);
+      FeatureMap tile_features;
+      ff.run(FeatureFinderAlgorithmPicked::getProductName(), tile, tile_features, feafi_param, tile_seeds);
+
+      double tile_begin = meta[first].getRT(), tile_end = meta[last - 1].getRT();
+      for (FeatureMap::Iterator it = tile_features.begin(); it != tile_features.end(); ++it)
+      {
+        it->setMetaValue("spectrum_index", Size(it->getMetaValue("spectrum_index")) + first);
+        TileFeature_ candidate;
+        candidate.feature = *it;
+        candidate.tile = t;
+        // the outer tiles take the margins of the run
+        candidate.in_core = !((it->getRT() < core_begin && t != 0) || (it->getRT() >= core_end && !last_tile));
+        candidate.margin = std::numeric_limits<double>::max();
+        if (first > 0) candidate.margin = std::min(candidate.margin, it->getRT() - tile_begin);
+        if (last < meta.size()) candidate.margin = std::min(candidate.margin, tile_end - it->getRT());
+        candidates.push_back(candidate);
+      }
+      tile_start.push_back(candidates.size());
+      writeLog_(String("RT tile ") + (t + 1) + "/" + n_tiles + " [" + core_begin + ", " + core_end + "]: " + tile_features.size() + " features.");
+    }
+    progresslogger.endProgress();
+
+    // resolve features found in two adjacent tiles (their fitted RTs may fall into different cores)
+    vector<bool> has_duplicate(candidates.size(), false), keep(candidates.size(), true);
+    for (Size t = 0; t + 1 < n_tiles; ++t)
+    {
+      for (Size i = tile_start[t]; i < tile_start[t + 1]; ++i)
+      {
+        for (Size j = tile_start[t + 1]; j < tile_start[t + 2]; ++j)
+        {
+          if (!isSameFeature_(candidates[i].feature, candidates[j].feature)) continue;
+          has_duplicate[i] = has_duplicate[j] = true;
+          // on a tie, the earlier tile keeps the feature
+          if (candidates[j].margin > candidates[i].margin) keep[i] = false;
+          else keep[j] = false;
+        }
+      }
+    }
+    for (Size i = 0; i < candidates.size(); ++i)
+    {
+      if (keep[i] && (has_duplicate[i] || candidates[i].in_core)) features.push_back(candidates[i].feature);
+    }
+    writeLog_(String("Found ") + features.size() + " features in " + n_tiles + " RT tiles.");
+    features.sortByIntensity(true);
+    return true;
+  }
+
+  ExitCodes main_(int, const char**) override
+  {
+    //input file names
+    String in = getStringOption_("in");
+    String out = getStringOption_("out");
+    String out_mzq = getStringOption_("out_mzq");
+    double rt_window = getDoubleOption_("rt_window");
+    double rt_overlap = getDoubleOption_("rt_overlap");
 
     //load seeds
     FeatureMap seeds;
@@ -209,22 +361,54 @@ protected:
       FeatureXMLFile().load(getStringOption_("seeds"), seeds);
     }
 
-    //setup of FeatureFinder
-    FeatureFinder ff;
-    ff.setLogType(log_type_);
+    // get parameters specific for the feature finder
+    Param feafi_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Parameters passed to FeatureFinder", feafi_param, 3);
 
     // A map for the resulting features
     FeatureMap features;
+
+    // in tiled mode 'exp' only holds the MS1 spectrum meta data, peaks are read tile by tile
+    PeakMap exp;
+    bool tiled = false;
+    if (rt_window > 0.0)
+    {
+      tiled = runTiled_(in, rt_window, rt_overlap, feafi_param, seeds, exp, features);
+      if (!tiled)
+      {
+        LOG_WARN << "Warning: Input file is not an indexed mzML file, 'rt_window' is ignored and the complete map is loaded." << endl;
+      }
+    }
+
+    if (!tiled)
+    {
+      //prevent loading of fragment spectra
+      PeakFileOptions options;
+      options.setMSLevels(vector<Int>(1, 1));
+
+      //reading input data
+      MzMLFile f;
+      f.getOptions() = options;
+      f.setLogType(log_type_);
+
+      f.load(in, exp);
+      exp.updateRanges();
+      checkInput_(exp);
+    }
+
     StringList ms_runs;
     exp.getPrimaryMSRunPath(ms_runs);
     features.setPrimaryMSRunPath(ms_runs);
 
-    // get parameters specific for the feature finder
-    Param feafi_param = getParam_().copy("algorithm:", true);
-    writeDebug_("Parameters passed to FeatureFinder", feafi_param, 3);
+    if (!tiled)
+    {
+      //setup of FeatureFinder
+      FeatureFinder ff;
+      ff.setLogType(log_type_);
 
-    // Apply the feature finder
-    ff.run(FeatureFinderAlgorithmPicked::getProductName(), exp, features, feafi_param, seeds);
+      // Apply the feature finder
+      ff.run(FeatureFinderAlgorithmPicked::getProductName(), exp, features, feafi_param, seeds);
+    }
     features.applyMemberFunction(&UniqueIdInterface::setUniqueId);
 
     // DEBUG
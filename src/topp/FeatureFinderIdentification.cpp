@@ -220,6 +220,8 @@ protected:
       String id_ext = getStringOption_("id_ext");
       String lib_out = getStringOption_("lib_out");
       String chrom_out = getStringOption_("chrom_out");
+      // chromatograms are only kept in memory if they are written out:
+      ffid_algo.setKeepChromatograms(!chrom_out.empty());
 
       //-------------------------------------------------------------
       // load input
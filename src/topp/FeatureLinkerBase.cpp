@@ -45,6 +45,11 @@
 #include <OpenMS/KERNEL/ConversionHelper.h>
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace OpenMS;
 using namespace std;
@@ -183,24 +188,77 @@ protected:
       }
 
       vector<FeatureMap > maps(ins.size());
-      FeatureXMLFile f;
-      FeatureFileOptions param = f.getOptions();
-
-      // to save memory don't load convex hulls and subordinates
-      param.setLoadSubordinates(false);
-      param.setLoadConvexHull(false);
-      f.setOptions(param);
+      vector<StringList> ms_runs_per_map(ins.size());
 
       Size progress = 0;
       setLogType(ProgressLogger::CMD);
       startProgress(0, ins.size(), "reading input");
-      for (Size i = 0; i < ins.size(); ++i)
+      // input files are independent: load them concurrently (one reader per thread)
+      ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
       {
-        FeatureMap tmp;
-        f.load(ins[i], tmp);
+        FeatureXMLFile f;
+        FeatureFileOptions param = f.getOptions();
+
+        // to save memory don't load convex hulls and subordinates
+        param.setLoadSubordinates(false);
+        param.setLoadConvexHull(false);
+        f.setOptions(param);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)ins.size(); ++i)
+        {
+          try
+          {
+            FeatureMap& tmp = maps[i];
+            f.load(ins[i], tmp);
+
+            tmp.getPrimaryMSRunPath(ms_runs_per_map[i]);
+
+            // to save memory, remove convex hulls, subordinates:
+            for (FeatureMap::Iterator it = tmp.begin(); it != tmp.end();
+                 ++it)
+            {
+              String adduct;
+              //exception: addduct information
+              if (it->metaValueExists("dc_charge_adducts"))
+              {
+                adduct = it->getMetaValue("dc_charge_adducts");
+              }
+              it->getSubordinates().clear();
+              it->getConvexHulls().clear();
+              it->clearMetaInfo();
+              if (!adduct.empty())
+              {
+                it->setMetaValue("dc_charge_adducts", adduct);
+              }
+
+            }
+
+            tmp.updateRanges();
+          }
+          catch (...)
+          {
+            exceptions.capture();
+          }
 
-        StringList ms_runs;
-        tmp.getPrimaryMSRunPath(ms_runs);
+          IF_MASTERTHREAD setProgress(progress);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+          ++progress;
+        }
+      }
+      exceptions.rethrow();
+      endProgress();
+
+      for (Size i = 0; i < ins.size(); ++i)
+      {
+        const StringList& ms_runs = ms_runs_per_map[i];
 
         // associate mzML file with map i in consensusXML
         if (ms_runs.size() > 1 || ms_runs.empty())
@@ -213,38 +271,12 @@ protected:
         {
           out_map.getColumnHeaders()[i].filename = ms_runs.front();
         }
-        out_map.getColumnHeaders()[i].size = tmp.size();
-        out_map.getColumnHeaders()[i].unique_id = tmp.getUniqueId();
+        out_map.getColumnHeaders()[i].size = maps[i].size();
+        out_map.getColumnHeaders()[i].unique_id = maps[i].getUniqueId();
 
         // copy over information on the primary MS run
         ms_run_locations.insert(ms_run_locations.end(), ms_runs.begin(), ms_runs.end());
-
-        // to save memory, remove convex hulls, subordinates:
-        for (FeatureMap::Iterator it = tmp.begin(); it != tmp.end();
-             ++it)
-        {
-          String adduct;
-          //exception: addduct information
-          if (it->metaValueExists("dc_charge_adducts"))
-          {
-            adduct = it->getMetaValue("dc_charge_adducts");
-          }
-          it->getSubordinates().clear();
-          it->getConvexHulls().clear();
-          it->clearMetaInfo();
-          if (!adduct.empty())
-          {
-            it->setMetaValue("dc_charge_adducts", adduct);
-          }
-
-        }
-
-        maps[i] = tmp;
-        maps[i].updateRanges();
-
-        setProgress(progress++);
       }
-      endProgress();
 
       // exception for "labeled" algorithms: copy file descriptions
       if (labeled)
@@ -281,11 +313,33 @@ protected:
     else
     {
       vector<ConsensusMap> maps(ins.size());
-      ConsensusXMLFile f;
+      // input files are independent: load them concurrently (one reader per thread)
+      ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+      {
+        ConsensusXMLFile f;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)ins.size(); ++i)
+        {
+          try
+          {
+            f.load(ins[i], maps[i]);
+            maps[i].updateRanges();
+          }
+          catch (...)
+          {
+            exceptions.capture();
+          }
+        }
+      }
+      exceptions.rethrow();
+
       for (Size i = 0; i < ins.size(); ++i)
       {
-        f.load(ins[i], maps[i]);
-        maps[i].updateRanges();
         // copy over information on the primary MS run
         StringList ms_runs;
         maps[i].getPrimaryMSRunPath(ms_runs);
@@ -44,6 +44,7 @@
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
+#include <OpenMS/FILTERING/TRANSFORMERS/ParallelSpectrumFilter.h>
 #include <OpenMS/COMPARISON/SPECTRA/ZhangSimilarityScore.h>
 #include <OpenMS/CONCEPT/Factory.h>
 #include <OpenMS/FORMAT/MSNumpressCoder.h>
@@ -835,15 +836,17 @@ protected:
         SignalToNoiseEstimatorMedian<MapType::SpectrumType> snm;
         Param const& dc_param = getParam_().copy("algorithm:SignalToNoise:", true);
         snm.setParameters(dc_param);
-        for (MapType::Iterator it = exp.begin(); it != exp.end(); ++it)
-        {
-          snm.init(it->begin(), it->end());
-          for (MapType::SpectrumType::Iterator spec = it->begin(); spec != it->end(); ++spec)
+        // the estimator keeps the estimates of the current spectrum, so each thread uses its own copy
+        ParallelSpectrumFilter::apply(exp.getSpectra(), snm,
+          [sn](SignalToNoiseEstimatorMedian<MapType::SpectrumType>& estimator, MapType::SpectrumType& spectrum)
           {
-            if (snm.getSignalToNoise(spec) < sn) spec->setIntensity(0);
-          }
-          it->erase(remove_if(it->begin(), it->end(), InIntensityRange<MapType::PeakType>(1, numeric_limits<MapType::PeakType::IntensityType>::max(), true)), it->end());
-        }
+            estimator.init(spectrum.begin(), spectrum.end());
+            for (MapType::SpectrumType::Iterator spec = spectrum.begin(); spec != spectrum.end(); ++spec)
+            {
+              if (estimator.getSignalToNoise(spec) < sn) spec->setIntensity(0);
+            }
+            spectrum.erase(remove_if(spectrum.begin(), spectrum.end(), InIntensityRange<MapType::PeakType>(1, numeric_limits<MapType::PeakType::IntensityType>::max(), true)), spectrum.end());
+          });
       }
 
       //
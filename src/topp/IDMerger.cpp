@@ -35,6 +35,7 @@
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/CONCEPT/ParallelExceptionCollector.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -294,11 +295,30 @@ protected:
       }
 
     peptides_by_file.resize(file_names.size());
+    vector<vector<ProteinIdentification> > proteins_by_file(file_names.size());
+
+    // input files are independent: load them concurrently
+    ParallelExceptionCollector exceptions;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)file_names.size(); ++i)
+    {
+      try
+      {
+        IdXMLFile().load(file_names[i], proteins_by_file[i], peptides_by_file[i]);
+      }
+      catch (...)
+      {
+        exceptions.capture();
+      }
+    }
+    exceptions.rethrow();
+
     for (Size i = 0; i < file_names.size(); ++i)
       {
         const String& file_name = file_names[i];
-        vector<ProteinIdentification> additional_proteins;
-        IdXMLFile().load(file_name, additional_proteins, peptides_by_file[i]);
+        vector<ProteinIdentification>& additional_proteins = proteins_by_file[i];
 
         if (annotate_file_origin) // set MetaValue "file_origin" if flag is set
         {
@@ -48,6 +48,7 @@
 #include <OpenMS/FORMAT/IdXMLFile.h>
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/ConsensusXMLFile.h>
 using namespace OpenMS;
@@ -152,6 +153,7 @@ protected:
     setValidFormats_("out_cntm", ListUtils::create<String>("featureXML"));
     registerOutputFile_("out_id", "<file>", "", "output: ground-truth MS2 peptide identifications", false);
     setValidFormats_("out_id", ListUtils::create<String>("idXML"));
+    registerFlag_("stream_output", "Write 'out' and 'out_pm' spectrum by spectrum and release the peaks of each spectrum once it is written. The simulation still holds the complete maps, so the peak memory is unchanged; memory is only returned earlier while the outputs are written. The output is indexed mzML, as without this flag.", true);
 
     registerSubsection_("algorithm", "Algorithm parameters section");
   }
@@ -285,18 +287,38 @@ protected:
     w.stop();
     writeLog_(String("Simulation took ") + String(w.getClockTime()) + String(" seconds"));
 
+    bool stream_output = getFlag_("stream_output");
+
     String outputfile_name = getStringOption_("out");
     if (outputfile_name != "")
     {
       writeLog_(String("Storing simulated raw data in: ") + outputfile_name);
-      MzMLFile().store(outputfile_name, ms_simulation.getExperiment());
+      if (stream_output)
+      {
+        PlainMSDataWritingConsumer consumer(outputfile_name);
+        consumer.getOptions().setWriteIndex(true); // same format as MzMLFile::store()
+        ms_simulation.consumeExperiment(consumer);
+      }
+      else
+      {
+        MzMLFile().store(outputfile_name, ms_simulation.getExperiment());
+      }
     }
 
     String pxml_out = getStringOption_("out_pm");
     if (pxml_out != "")
     {
       writeLog_(String("Storing simulated peak/centroided data in: ") + pxml_out);
-      MzMLFile().store(pxml_out, ms_simulation.getPeakMap());
+      if (stream_output)
+      {
+        PlainMSDataWritingConsumer consumer(pxml_out);
+        consumer.getOptions().setWriteIndex(true);
+        ms_simulation.consumePeakMap(consumer);
+      }
+      else
+      {
+        MzMLFile().store(pxml_out, ms_simulation.getPeakMap());
+      }
     }
 
     String fxml_out = getStringOption_("out_fm");